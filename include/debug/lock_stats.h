@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Lock contention and hold-time statistics
+ *
+ * When CONFIG_LOCK_STATS is enabled, every k_spinlock and k_mutex
+ * acquisition is attributed to a "site" and accumulated in a fixed
+ * size table.  Spinlock sites are the source location of the
+ * k_spin_lock() call, mutex sites are the return address of the
+ * k_mutex_lock() caller.  All times are in hardware cycles as
+ * returned by k_cycle_get_32().
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_LOCK_STATS_H_
+#define ZEPHYR_INCLUDE_DEBUG_LOCK_STATS_H_
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef CONFIG_LOCK_STATS
+
+enum lock_stats_type {
+	LOCK_STATS_SPINLOCK,
+	LOCK_STATS_MUTEX,
+};
+
+/**
+ * @brief Accumulated statistics for one lock site
+ */
+struct lock_stats_site {
+	/** "file:line" string for spinlocks, caller address for mutexes */
+	const void *site;
+	/** One of enum lock_stats_type */
+	u8_t type;
+	/** Number of acquisitions */
+	u32_t count;
+	/** Acquisitions which had to spin or pend */
+	u32_t contended;
+	/** Longest single spin or pend time */
+	u32_t max_wait_cycles;
+	/** Longest single hold time */
+	u32_t max_hold_cycles;
+	/** Total spin or pend time */
+	u64_t wait_cycles;
+	/** Total hold time */
+	u64_t hold_cycles;
+};
+
+/* Per-lock bookkeeping of the current hold, embedded in the lock
+ * objects themselves.  Internal, do not use.
+ */
+struct _lock_stats_hold {
+	struct lock_stats_site *site;
+	u32_t start;
+};
+
+typedef void (*lock_stats_cb_t)(const struct lock_stats_site *site,
+				void *user_data);
+
+/**
+ * @brief Iterate over all recorded lock sites
+ *
+ * Each site is copied while the statistics table is locked and the
+ * callback invoked on the copy, so the callback may block or print.
+ *
+ * @param cb Callback invoked for each site
+ * @param user_data Opaque pointer handed to the callback
+ */
+void lock_stats_foreach(lock_stats_cb_t cb, void *user_data);
+
+/**
+ * @brief Discard all recorded statistics
+ */
+void lock_stats_reset(void);
+
+/**
+ * @brief Number of acquisitions that found the site table full
+ *
+ * @return Count of acquisitions not attributed to any site
+ */
+u32_t lock_stats_dropped(void);
+
+/**
+ * @brief Emit every recorded site through the tracing backend
+ *
+ * With CONFIG_TRACING_CTF each site becomes one lock_stats event in
+ * the CTF stream; with other backends this does nothing.
+ */
+void lock_stats_trace_dump(void);
+
+/* Hooks called from spinlock.h and kernel/mutex.c.  Internal. */
+u32_t z_lock_stats_begin(void);
+void z_lock_stats_acquired(struct _lock_stats_hold *hold, const void *site,
+			   enum lock_stats_type type, u32_t start,
+			   bool contended);
+void z_lock_stats_released(struct _lock_stats_hold *hold);
+
+#endif /* CONFIG_LOCK_STATS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_LOCK_STATS_H_ */
@@ -339,6 +339,36 @@ static inline void k_obj_free(void *obj)
 }
 #endif /* CONFIG_DYNAMIC_OBJECTS */
 
+/**
+ * Make several system calls in one kernel entry
+ *
+ * Runs the system calls described by @a ops in order, storing the return
+ * value of each in its ret member, as if they were made one after the
+ * other, but elevating privileges only once.  Each operation is set up
+ * with the k_syscall_op_<name>() helper of the system call, generated
+ * for every system call with at most 6 arguments and no 64-bit return
+ * value.  Arguments are validated as for individual calls, and an
+ * invalid one causes a kernel oops.
+ *
+ * Only useful to user threads; supervisor threads call the functions
+ * directly.
+ *
+ * @param ops Array of system call operations
+ * @param num_ops Number of operations
+ * @return Number of operations made, or -ENOTSUP if not called from
+ *         user mode
+ */
+__syscall int k_syscall_batch(struct k_syscall_op *ops, unsigned int num_ops);
+
+static inline int _impl_k_syscall_batch(struct k_syscall_op *ops,
+					unsigned int num_ops)
+{
+	ARG_UNUSED(ops);
+	ARG_UNUSED(num_ops);
+
+	return -ENOTSUP;
+}
+
 /** @} */
 
 /* Using typedef deliberately here, this is quite intended to be an opaque
@@ -404,6 +434,13 @@ struct _thread_base {
 	 */
 	_wait_q_t *pended_on;
 
+#if CONFIG_PRIORITY_INHERITANCE_DEPTH > 1
+	/* mutex the thread is pended on, for transitive priority
+	 * inheritance
+	 */
+	struct k_mutex *pended_mutex;
+#endif
+
 	/* user facing 'thread options'; values defined in include/kernel.h */
 	u8_t user_options;
 
@@ -453,6 +490,10 @@ struct _thread_base {
 	/* Recursive count of irq_lock() calls */
 	u8_t global_lock_count;
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* CPU index whose ready queue holds the thread */
+	u8_t runq_cpu;
+#endif
 #endif
 
 #ifdef CONFIG_SCHED_CPU_MASK
@@ -505,6 +546,24 @@ struct _thread_userspace_local_data {
 };
 #endif
 
+#ifdef CONFIG_TRACING_CPU_STATS_THREADS
+/** Runtime statistics of a thread, see cpu_stats_thread_get() */
+struct k_thread_runtime_stats {
+	/** Cycles spent running */
+	u64_t cycles;
+	/** Times switched out while blocking */
+	u32_t voluntary;
+	/** Times switched out while still ready to run */
+	u32_t involuntary;
+	/** Longest wait from being made ready to running, in cycles */
+	u32_t max_latency;
+	/* Start of the current run, or of the wait to run */
+	u32_t stamp;
+	/* Waiting to run since stamp */
+	bool ready;
+};
+#endif
+
 /**
  * @ingroup thread_apis
  * Thread Structure
@@ -561,6 +620,11 @@ struct k_thread {
 	struct _thread_stack_info stack_info;
 #endif /* CONFIG_THREAD_STACK_INFO */
 
+#if defined(CONFIG_TRACING_CPU_STATS_THREADS)
+	/** CPU usage and scheduling statistics */
+	struct k_thread_runtime_stats runtime_stats;
+#endif
+
 #if defined(CONFIG_USERSPACE)
 	/** memory domain info of the thread */
 	struct _mem_domain_info mem_domain_info;
@@ -1041,6 +1105,24 @@ __syscall void k_thread_priority_set(k_tid_t thread, int prio);
 __syscall void k_thread_deadline_set(k_tid_t thread, int deadline);
 #endif
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/**
+ * @brief Set the timer slack of a thread
+ *
+ * This allows the timeouts of @a thread (k_sleep() and the timeouts of
+ * blocking calls) to expire up to @a slack milliseconds late, so that
+ * they can share a wakeup with other timeouts expiring nearby. Like the
+ * Linux timer slack, it trades timing precision for fewer wakeups. The
+ * new slack takes effect with the next timeout of the thread.
+ *
+ * @param thread ID of thread whose slack is to be set.
+ * @param slack Allowed deferral (in milliseconds), 0 for none.
+ *
+ * @return N/A
+ */
+__syscall void k_thread_timer_slack_set(k_tid_t thread, s32_t slack);
+#endif
+
 #ifdef CONFIG_SCHED_CPU_MASK
 /**
  * @brief Sets all CPU enable masks to zero
@@ -1391,7 +1473,6 @@ struct k_timer {
 	{ \
 	.timeout = { \
 		.node = {},\
-		.dticks = 0, \
 		.fn = _timer_expiration_handler \
 	}, \
 	.wait_q = _WAIT_Q_INIT(&obj.wait_q), \
@@ -1589,6 +1670,31 @@ static inline void _impl_k_timer_user_data_set(struct k_timer *timer,
 	timer->user_data = user_data;
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/**
+ * @brief Set the slack of a timer.
+ *
+ * This routine allows the expiries of @a timer to be deferred by up to
+ * @a slack milliseconds, so that they can share a wakeup with other
+ * timeouts expiring nearby instead of waking the system on their own.
+ * A periodic timer does not drift: each period is still counted from
+ * the nominal expiry. The new slack takes effect the next time the
+ * timer is started or its period reloads.
+ *
+ * @param timer     Address of timer.
+ * @param slack     Allowed deferral (in milliseconds), 0 for none.
+ *
+ * @return N/A
+ */
+__syscall void k_timer_slack_set(struct k_timer *timer, s32_t slack);
+
+static inline void _impl_k_timer_slack_set(struct k_timer *timer,
+					   s32_t slack)
+{
+	timer->timeout.slack = _ms_to_ticks(MAX(slack, 0));
+}
+#endif
+
 /**
  * @brief Retrieve the user-specific data from a timer.
  *
@@ -1625,6 +1731,18 @@ static inline void *_impl_k_timer_user_data_get(struct k_timer *timer)
  */
 __syscall s64_t k_uptime_get(void);
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/**
+ * @brief Get the number of wakeups avoided by timeout slack
+ *
+ * Counts the timeout expiry ticks that were served by a wakeup taken
+ * for a later tick, rather than waking the system on their own.
+ *
+ * @return Number of wakeups avoided since boot.
+ */
+extern u32_t k_timeout_wakeups_avoided_get(void);
+#endif
+
 /**
  * @brief Enable clock always on in tickless kernel
  *
@@ -1926,6 +2044,30 @@ extern void k_queue_merge_slist(struct k_queue *queue, sys_slist_t *list);
  */
 __syscall void *k_queue_get(struct k_queue *queue, s32_t timeout);
 
+/**
+ * @brief Get several elements from a queue.
+ *
+ * This routine removes up to @a max data items from @a queue under a
+ * single lock acquisition and stores their addresses in @a data. If the
+ * queue is empty it waits up to @a timeout for the first item, then
+ * takes whatever else is available without waiting again. Use
+ * k_queue_append_list() to add several items at once.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param queue Address of the queue.
+ * @param data Array receiving the addresses of the data items.
+ * @param max Number of entries in @a data.
+ * @param timeout Waiting period to obtain the first data item (in
+ *                milliseconds), or one of the special values K_NO_WAIT
+ *                and K_FOREVER.
+ *
+ * @return Number of data items removed, 0 if returned without waiting or
+ * the waiting period timed out.
+ */
+__syscall int k_queue_get_many(struct k_queue *queue, void **data, int max,
+			       s32_t timeout);
+
 /**
  * @brief Remove an element from a queue.
  *
@@ -2190,6 +2332,27 @@ struct k_fifo {
 #define k_fifo_get(fifo, timeout) \
 	k_queue_get((struct k_queue *) fifo, timeout)
 
+/**
+ * @brief Get several elements from a FIFO queue.
+ *
+ * This routine removes up to @a max data items from @a fifo in one
+ * operation, waiting up to @a timeout for the first one. See
+ * k_queue_get_many().
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param fifo Address of the FIFO queue.
+ * @param data Array receiving the addresses of the data items.
+ * @param max Number of entries in @a data.
+ * @param timeout Waiting period to obtain the first data item (in
+ *                milliseconds), or one of the special values K_NO_WAIT
+ *                and K_FOREVER.
+ *
+ * @return Number of data items removed.
+ */
+#define k_fifo_get_many(fifo, data, max, timeout) \
+	k_queue_get_many((struct k_queue *) fifo, data, max, timeout)
+
 /**
  * @brief Query a FIFO queue to see if it has data available.
  *
@@ -2900,6 +3063,10 @@ struct k_mutex {
 	u32_t lock_count;
 	int owner_orig_prio;
 
+#ifdef CONFIG_LOCK_STATS
+	struct _lock_stats_hold stats;
+#endif
+
 	_OBJECT_TRACING_NEXT_PTR(k_mutex)
 };
 
@@ -2988,6 +3155,177 @@ __syscall int k_mutex_lock(struct k_mutex *mutex, s32_t timeout);
  */
 __syscall void k_mutex_unlock(struct k_mutex *mutex);
 
+/**
+ * @}
+ */
+
+/**
+ * @defgroup rwlock_apis Reader-Writer Lock APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+struct k_rwlock {
+	_wait_q_t wait_q;
+	/** Thread holding the lock for writing, if any */
+	struct k_thread *writer;
+	/** Number of threads holding the lock for reading */
+	u32_t readers;
+};
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+#define _K_RWLOCK_INITIALIZER(obj) \
+	{ \
+	.wait_q = _WAIT_Q_INIT(&obj.wait_q), \
+	.writer = NULL, \
+	.readers = 0, \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @brief Statically define and initialize a reader-writer lock.
+ *
+ * The lock can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct k_rwlock <name>; @endcode
+ *
+ * @param name Name of the reader-writer lock.
+ */
+#define K_RWLOCK_DEFINE(name) \
+	struct k_rwlock name \
+		__in_section(_k_rwlock, static, name) = \
+		_K_RWLOCK_INITIALIZER(name)
+
+/**
+ * @brief Initialize a reader-writer lock.
+ *
+ * Upon completion, the lock is held neither for reading nor for writing.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @return N/A
+ */
+__syscall void k_rwlock_init(struct k_rwlock *rwlock);
+
+/**
+ * @brief Lock a reader-writer lock for reading.
+ *
+ * Any number of threads may hold @a rwlock for reading at the same time.
+ * The calling thread waits while the lock is held for writing, and also
+ * while any other thread is waiting for it, so that writers are not
+ * starved by a stream of readers.  Waiters are served in priority order.
+ *
+ * Read locks are not recursive: a thread taking the lock for reading a
+ * second time may deadlock with a waiting writer.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param timeout Waiting period to lock (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Lock held for reading.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_rwlock_read_lock(struct k_rwlock *rwlock, s32_t timeout);
+
+/**
+ * @brief Lock a reader-writer lock for writing.
+ *
+ * The calling thread waits until no other thread holds @a rwlock, for
+ * reading or for writing.  Unlike mutexes, reader-writer locks neither
+ * nest nor provide priority inheritance.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param timeout Waiting period to lock (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Lock held for writing.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_rwlock_write_lock(struct k_rwlock *rwlock, s32_t timeout);
+
+/**
+ * @brief Release a reader-writer lock held for reading.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @return N/A
+ */
+__syscall void k_rwlock_read_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @brief Release a reader-writer lock held for writing.
+ *
+ * The lock must be held for writing by the calling thread.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @return N/A
+ */
+__syscall void k_rwlock_write_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup futex_apis Futex APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Futex word
+ *
+ * A futex is a 32-bit value that threads manipulate directly with atomic
+ * operations, and only ask the kernel to sleep or wake up when the value
+ * says the lock (or other state it encodes) is contended.  Unlike other
+ * kernel objects, a futex is not registered with the kernel: it may live
+ * in any memory the calling threads can write to, including memory of a
+ * user mode thread, so that uncontended operations need no system call.
+ */
+struct k_futex {
+	atomic_t val;
+};
+
+/**
+ * @brief Wait on a futex.
+ *
+ * If the value of @a futex is still @a expected, the calling thread
+ * sleeps until another thread wakes it up with k_futex_wake() or the
+ * timeout expires.  The check and the sleep are atomic with respect to
+ * k_futex_wake().
+ *
+ * @param futex Address of the futex, writable by the calling thread.
+ * @param expected Value the caller last saw in the futex.
+ * @param timeout Waiting period (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Woken up by k_futex_wake().
+ * @retval -EAGAIN The futex did not hold @a expected.
+ * @retval -ETIMEDOUT Waiting period timed out.
+ */
+__syscall int k_futex_wait(struct k_futex *futex, int expected,
+			   s32_t timeout);
+
+/**
+ * @brief Wake threads waiting on a futex.
+ *
+ * Wakes the highest priority thread waiting on @a futex, or all of them.
+ *
+ * @param futex Address of the futex, writable by the calling thread.
+ * @param wake_all Wake all waiting threads rather than just one.
+ *
+ * @return Number of threads woken up.
+ */
+__syscall int k_futex_wake(struct k_futex *futex, bool wake_all);
+
 /**
  * @}
  */
@@ -2998,6 +3336,7 @@ __syscall void k_mutex_unlock(struct k_mutex *mutex);
 
 struct k_sem {
 	_wait_q_t wait_q;
+	struct k_spinlock lock;
 	u32_t count;
 	u32_t limit;
 	_POLL_EVENT;
@@ -3315,6 +3654,58 @@ __syscall int k_msgq_put(struct k_msgq *q, void *data, s32_t timeout);
  */
 __syscall int k_msgq_get(struct k_msgq *q, void *data, s32_t timeout);
 
+/**
+ * @brief Send several messages to a message queue.
+ *
+ * This routine sends up to @a num_msgs consecutive messages from @a data
+ * to message queue @a q under a single lock acquisition, waking any
+ * receivers with a single reschedule. Messages go to waiting receivers
+ * first and then into the queue buffer until it is full. If the queue
+ * is full to begin with, the routine waits up to @a timeout for room for
+ * the first message, then sends whatever else fits without waiting
+ * again.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param q Address of the message queue.
+ * @param data Pointer to the messages.
+ * @param num_msgs Number of messages at @a data.
+ * @param timeout Waiting period to add the first message (in
+ *                milliseconds), or one of the special values K_NO_WAIT
+ *                and K_FOREVER.
+ *
+ * @return Number of messages sent, which may be less than @a num_msgs.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_put_many(struct k_msgq *q, const void *data,
+			      u32_t num_msgs, s32_t timeout);
+
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a num_msgs messages from message queue
+ * @a q in "first in, first out" order under a single lock acquisition,
+ * refilling the freed space from waiting senders. If the queue is empty
+ * to begin with, the routine waits up to @a timeout for the first
+ * message, then takes whatever else is queued without waiting again.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param q Address of the message queue.
+ * @param data Address of area to hold @a num_msgs messages.
+ * @param num_msgs Maximum number of messages to receive.
+ * @param timeout Waiting period to receive the first message (in
+ *                milliseconds), or one of the special values K_NO_WAIT
+ *                and K_FOREVER.
+ *
+ * @return Number of messages received.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_get_many(struct k_msgq *q, void *data, u32_t num_msgs,
+			      s32_t timeout);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -3628,6 +4019,12 @@ extern int k_mbox_data_block_get(struct k_mbox_msg *rx_msg,
  * @{
  */
 
+/** Buffer of a scatter-gather transfer */
+struct k_iovec {
+	void *iov_base;                 /**< Start of the buffer */
+	size_t iov_len;                 /**< Buffer size */
+};
+
 /** Pipe Structure */
 struct k_pipe {
 	unsigned char *buffer;          /**< Pipe buffer: may be NULL */
@@ -3806,20 +4203,179 @@ __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
 extern void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 			     size_t size, struct k_sem *sem);
 
+/**
+ * @brief Write scattered data to a pipe.
+ *
+ * This routine writes the buffers described by @a iov to @a pipe, in
+ * order, as a single k_pipe_put() of their concatenation would, but
+ * copying straight from each buffer.
+ *
+ * Unlike k_pipe_put(), when returning without waiting because fewer than
+ * @a min_xfer bytes could be written, the leading buffers that fitted may
+ * already have been written; @a bytes_written says how much.
+ *
+ * @param pipe Address of the pipe.
+ * @param iov Buffers to write.
+ * @param iovcnt Number of buffers.
+ * @param bytes_written Address of area to hold the number of bytes written.
+ * @param min_xfer Minimum number of bytes to write.
+ * @param timeout Waiting period to wait for the data to be written (in
+ *                milliseconds), or one of the special values K_NO_WAIT
+ *                and K_FOREVER.
+ *
+ * @retval 0 At least @a min_xfer bytes of data were written.
+ * @retval -EIO Returned without waiting; fewer than @a min_xfer bytes
+ *              were written.
+ * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
+ *                 minus one data bytes were written.
+ */
+extern int k_pipe_put_iov(struct k_pipe *pipe, const struct k_iovec *iov,
+			  size_t iovcnt, size_t *bytes_written,
+			  size_t min_xfer, s32_t timeout);
+
+/**
+ * @brief Read data from a pipe into scattered buffers.
+ *
+ * This routine fills the buffers described by @a iov from @a pipe, in
+ * order, as a single k_pipe_get() into their concatenation would, but
+ * copying straight into each buffer.
+ *
+ * Unlike k_pipe_get(), when returning without waiting because fewer than
+ * @a min_xfer bytes could be read, the leading buffers may already have
+ * been filled; @a bytes_read says how much.
+ *
+ * @param pipe Address of the pipe.
+ * @param iov Buffers to fill.
+ * @param iovcnt Number of buffers.
+ * @param bytes_read Address of area to hold the number of bytes read.
+ * @param min_xfer Minimum number of data bytes to read.
+ * @param timeout Waiting period to wait for the data to be read (in
+ *                milliseconds), or one of the special values K_NO_WAIT
+ *                and K_FOREVER.
+ *
+ * @retval 0 At least @a min_xfer bytes of data were read.
+ * @retval -EIO Returned without waiting; fewer than @a min_xfer bytes
+ *              were read.
+ * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
+ *                 minus one data bytes were read.
+ */
+extern int k_pipe_get_iov(struct k_pipe *pipe, const struct k_iovec *iov,
+			  size_t iovcnt, size_t *bytes_read,
+			  size_t min_xfer, s32_t timeout);
+
+/**
+ * @brief Claim free space of a pipe's buffer for writing.
+ *
+ * This routine gives direct access to the contiguous free space of the
+ * pipe's buffer that the next write would fill, so that data can be
+ * produced in place and then added to the pipe with k_pipe_put_commit(),
+ * without a copy.  Never waits.
+ *
+ * Only one claim for writing may be outstanding at a time, and the pipe
+ * must not be written to by other means until it is committed.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of area to hold the start of the claimed space.
+ * @param size Maximum number of bytes to claim.
+ *
+ * @return Number of bytes claimed, 0 if the buffer is full or the pipe
+ *         has none.
+ */
+extern size_t k_pipe_put_claim(struct k_pipe *pipe, u8_t **data,
+			       size_t size);
+
+/**
+ * @brief Add data written in claimed space to a pipe.
+ *
+ * Makes the first @a size bytes of the space obtained from
+ * k_pipe_put_claim() part of the pipe's data, and hands them to waiting
+ * readers.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes written, at most the number claimed.
+ *
+ * @retval 0 Data added.
+ * @retval -EINVAL @a size exceeds the free space claimable.
+ */
+extern int k_pipe_put_commit(struct k_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim data of a pipe's buffer for reading.
+ *
+ * This routine gives direct access to the contiguous data of the pipe's
+ * buffer that the next read would return, so that it can be consumed in
+ * place and then released with k_pipe_get_commit(), without a copy.
+ * Data of writers waiting on a full pipe is not part of the buffer and
+ * cannot be claimed before it is moved in.  Never waits.
+ *
+ * Only one claim for reading may be outstanding at a time, and the pipe
+ * must not be read from by other means until it is committed.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of area to hold the start of the claimed data.
+ * @param size Maximum number of bytes to claim.
+ *
+ * @return Number of bytes claimed, 0 if the buffer is empty or the pipe
+ *         has none.
+ */
+extern size_t k_pipe_get_claim(struct k_pipe *pipe, u8_t **data,
+			       size_t size);
+
+/**
+ * @brief Release data read from claimed space of a pipe.
+ *
+ * Removes the first @a size bytes of the data obtained from
+ * k_pipe_get_claim() from the pipe, and moves data of waiting writers
+ * into the space freed.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes consumed, at most the number claimed.
+ *
+ * @retval 0 Data released.
+ * @retval -EINVAL @a size exceeds the data claimable.
+ */
+extern int k_pipe_get_commit(struct k_pipe *pipe, size_t size);
+
 /** @} */
 
 /**
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+/* Per-CPU cache of free blocks, chained through their first word
+ * like the slab free list.  "loaded" serves requests, "previous" is
+ * swapped in when it runs full or empty.
+ */
+struct _mem_slab_magazine {
+	struct k_spinlock lock;
+	char *loaded;
+	char *previous;
+	u8_t loaded_count;
+	u8_t previous_count;
+	u32_t hits;
+	u32_t misses;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
+	struct k_spinlock lock;
 	u32_t num_blocks;
 	size_t block_size;
 	char *buffer;
 	char *free_list;
+	/* With magazines, includes the blocks cached in them */
 	u32_t num_used;
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	/* Threads in the allocation slow path; while non-zero frees
+	 * bypass the magazines
+	 */
+	atomic_t mag_waiters;
+	struct _mem_slab_magazine mag[CONFIG_MP_NUM_CPUS];
+#endif
+
 	_OBJECT_TRACING_NEXT_PTR(k_mem_slab)
 };
 
@@ -3932,6 +4488,10 @@ extern int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem,
  */
 extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+extern u32_t z_mem_slab_num_cached(struct k_mem_slab *slab);
+#endif
+
 /**
  * @brief Get the number of used blocks in a memory slab.
  *
@@ -3945,7 +4505,11 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline u32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	return slab->num_used - z_mem_slab_num_cached(slab);
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
@@ -3961,9 +4525,35 @@ static inline u32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
  */
 static inline u32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+/**
+ * @brief Memory slab magazine cache statistics.
+ */
+struct k_mem_slab_cache_stats {
+	/** Allocations and frees served from a per-CPU magazine */
+	u32_t hits;
+	/** Operations that had to go to the slab's free list */
+	u32_t misses;
+};
+
+/**
+ * @brief Get the magazine cache statistics of a memory slab.
+ *
+ * The counts are summed over all CPUs without locking and are only a
+ * snapshot.
+ *
+ * @param slab Address of the memory slab.
+ * @param stats Filled with the hit and miss counts.
+ *
+ * @return N/A
+ */
+extern void k_mem_slab_cache_stats_get(struct k_mem_slab *slab,
+				       struct k_mem_slab_cache_stats *stats);
+#endif
+
 /** @} */
 
 /**
@@ -4078,6 +4668,25 @@ extern void k_mem_pool_free(struct k_mem_block *block);
  */
 extern void k_mem_pool_free_id(struct k_mem_block_id *id);
 
+#ifdef CONFIG_SYS_MEM_STATS
+struct sys_mem_stats;
+
+/**
+ * @brief Get usage statistics of a memory pool.
+ *
+ * Reports the bytes handed out (in whole blocks), their high-water mark
+ * and the largest block that could currently be allocated.  See
+ * misc/mem_stats.h.
+ *
+ * @param pool Address of the memory pool.
+ * @param stats Filled with the pool statistics.
+ *
+ * @return N/A
+ */
+extern void k_mem_pool_stats_get(struct k_mem_pool *pool,
+				 struct sys_mem_stats *stats);
+#endif
+
 /**
  * @}
  */
@@ -4145,6 +4754,8 @@ extern void *k_calloc(size_t nmemb, size_t size);
 struct _poller {
 	struct k_thread *thread;
 	volatile bool is_polling;
+	/* poller of a k_poll_set rather than of a k_poll() call */
+	bool is_set;
 };
 
 /* private - types bit positions */
@@ -4436,6 +5047,103 @@ __syscall void k_poll_signal_check(struct k_poll_signal *signal,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *signal, int result);
 
+/* public - flags of k_poll_set_init() */
+
+/* report events once per notification, instead of while they are ready */
+#define K_POLL_SET_EDGE_TRIGGERED BIT(0)
+
+/* public - poll set object */
+struct k_poll_set {
+	/* PRIVATE - DO NOT TOUCH */
+	struct _poller poller;
+
+	/* PRIVATE - DO NOT TOUCH */
+	sys_dlist_t ready;
+
+	/* PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+
+	/* K_POLL_SET_xxx flags */
+	u32_t flags;
+};
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * A poll set is a persistent alternative to the event array of k_poll():
+ * its events stay registered on their objects across waits, an object
+ * becoming available moves its event to the set's ready list, and
+ * k_poll_set_wait() only ever looks at that list. Waiting on a set thus
+ * costs the same whatever the number of events in it.
+ *
+ * By default the set is level-triggered: an event reported by
+ * k_poll_set_wait() is reported again by the following waits for as long
+ * as its object is available. With K_POLL_SET_EDGE_TRIGGERED, it is only
+ * reported again after its object is made available anew, so the caller
+ * must then consume all that is available, e.g. take a semaphore until
+ * it fails.
+ *
+ * Poll sets link the events into kernel objects, and are therefore only
+ * available to supervisor threads.
+ *
+ * @param set The poll set.
+ * @param flags K_POLL_SET_xxx flags, or 0.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_init(struct k_poll_set *set, u32_t flags);
+
+/**
+ * @brief Add an event to a poll set.
+ *
+ * The event, initialized with k_poll_event_init(), belongs to the set
+ * until removed with k_poll_set_remove(), and must not be passed to
+ * k_poll() or added to another set meanwhile.
+ *
+ * @param set The poll set.
+ * @param event The event to add.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_add(struct k_poll_set *set,
+			   struct k_poll_event *event);
+
+/**
+ * @brief Remove an event from a poll set.
+ *
+ * @param set The poll set.
+ * @param event The event to remove.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_remove(struct k_poll_set *set,
+			      struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to be ready
+ *
+ * This routine returns as soon as at least one of the events of @a set is
+ * ready, with up to @a max_events of them in @a ready. The state field of
+ * each of those reflects why it is ready, as with k_poll(), and does not
+ * need to be reset. The state field of the other events of the set is
+ * K_POLL_STATE_NOT_READY.
+ *
+ * Several threads may wait on the same set: each notification wakes one
+ * of them.
+ *
+ * @param set The poll set.
+ * @param ready An array to hold the ready events.
+ * @param max_events The size of the array.
+ * @param timeout Waiting period for an event to be ready (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of events stored in @a ready, or -EAGAIN if the waiting
+ *         period timed out.
+ */
+extern int k_poll_set_wait(struct k_poll_set *set,
+			   struct k_poll_event **ready, int max_events,
+			   s32_t timeout);
+
 /**
  * @internal
  */
@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_MISC_ASYNC_H_
+#define ZEPHYR_INCLUDE_MISC_ASYNC_H_
+
+#include <kernel.h>
+#include <misc/dlist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup async_apis Stackless async task APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/*
+ * Stackless async tasks.
+ *
+ * An async task is a function written between SYS_ASYNC_BEGIN() and
+ * SYS_ASYNC_END(), which may suspend itself with the SYS_ASYNC_*()
+ * wait macros, protothread style: suspending returns from the
+ * function, after saving the point to resume from in the task, and the
+ * function jumps back there when the runtime calls it again.  All the
+ * tasks of a runtime thus share the stack of its single thread, and a
+ * task costs a struct sys_async plus its own state.
+ *
+ * The runtime thread runs the ready tasks one after the other, then
+ * k_poll()s on the objects the suspended tasks wait for, all at once.
+ *
+ * Because the task function returns when suspending, its local
+ * variables do not survive a wait: keep the state in a structure
+ * embedding the struct sys_async and get at it with CONTAINER_OF().
+ * Task functions must not block, nor use the wait macros more than
+ * once on the same source line, nor from within a switch statement.
+ */
+
+struct sys_async;
+struct sys_async_runtime;
+
+/**
+ * @brief Async task function
+ *
+ * Only returns through the SYS_ASYNC_*() macros.
+ *
+ * @param task The task being run
+ */
+typedef int (*sys_async_fn_t)(struct sys_async *task);
+
+/**
+ * @brief Async task
+ */
+struct sys_async {
+	sys_dnode_t node;
+	sys_async_fn_t fn;
+	struct sys_async_runtime *rt;
+	/* Where to resume the task function, 0 for its beginning */
+	u16_t resume;
+	/** Result of the last wait: 0, -EAGAIN on timeout, or -EINTR if
+	 * the object waited for was cancelled
+	 */
+	int result;
+	/* Uptime at which the wait times out */
+	s64_t deadline;
+	/* What the task waits for */
+	struct k_poll_event event;
+};
+
+/** @cond INTERNAL_HIDDEN */
+
+enum {
+	_SYS_ASYNC_DONE,
+	_SYS_ASYNC_YIELD,
+	_SYS_ASYNC_WAIT,
+};
+
+void _sys_async_set_timeout(struct sys_async *task, s32_t timeout);
+void _sys_async_wait_event(struct sys_async *task, u32_t type, void *obj);
+int _sys_async_wait_fd(struct sys_async *task, int fd, int events);
+
+#define _SYS_ASYNC_SUSPEND(task, why) \
+	do { \
+		(task)->resume = __LINE__; \
+		return (why); \
+		case __LINE__: ; \
+	} while (false)
+
+/** @endcond */
+
+/**
+ * @brief Start the body of an async task function
+ *
+ * @param task The task, parameter of the task function
+ */
+#define SYS_ASYNC_BEGIN(task) \
+	switch ((task)->resume) { \
+	case 0:
+
+/**
+ * @brief End the body of an async task function
+ *
+ * The task is done once it gets there.
+ *
+ * @param task The task, parameter of the task function
+ */
+#define SYS_ASYNC_END(task) \
+	} \
+	return _SYS_ASYNC_DONE
+
+/**
+ * @brief End an async task early
+ *
+ * @param task The task, parameter of the task function
+ */
+#define SYS_ASYNC_EXIT(task) return _SYS_ASYNC_DONE
+
+/**
+ * @brief Let the other ready tasks run
+ *
+ * @param task The task, parameter of the task function
+ */
+#define SYS_ASYNC_YIELD(task) _SYS_ASYNC_SUSPEND(task, _SYS_ASYNC_YIELD)
+
+/**
+ * @brief Wait for a kernel object to be ready
+ *
+ * Suspends the task until the condition @a type holds for @a obj, as
+ * for k_poll().  Like with K_POLL_MODE_NOTIFY_ONLY, the task must then
+ * take the object's data itself, which another thread may have done
+ * first.  The task's result is set to 0 if @a obj is ready, -EAGAIN
+ * if the wait timed out, or -EINTR if @a obj was cancelled.
+ *
+ * @param task The task, parameter of the task function
+ * @param type One of the K_POLL_TYPE_* condition types
+ * @param obj Kernel object
+ * @param timeout Waiting period (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ */
+#define SYS_ASYNC_AWAIT(task, type, obj, timeout) \
+	do { \
+		_sys_async_set_timeout(task, timeout); \
+		_sys_async_wait_event(task, type, obj); \
+		_SYS_ASYNC_SUSPEND(task, _SYS_ASYNC_WAIT); \
+	} while (false)
+
+/**
+ * @brief Suspend the task for some time
+ *
+ * @param task The task, parameter of the task function
+ * @param ms Duration (in milliseconds)
+ */
+#define SYS_ASYNC_SLEEP(task, ms) \
+	SYS_ASYNC_AWAIT(task, K_POLL_TYPE_IGNORE, NULL, ms)
+
+/**
+ * @brief Take a semaphore
+ *
+ * The task's result is set to 0 once the semaphore is taken, or to
+ * -EAGAIN if the wait timed out.
+ *
+ * @param task The task, parameter of the task function
+ * @param sem Semaphore
+ * @param timeout Waiting period (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ */
+#define SYS_ASYNC_SEM_TAKE(task, sem, timeout) \
+	do { \
+		_sys_async_set_timeout(task, timeout); \
+		while (k_sem_take(sem, K_NO_WAIT) != 0) { \
+			_sys_async_wait_event(task, \
+					      K_POLL_TYPE_SEM_AVAILABLE, sem); \
+			_SYS_ASYNC_SUSPEND(task, _SYS_ASYNC_WAIT); \
+			if ((task)->result != 0) { \
+				break; \
+			} \
+		} \
+	} while (false)
+
+/**
+ * @brief Get an item from a FIFO
+ *
+ * The task's result is set to 0 once an item is got, or to -EAGAIN if
+ * the wait timed out, or -EINTR if the FIFO was cancelled.
+ *
+ * @param task The task, parameter of the task function
+ * @param fifo FIFO
+ * @param timeout Waiting period (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ * @param data Lvalue set to the item got, or NULL
+ */
+#define SYS_ASYNC_FIFO_GET(task, fifo, timeout, data) \
+	do { \
+		_sys_async_set_timeout(task, timeout); \
+		while (((data) = k_fifo_get(fifo, K_NO_WAIT)) == NULL) { \
+			_sys_async_wait_event(task, \
+					      K_POLL_TYPE_FIFO_DATA_AVAILABLE, \
+					      fifo); \
+			_SYS_ASYNC_SUSPEND(task, _SYS_ASYNC_WAIT); \
+			if ((task)->result != 0) { \
+				break; \
+			} \
+		} \
+	} while (false)
+
+/**
+ * @brief Wait for a socket to be ready
+ *
+ * Suspends the task until the file descriptor @a fd is ready for
+ * @a events (ZSOCK_POLLIN, ZSOCK_POLLOUT), as for zsock_poll().  The
+ * task's result is set to 0 if @a fd is possibly ready, -EAGAIN if the
+ * wait timed out, or a negative errno code if @a fd cannot be waited
+ * for.  The task must then do its non-blocking I/O, and wait again if
+ * it fails with EAGAIN.
+ *
+ * @param task The task, parameter of the task function
+ * @param fd File descriptor
+ * @param events Events to wait for
+ * @param timeout Waiting period (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ */
+#define SYS_ASYNC_AWAIT_FD(task, fd, events, timeout) \
+	do { \
+		_sys_async_set_timeout(task, timeout); \
+		if (_sys_async_wait_fd(task, fd, events) == 0) { \
+			_SYS_ASYNC_SUSPEND(task, _SYS_ASYNC_WAIT); \
+		} \
+	} while (false)
+
+/** @cond INTERNAL_HIDDEN */
+
+struct sys_async_runtime {
+	struct k_thread thread;
+	struct k_spinlock lock;
+	/* Raised when tasks are spawned */
+	struct k_poll_signal wake;
+	/* Spawned tasks, protected by the lock */
+	sys_dlist_t spawned;
+	/* The rest is only touched by the runtime thread */
+	sys_dlist_t ready;
+	/* Tasks waiting for a timeout only */
+	sys_dlist_t sleeping;
+	/* Polled: the wake signal, then what waiting[] waits for */
+	struct k_poll_event *events;
+	struct sys_async **waiting;
+	int num_waiting;
+	int max_waiting;
+};
+
+/** @endcond */
+
+/**
+ * @brief Statically define an async runtime
+ *
+ * Defines @a name, to be started with SYS_ASYNC_RUNTIME_START().
+ *
+ * @param name Name of the runtime
+ * @param max_waiting Number of tasks which may wait for kernel objects
+ *                    at the same time, not counting sleeping tasks
+ * @param stack_size Stack size of the runtime thread, shared by all
+ *                   its tasks
+ */
+#define SYS_ASYNC_RUNTIME_DEFINE(name, max_waiting, stack_size) \
+	K_THREAD_STACK_DEFINE(_async_stack_##name, stack_size); \
+	static struct k_poll_event _async_events_##name[(max_waiting) + 1]; \
+	static struct sys_async *_async_waiting_##name[max_waiting]; \
+	struct sys_async_runtime name
+
+/**
+ * @brief Start an async runtime defined with SYS_ASYNC_RUNTIME_DEFINE()
+ *
+ * @param name Name of the runtime
+ * @param prio Priority of the runtime thread
+ */
+#define SYS_ASYNC_RUNTIME_START(name, prio) \
+	sys_async_runtime_start(&name, _async_events_##name, \
+				_async_waiting_##name, \
+				ARRAY_SIZE(_async_waiting_##name), \
+				_async_stack_##name, \
+				K_THREAD_STACK_SIZEOF(_async_stack_##name), \
+				prio)
+
+/**
+ * @brief Start an async runtime
+ *
+ * @param rt Runtime
+ * @param events Array of @a max_waiting + 1 poll events
+ * @param waiting Array of @a max_waiting task pointers
+ * @param max_waiting Number of tasks which may wait for kernel objects
+ *                    at the same time
+ * @param stack Stack of the runtime thread
+ * @param stack_size Size of the stack
+ * @param prio Priority of the runtime thread
+ */
+void sys_async_runtime_start(struct sys_async_runtime *rt,
+			     struct k_poll_event *events,
+			     struct sys_async **waiting, int max_waiting,
+			     k_thread_stack_t *stack, size_t stack_size,
+			     int prio);
+
+/**
+ * @brief Start an async task
+ *
+ * Makes @a task ready to run @a fn from its beginning in @a rt.  May be
+ * called from ISRs and from other tasks.  @a task must be zeroed before
+ * it is first spawned.  If more than the runtime's
+ * maximum number of tasks wait for kernel objects at the same time,
+ * the extra waits fail with -ENOMEM.
+ *
+ * @param rt Runtime
+ * @param task Task
+ * @param fn Task function
+ *
+ * @retval 0 Task started.
+ * @retval -EBUSY Task is already running.
+ */
+int sys_async_spawn(struct sys_async_runtime *rt, struct sys_async *task,
+		    sys_async_fn_t fn);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_MISC_ASYNC_H_ */
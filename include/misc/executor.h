@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_MISC_EXECUTOR_H_
+#define ZEPHYR_INCLUDE_MISC_EXECUTOR_H_
+
+#include <kernel.h>
+#include <misc/dlist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup executor_apis Executor APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/*
+ * Thread pool executor.
+ *
+ * Like a k_work_q, an executor runs caller-owned work items in
+ * dedicated threads, but it has several worker threads, and so can use
+ * several CPUs, and reports each item's result through a future.
+ *
+ * Each worker has its own deque per task priority.  Tasks submitted by
+ * a task running in the executor go to the front of that worker's
+ * deque, so fanned out work is done newest first while it is still hot
+ * in the cache; tasks submitted from elsewhere are spread round-robin
+ * over the workers' deques, at the back.  A worker runs the highest
+ * priority task of its own deques and, once they are empty, steals the
+ * oldest highest priority task of another worker before going idle.
+ * Priorities are thus honored per worker, not globally.
+ */
+
+/**
+ * @brief Completion of an asynchronous operation
+ *
+ * A future is completed once, with an integer result.  It can be
+ * waited for with sys_future_wait(), or together with other kernel
+ * objects with k_poll() on the event set up by sys_future_poll_event().
+ */
+struct sys_future {
+	struct k_poll_signal signal;
+};
+
+/**
+ * @brief Initialize a future, or reset a completed one
+ *
+ * @param future Future
+ */
+static inline void sys_future_init(struct sys_future *future)
+{
+	k_poll_signal_init(&future->signal);
+}
+
+/**
+ * @brief Complete a future
+ *
+ * Wakes up the threads waiting for @a future.  May be called from ISRs.
+ *
+ * @param future Future
+ * @param result Result of the operation
+ */
+static inline void sys_future_complete(struct sys_future *future, int result)
+{
+	(void)k_poll_signal_raise(&future->signal, result);
+}
+
+/**
+ * @brief Test whether a future is complete
+ *
+ * @param future Future
+ * @param result Set to the result of the operation if complete
+ * @return true if @a future is complete
+ */
+static inline bool sys_future_is_done(struct sys_future *future, int *result)
+{
+	unsigned int signaled;
+
+	k_poll_signal_check(&future->signal, &signaled, result);
+
+	return signaled != 0U;
+}
+
+/**
+ * @brief Set up a poll event for a future
+ *
+ * The event is ready once @a future completes.
+ *
+ * @param event Poll event to initialize
+ * @param future Future
+ */
+static inline void sys_future_poll_event(struct k_poll_event *event,
+					 struct sys_future *future)
+{
+	k_poll_event_init(event, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+			  &future->signal);
+}
+
+/**
+ * @brief Wait for a future to complete
+ *
+ * @param future Future
+ * @param result Set to the result of the operation
+ * @param timeout Waiting period (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Future complete.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int sys_future_wait(struct sys_future *future, int *result, s32_t timeout);
+
+struct sys_task;
+
+/**
+ * @brief Task handler
+ *
+ * @param task The task being run
+ * @return Result of the task, passed to its future
+ */
+typedef int (*sys_task_handler_t)(struct sys_task *task);
+
+/**
+ * @brief Task run by an executor
+ *
+ * Embed it in a structure holding the task's arguments, and get at
+ * them from the handler with CONTAINER_OF().
+ */
+struct sys_task {
+	sys_dnode_t node;
+	sys_task_handler_t handler;
+	/** Completed with the handler's result */
+	struct sys_future future;
+	atomic_t busy;
+};
+
+/**
+ * @brief Initialize a task
+ *
+ * @param task Task
+ * @param handler Function run by the executor
+ */
+static inline void sys_task_init(struct sys_task *task,
+				 sys_task_handler_t handler)
+{
+	task->handler = handler;
+	atomic_clear(&task->busy);
+	sys_future_init(&task->future);
+}
+
+struct sys_executor;
+
+/** @cond INTERNAL_HIDDEN */
+
+struct sys_executor_worker {
+	struct k_thread thread;
+	struct sys_executor *exec;
+	struct k_spinlock lock;
+	/* Bit n set while deque[n] is not empty */
+	u32_t ready;
+	sys_dlist_t deque[CONFIG_SYS_EXECUTOR_PRIORITIES];
+};
+
+/** @endcond */
+
+/**
+ * @brief Executor
+ */
+struct sys_executor {
+	struct sys_executor_worker *workers;
+	int num_workers;
+	/* Where the next task from outside the executor goes */
+	atomic_t next;
+	/* One count per queued task */
+	struct k_sem pending;
+	/* Serializes task submission and completion */
+	struct k_spinlock lock;
+};
+
+/**
+ * @brief Statically define the workers and stacks of an executor
+ *
+ * Defines @a name, to be started with SYS_EXECUTOR_START().
+ *
+ * @param name Name of the executor
+ * @param num_workers Number of worker threads
+ * @param stack_size Stack size of each worker thread
+ */
+#define SYS_EXECUTOR_DEFINE(name, num_workers, stack_size) \
+	K_THREAD_STACK_ARRAY_DEFINE(_executor_stacks_##name, num_workers, \
+				    stack_size); \
+	static struct sys_executor_worker \
+		_executor_workers_##name[num_workers]; \
+	struct sys_executor name
+
+/**
+ * @brief Start an executor defined with SYS_EXECUTOR_DEFINE()
+ *
+ * @param name Name of the executor
+ * @param prio Priority of the worker threads
+ */
+#define SYS_EXECUTOR_START(name, prio) \
+	sys_executor_start(&name, _executor_workers_##name, \
+			   ARRAY_SIZE(_executor_workers_##name), \
+			   _executor_stacks_##name[0], \
+			   sizeof(_executor_stacks_##name[0]), \
+			   K_THREAD_STACK_SIZEOF(_executor_stacks_##name[0]), \
+			   prio)
+
+/**
+ * @brief Start an executor
+ *
+ * @param exec Executor
+ * @param workers Array of @a num_workers worker structures
+ * @param num_workers Number of worker threads
+ * @param stacks First of @a num_workers stacks, as defined by
+ *               K_THREAD_STACK_ARRAY_DEFINE()
+ * @param stack_stride Distance between two stacks of the array, that is
+ *                     the sizeof() of one
+ * @param stack_size Usable size of each stack, K_THREAD_STACK_SIZEOF()
+ *                   of one
+ * @param prio Priority of the worker threads
+ */
+void sys_executor_start(struct sys_executor *exec,
+			struct sys_executor_worker *workers, int num_workers,
+			k_thread_stack_t *stacks, size_t stack_stride,
+			size_t stack_size, int prio);
+
+/**
+ * @brief Submit a task to an executor
+ *
+ * The task's future is reset, and completed with the handler's result
+ * once it has run.  The task must not be submitted again before then.
+ *
+ * @param exec Executor
+ * @param task Initialized task
+ * @param prio Task priority, 0 (highest) to
+ *             CONFIG_SYS_EXECUTOR_PRIORITIES - 1
+ *
+ * @retval 0 Task queued.
+ * @retval -EBUSY Task is already queued or running.
+ * @retval -EINVAL Invalid priority.
+ */
+int sys_executor_submit(struct sys_executor *exec, struct sys_task *task,
+			int prio);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_MISC_EXECUTOR_H_ */
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Heap and memory pool usage statistics
+ *
+ * With CONFIG_SYS_MEM_STATS every k_mem_pool, sys_mem_pool and TLSF
+ * heap tracks its allocated bytes and high-water mark.  With
+ * CONFIG_SYS_MEM_STATS_SITES > 0 allocations made through k_malloc()
+ * (and everything else released with k_free()) and through the
+ * minimal libc malloc() are additionally attributed to the address
+ * they were called from, so leaks and heavy users can be found.
+ */
+
+#ifndef ZEPHYR_INCLUDE_MISC_MEM_STATS_H_
+#define ZEPHYR_INCLUDE_MISC_MEM_STATS_H_
+
+#include <zephyr/types.h>
+#include <stddef.h>
+
+#ifdef CONFIG_SYS_MEM_STATS
+
+/**
+ * @brief Usage statistics of one heap or memory pool
+ */
+struct sys_mem_stats {
+	/** Bytes managed by the allocator */
+	size_t total_bytes;
+	/** Bytes currently handed out, including rounding and headers */
+	size_t allocated_bytes;
+	/** High-water mark of allocated_bytes */
+	size_t max_allocated_bytes;
+	/** Largest block that could be allocated right now */
+	size_t largest_free_bytes;
+};
+
+/**
+ * @brief Fragmentation of the free space
+ *
+ * The share of free memory that is not part of the largest free block,
+ * in percent.  0 means all free memory is contiguous.
+ *
+ * @param stats Statistics as returned by one of the *_stats_get() calls
+ * @return Fragmentation in percent
+ */
+static inline u32_t sys_mem_stats_frag_pct(const struct sys_mem_stats *stats)
+{
+	size_t free_bytes = stats->total_bytes - stats->allocated_bytes;
+
+	if (free_bytes == 0 || stats->largest_free_bytes >= free_bytes) {
+		return 0;
+	}
+
+	return (u32_t)((u64_t)(free_bytes - stats->largest_free_bytes) * 100 /
+		       free_bytes);
+}
+
+/**
+ * @brief Get the statistics of the k_malloc() heap
+ *
+ * @param stats Filled with the heap statistics
+ * @return 0 on success, -ENOTSUP if there is no heap
+ */
+int k_malloc_stats_get(struct sys_mem_stats *stats);
+
+/**
+ * @brief Get the statistics of the minimal libc malloc() arena
+ *
+ * Not available with CONFIG_NEWLIB_LIBC.
+ *
+ * @param stats Filled with the arena statistics
+ * @return 0 on success, -ENOTSUP if there is no arena
+ */
+int sys_malloc_stats_get(struct sys_mem_stats *stats);
+
+#if CONFIG_SYS_MEM_STATS_SITES > 0
+
+/**
+ * @brief Allocations attributed to one call site
+ */
+struct sys_mem_site {
+	/** Return address of the allocation call */
+	const void *site;
+	/** Allocations made from this site */
+	u32_t allocs;
+	/** Allocations from this site not yet freed */
+	u32_t live;
+	/** Requested bytes not yet freed */
+	size_t live_bytes;
+	/** High-water mark of live_bytes */
+	size_t max_live_bytes;
+};
+
+/* Site table of one heap; callers provide the locking.  Internal. */
+struct _sys_mem_sites {
+	struct sys_mem_site sites[CONFIG_SYS_MEM_STATS_SITES];
+	u32_t dropped;
+};
+
+/* Header in front of each tracked allocation.  Internal. */
+struct _sys_mem_site_hdr {
+	u32_t index;
+	u32_t size;
+};
+
+typedef void (*sys_mem_site_cb_t)(const struct sys_mem_site *site,
+				  void *user_data);
+
+/**
+ * @brief Iterate over the call sites of k_malloc() heap allocations
+ *
+ * Each entry is copied under the heap lock and the callback invoked on
+ * the copy.  Allocations from any pool released with k_free() are
+ * included.
+ *
+ * @param cb Callback invoked for each site
+ * @param user_data Opaque pointer handed to the callback
+ */
+void k_malloc_sites_foreach(sys_mem_site_cb_t cb, void *user_data);
+
+/**
+ * @brief Iterate over the call sites of minimal libc malloc() allocations
+ *
+ * Not available with CONFIG_NEWLIB_LIBC.
+ *
+ * @param cb Callback invoked for each site
+ * @param user_data Opaque pointer handed to the callback
+ */
+void sys_malloc_sites_foreach(sys_mem_site_cb_t cb, void *user_data);
+
+/* Record an allocation of size bytes at mem, which has room for the
+ * header in front, and return the pointer to hand out.  Internal.
+ */
+void *_sys_mem_sites_track(struct _sys_mem_sites *t, void *mem,
+			   size_t size, const void *site);
+
+/* Undo _sys_mem_sites_track() and return the underlying allocation.
+ * Internal.
+ */
+void *_sys_mem_sites_untrack(struct _sys_mem_sites *t, void *ptr);
+
+#define _SYS_MEM_SITES_HDR_SIZE sizeof(struct _sys_mem_site_hdr)
+#else
+#define _SYS_MEM_SITES_HDR_SIZE 0
+#endif /* CONFIG_SYS_MEM_STATS_SITES > 0 */
+
+#endif /* CONFIG_SYS_MEM_STATS */
+
+#endif /* ZEPHYR_INCLUDE_MISC_MEM_STATS_H_ */
@@ -99,4 +99,19 @@ void *sys_mem_pool_alloc(struct sys_mem_pool *p, size_t size);
  */
 void sys_mem_pool_free(void *ptr);
 
+#ifdef CONFIG_SYS_MEM_STATS
+struct sys_mem_stats;
+
+/**
+ * @brief Get usage statistics of a memory pool
+ *
+ * See misc/mem_stats.h.
+ *
+ * @param p Address of the memory pool
+ * @param stats Filled with the pool statistics
+ */
+void sys_mem_pool_stats_get(struct sys_mem_pool *p,
+			    struct sys_mem_stats *stats);
+#endif
+
 #endif
@@ -34,6 +34,10 @@ struct sys_mem_pool_base {
 	s8_t max_inline_level;
 	struct sys_mem_pool_lvl *levels;
 	u8_t flags;
+#ifdef CONFIG_SYS_MEM_STATS
+	size_t allocated;
+	size_t max_allocated;
+#endif
 };
 
 #define _ALIGN4(n) ((((n)+3)/4)*4)
@@ -109,4 +113,11 @@ int _sys_mem_pool_block_alloc(struct sys_mem_pool_base *p, size_t size,
 void _sys_mem_pool_block_free(struct sys_mem_pool_base *p, u32_t level,
 			      u32_t block);
 
+#ifdef CONFIG_SYS_MEM_STATS
+struct sys_mem_stats;
+
+void _sys_mem_pool_base_stats(struct sys_mem_pool_base *p,
+			      struct sys_mem_stats *stats);
+#endif
+
 #endif /* ZEPHYR_INCLUDE_MISC_MEMPOOL_BASE_H_ */
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_MISC_MUTEX_H_
+#define ZEPHYR_INCLUDE_MISC_MUTEX_H_
+
+/*
+ * Futex based mutex.
+ *
+ * Locking and unlocking an uncontended sys_mutex is a single atomic
+ * operation on memory owned by the caller, so unlike k_mutex it does not
+ * enter the kernel, which matters for user mode threads where that is a
+ * system call.  The kernel is only asked to sleep or wake threads when
+ * the mutex is contended.
+ *
+ * The price is that the kernel does not know who owns a sys_mutex: there
+ * is no priority inheritance, no recursive locking and no owner checks.
+ * Users needing those track the owner themselves, or use k_mutex.
+ */
+
+#include <kernel.h>
+
+/* Values of the futex */
+#define _SYS_MUTEX_UNLOCKED	0
+#define _SYS_MUTEX_LOCKED	1
+#define _SYS_MUTEX_CONTENDED	2	/* locked, and maybe waited for */
+
+struct sys_mutex {
+	struct k_futex futex;
+};
+
+/**
+ * @brief Statically define and initialize a sys_mutex
+ *
+ * @param name Name of the mutex
+ */
+#define SYS_MUTEX_DEFINE(name) \
+	struct sys_mutex name = { \
+		.futex = { .val = ATOMIC_INIT(_SYS_MUTEX_UNLOCKED) } \
+	}
+
+/**
+ * @brief Initialize a sys_mutex
+ *
+ * @param mutex Mutex, in memory the calling threads can write to
+ */
+static inline void sys_mutex_init(struct sys_mutex *mutex)
+{
+	atomic_set(&mutex->futex.val, _SYS_MUTEX_UNLOCKED);
+}
+
+/**
+ * @brief Lock a sys_mutex
+ *
+ * @param mutex Mutex
+ * @param timeout Waiting period to lock the mutex (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Mutex locked.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int sys_mutex_lock(struct sys_mutex *mutex, s32_t timeout);
+
+/**
+ * @brief Unlock a sys_mutex
+ *
+ * @param mutex Mutex, locked by the calling thread
+ */
+void sys_mutex_unlock(struct sys_mutex *mutex);
+
+/**
+ * @brief Test whether a sys_mutex is locked
+ *
+ * @param mutex Mutex
+ * @return true if some thread holds @a mutex
+ */
+static inline bool sys_mutex_is_locked(struct sys_mutex *mutex)
+{
+	return atomic_get(&mutex->futex.val) != _SYS_MUTEX_UNLOCKED;
+}
+
+#endif /* ZEPHYR_INCLUDE_MISC_MUTEX_H_ */
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_MISC_TLSF_H_
+#define ZEPHYR_INCLUDE_MISC_TLSF_H_
+
+#include <zephyr/types.h>
+#include <stddef.h>
+
+/*
+ * Two-level segregated fit heap.
+ *
+ * Free blocks are kept in segregated lists indexed by a first level
+ * (power of two) and a second level (linear subdivision of that power
+ * of two).  Two bitmaps make finding a suitable non-empty list a pair
+ * of find-first-set operations, so allocation and free are O(1) and
+ * the rounding waste is bounded by 1/_TLSF_SL_COUNT of the request.
+ * Adjacent free blocks are coalesced immediately on free.
+ *
+ * There is no internal locking: callers serialize access to a heap.
+ */
+
+#define _TLSF_ALIGN_LOG2	(sizeof(void *) == 8 ? 3 : 2)
+#define _TLSF_SL_LOG2		4
+#define _TLSF_SL_COUNT		(1 << _TLSF_SL_LOG2)
+#define _TLSF_FL_SHIFT		(_TLSF_SL_LOG2 + _TLSF_ALIGN_LOG2)
+#define _TLSF_FL_COUNT \
+	(CONFIG_SYS_TLSF_MAX_BLOCK_LOG2 - _TLSF_FL_SHIFT + 1)
+
+struct _tlsf_block;
+
+struct sys_tlsf {
+	/* Bounds of the managed memory, for ownership checks */
+	char *start;
+	char *end;
+#ifdef CONFIG_SYS_MEM_STATS
+	size_t allocated;
+	size_t max_allocated;
+#endif
+	u32_t fl_bitmap;
+	u32_t sl_bitmap[_TLSF_FL_COUNT];
+	struct _tlsf_block *blocks[_TLSF_FL_COUNT][_TLSF_SL_COUNT];
+};
+
+/**
+ * @brief Initialize a TLSF heap
+ *
+ * @param h Heap control structure
+ * @param mem Memory to manage, aligned to sizeof(void *)
+ * @param bytes Size of @a mem, less than
+ *	  2^CONFIG_SYS_TLSF_MAX_BLOCK_LOG2.  Memory past that limit is
+ *	  left unused.
+ */
+void sys_tlsf_init(struct sys_tlsf *h, void *mem, size_t bytes);
+
+/**
+ * @brief Allocate memory from a TLSF heap
+ *
+ * The returned pointer is aligned to sizeof(void *).
+ *
+ * @param h Heap
+ * @param bytes Requested size
+ * @return Pointer to the memory, or NULL if no block is large enough
+ */
+void *sys_tlsf_alloc(struct sys_tlsf *h, size_t bytes);
+
+/**
+ * @brief Free memory allocated from a TLSF heap
+ *
+ * It is safe to pass NULL to this function, in which case it is a no-op.
+ *
+ * @param h Heap
+ * @param ptr Memory returned by sys_tlsf_alloc()
+ */
+void sys_tlsf_free(struct sys_tlsf *h, void *ptr);
+
+/**
+ * @brief Usable size of an allocated block
+ *
+ * @param ptr Memory returned by sys_tlsf_alloc()
+ * @return Number of bytes usable at @a ptr, at least the requested size
+ */
+size_t sys_tlsf_usable_size(void *ptr);
+
+#ifdef CONFIG_SYS_MEM_STATS
+struct sys_mem_stats;
+
+/**
+ * @brief Get usage statistics of a TLSF heap
+ *
+ * Allocated bytes include the per-block header.  See misc/mem_stats.h.
+ *
+ * @param h Heap
+ * @param stats Filled with the heap statistics
+ */
+void sys_tlsf_stats_get(struct sys_tlsf *h, struct sys_mem_stats *stats);
+#endif
+
+/**
+ * @brief Test whether memory belongs to a TLSF heap
+ *
+ * @param h Heap
+ * @param ptr Pointer to test
+ * @return true if @a ptr lies within the memory managed by @a h
+ */
+static inline bool sys_tlsf_owns(struct sys_tlsf *h, void *ptr)
+{
+	return (char *)ptr >= h->start && (char *)ptr < h->end;
+}
+
+#endif /* ZEPHYR_INCLUDE_MISC_TLSF_H_ */
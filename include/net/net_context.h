@@ -73,8 +73,10 @@ struct net_context;
  * @param pkt Network buffer that is received. If the pkt is not NULL,
  * then the callback will own the buffer and it needs to to unref the pkt
  * as soon as it has finished working with it.  On EOF, pkt will be NULL.
- * @param ip_hdr a pointer to relevant IP (v4 or v6) header.
+ * @param ip_hdr a pointer to relevant IP (v4 or v6) header. NULL for TCP
+ * data that was received out of order and is passed on later.
  * @param proto_hdr a pointer to relevant protocol (udp or tcp) header.
+ * NULL for TCP data that was received out of order and is passed on later.
  * @param status Value is set to 0 if some data or the connection is
  * at EOF, <0 if there was an error receiving data, in this case the
  * pkt parameter is set to NULL.
@@ -871,6 +873,39 @@ int net_context_sendto_new(struct net_context *context,
 			   void *token,
 			   void *user_data);
 
+/**
+ * @brief Send data gathered from several buffers to a peer.
+ *
+ * @details This function works like net_context_sendto_new(), except that
+ * the data is taken from the buffers of @a iov in turn, so that headers
+ * and payload kept apart by the caller are sent in the same packet.
+ * If the destination address is NULL, the data is sent to the peer the
+ * context is connected to, like with net_context_send_new().
+ * This is similar as BSD sendmsg() function.
+ *
+ * @param context The network context to use.
+ * @param iov The data buffers to send
+ * @param iovcnt Number of buffers
+ * @param dst_addr Destination address, or NULL.
+ * @param addrlen Length of the address.
+ * @param cb Caller-supplied callback function.
+ * @param timeout Timeout for the connection. Possible values
+ * are K_FOREVER, K_NO_WAIT, >0.
+ * @param token Caller specified value that is passed as is to callback.
+ * @param user_data Caller-supplied user data.
+ *
+ * @return numbers of bytes sent on success, a negative errno otherwise
+ */
+int net_context_sendmsg(struct net_context *context,
+			const struct k_iovec *iov,
+			size_t iovcnt,
+			const struct sockaddr *dst_addr,
+			socklen_t addrlen,
+			net_context_send_cb_t cb,
+			s32_t timeout,
+			void *token,
+			void *user_data);
+
 /**
  * @brief Receive network data from a peer specified by context.
  *
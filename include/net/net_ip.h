@@ -1167,6 +1167,58 @@ static inline bool net_tcp_seq_greater(u32_t seq1, u32_t seq2)
 	return net_tcp_seq_cmp(seq1, seq2) > 0;
 }
 
+/**
+ * @brief Update an Internet checksum after a 16-bit field has changed.
+ *
+ * @details The new checksum is computed from the old one as described in
+ *          RFC 1624, without summing the whole data again. The checksum and
+ *          the field values are all in network byte order. Note that a zero
+ *          UDP checksum means that there is no checksum, and must be left
+ *          alone.
+ *
+ * @param chksum Checksum covering the old value of the field
+ * @param old_val Old value of the field
+ * @param new_val New value of the field
+ *
+ * @return Checksum covering the new value of the field
+ */
+static inline u16_t net_chksum_update16(u16_t chksum, u16_t old_val,
+					u16_t new_val)
+{
+	/* HC' = ~(~HC + ~m + m') */
+	u32_t sum = (u16_t)~chksum + (u16_t)~old_val + new_val;
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum += sum >> 16;
+
+	return ~sum;
+}
+
+/**
+ * @brief Update an Internet checksum after a 32-bit field has changed.
+ *
+ * @details This is the same as net_chksum_update16(), for fields such as
+ *          IPv4 addresses.
+ *
+ * @param chksum Checksum covering the old value of the field
+ * @param old_val Old value of the field
+ * @param new_val New value of the field
+ *
+ * @return Checksum covering the new value of the field
+ */
+static inline u16_t net_chksum_update32(u16_t chksum, u32_t old_val,
+					u32_t new_val)
+{
+	u32_t sum = (u16_t)~chksum +
+		(u16_t)~(old_val >> 16) + (u16_t)~old_val +
+		(new_val >> 16) + (new_val & 0xffff);
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum += sum >> 16;
+
+	return ~sum;
+}
+
 /**
  * @brief Convert a string of hex values to array of bytes.
  *
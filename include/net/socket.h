@@ -56,6 +56,7 @@ typedef struct zsock_fd_set {
 #define ZSOCK_POLLNVAL 0x20
 
 #define ZSOCK_MSG_PEEK 0x02
+#define ZSOCK_MSG_TRUNC 0x20
 #define ZSOCK_MSG_DONTWAIT 0x40
 
 /* Well-known values, e.g. from Linux man 2 shutdown:
@@ -120,6 +121,23 @@ typedef struct zsock_fd_set {
 
 /** @} */
 
+/** Message of sendmsg() and recvmsg() */
+struct zsock_msghdr {
+	void *msg_name;           /**< Peer address, optional */
+	socklen_t msg_namelen;    /**< Size of the peer address */
+	struct k_iovec *msg_iov;  /**< Data buffers */
+	size_t msg_iovlen;        /**< Number of data buffers */
+	void *msg_control;        /**< Ancillary data, unsupported */
+	size_t msg_controllen;    /**< Size of the ancillary data */
+	int msg_flags;            /**< Flags of the received message */
+};
+
+/** Message of sendmmsg() and recvmmsg() */
+struct zsock_mmsghdr {
+	struct zsock_msghdr msg_hdr;  /**< Message */
+	unsigned int msg_len;         /**< Number of bytes transferred */
+};
+
 struct zsock_addrinfo {
 	struct zsock_addrinfo *ai_next;
 	int ai_flags;
@@ -170,6 +188,51 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+__syscall ssize_t zsock_sendmsg(int sock, const struct zsock_msghdr *msg,
+				int flags);
+
+__syscall ssize_t zsock_recvmsg(int sock, struct zsock_msghdr *msg, int flags);
+
+/* Batched counterparts of sendmsg() and recvmsg(), returning the number of
+ * messages transferred. recvmmsg() waits for the first message only, and
+ * takes no timeout argument, unlike the Linux one.
+ */
+__syscall int zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+__syscall int zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Receive data without copying it
+ *
+ * @details Hands over the fragments holding the next received datagram, or
+ * the rest of the next received TCP segment, instead of copying the data
+ * to an application buffer. The fragments hold nothing but the data, and
+ * belong to the caller until given back with zsock_recv_loan_release().
+ * Until then they cannot be used to receive more data, so they should be
+ * given back promptly. Only available to threads running in supervisor
+ * mode, on sockets that are not TLS ones.
+ *
+ * @param sock Socket to receive data from
+ * @param frags Set to the fragment chain, or to NULL if there is no data
+ * @param flags ZSOCK_MSG_DONTWAIT or 0
+ * @param src_addr Peer address of a datagram, optional
+ * @param addrlen Size of the peer address buffer, set to the address size
+ *
+ * @return Length of the data, 0 at the end of a stream, -1 with errno set
+ * on error
+ */
+ssize_t zsock_recv_loan(int sock, struct net_buf **frags, int flags,
+			struct sockaddr *src_addr, socklen_t *addrlen);
+
+/**
+ * @brief Give back fragments loaned by zsock_recv_loan()
+ *
+ * @param frags The fragment chain
+ */
+void zsock_recv_loan_release(struct net_buf *frags);
+
 __syscall int zsock_fcntl(int sock, int cmd, int flags);
 
 __syscall int zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout);
@@ -216,6 +279,9 @@ static inline void zsock_freeaddrinfo(struct zsock_addrinfo *ai)
 #define pollfd zsock_pollfd
 #define fd_set zsock_fd_set
 #define timeval zsock_timeval
+#define msghdr zsock_msghdr
+#define mmsghdr zsock_mmsghdr
+#define iovec k_iovec
 #define FD_SETSIZE ZSOCK_FD_SETSIZE
 
 #if !defined(CONFIG_NET_SOCKETS_OFFLOAD)
@@ -281,6 +347,28 @@ static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+static inline ssize_t sendmsg(int sock, const struct msghdr *msg, int flags)
+{
+	return zsock_sendmsg(sock, msg, flags);
+}
+
+static inline ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg(sock, msg, flags);
+}
+
+static inline int sendmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
+static inline int recvmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
 	return zsock_poll(fds, nfds, timeout);
@@ -387,6 +475,7 @@ static inline int inet_pton(sa_family_t family, const char *src, void *dst)
 #define POLLNVAL ZSOCK_POLLNVAL
 
 #define MSG_PEEK ZSOCK_MSG_PEEK
+#define MSG_TRUNC ZSOCK_MSG_TRUNC
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 
 #define SHUT_RD ZSOCK_SHUT_RD
@@ -16,6 +16,7 @@ extern "C" {
 #endif
 
 #include <kernel.h>
+#include <misc/mutex.h>
 
 typedef unsigned long useconds_t;
 
@@ -45,10 +46,10 @@ typedef struct k_sem sem_t;
 
 /* Mutex */
 typedef struct pthread_mutex {
+	struct sys_mutex lock;
 	pthread_t owner;
 	u16_t lock_count;
 	int type;
-	_wait_q_t wait_q;
 } pthread_mutex_t;
 
 typedef struct pthread_mutexattr {
@@ -76,11 +77,8 @@ typedef struct pthread_barrierattr {
 typedef u32_t pthread_rwlockattr_t;
 
 typedef struct pthread_rwlock_obj {
-	struct k_sem rd_sem;
-	struct k_sem wr_sem;
-	struct k_sem reader_active;/* blocks WR till reader has acquired lock */
+	struct k_rwlock rwlock;
 	s32_t status;
-	k_tid_t wr_owner;
 } pthread_rwlock_t;
 
 #endif /* CONFIG_PTHREAD_IPC */
@@ -46,11 +46,28 @@ struct ring_buf {
 		u8_t *buf8;
 	} buf;
 	u32_t mask;   /**< Modulo mask if size is a power of 2 */
+#ifdef CONFIG_POLL
+	/** Raised for a consumer blocked in ring_buf_wait() */
+	struct k_poll_signal *signal;
+	/** Set while a consumer is about to wait for data */
+	u32_t waiting;
+#endif
 };
 
 /**
  * @defgroup ring_buffer_apis Ring Buffer APIs
  * @ingroup kernel_apis
+ *
+ * Byte access (ring_buf_put(), ring_buf_get() and the claim/finish
+ * calls) is lock-free for one producer and one consumer: the producer
+ * only writes the tail and the consumer only writes the head, each
+ * publishing its index with release semantics after touching the data
+ * and reading the other's index with acquire semantics. So an ISR may
+ * produce while a thread consumes (or the other way round) without
+ * irq_lock() or a spinlock. Several producers, or several consumers,
+ * must still serialize among themselves. The consumer can block for data
+ * with ring_buf_wait().
+ *
  * @{
  */
 
@@ -423,6 +440,44 @@ int ring_buf_get_finish(struct ring_buf *buf, u32_t size);
  */
 u32_t ring_buf_get(struct ring_buf *buf, u8_t *data, u32_t size);
 
+#ifdef CONFIG_POLL
+/**
+ * @brief Attach a poll signal to a ring buffer.
+ *
+ * Once attached, the producer raises @a signal when it commits data
+ * while the consumer waits in ring_buf_wait(). Must be called before
+ * the buffer is used, after ring_buf_init() if that is called.
+ *
+ * @param buf Address of ring buffer.
+ * @param signal Signal raised for the consumer.
+ */
+static inline void ring_buf_signal_set(struct ring_buf *buf,
+				       struct k_poll_signal *signal)
+{
+	buf->signal = signal;
+}
+
+/**
+ * @brief Wait for data in a byte mode ring buffer.
+ *
+ * This routine blocks the consumer until the producer commits data with
+ * ring_buf_put() or ring_buf_put_finish(). The producer signals only
+ * while a consumer is waiting, so it stays lock-free otherwise. A signal
+ * must have been attached with ring_buf_signal_set().
+ *
+ * The routine may return 0 with the ring buffer still empty, so callers
+ * should read in a loop.
+ *
+ * @param buf Address of ring buffer.
+ * @param timeout Waiting period (in milliseconds), or one of the special
+ *		  values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Data may be available.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int ring_buf_wait(struct ring_buf *buf, s32_t timeout);
+#endif
+
 /**
  * @}
  */
@@ -44,17 +44,31 @@ void _priq_rb_add(struct _priq_rb *pq, struct k_thread *thread);
 void _priq_rb_remove(struct _priq_rb *pq, struct k_thread *thread);
 struct k_thread *_priq_rb_best(struct _priq_rb *pq);
 
-/* Traditional/textbook "multi-queue" structure.  Separate lists for a
- * small number (max 32 here) of fixed priorities.  This corresponds
- * to the original Zephyr scheduler.  RAM requirements are
- * comparatively high, but performance is very fast.  Won't work with
- * features like deadline scheduling which need large priority spaces
- * to represet their requirements.
+/* Traditional/textbook "multi-queue" structure.  Separate lists for
+ * each fixed priority, indexed by a two-level bitmap: bit i of
+ * bitmask[w] is set if queues[w * 32 + i] is non-empty, and bit w of
+ * bitmask_l1 is set if bitmask[w] is non-zero.  Finding the best
+ * queue is therefore two count-trailing-zeros operations regardless
+ * of the number of priorities (up to 1024).  This corresponds to the
+ * original Zephyr scheduler.  RAM requirements are comparatively
+ * high, but performance is very fast.  With deadline scheduling,
+ * each list is kept sorted by deadline so that add is linear only in
+ * the number of threads at the same priority, and best/remove stay
+ * constant time.
  */
+#ifdef CONFIG_SCHED_MULTIQ
+#define _PRIQ_MQ_NUM_PRIOS \
+	(CONFIG_NUM_COOP_PRIORITIES + CONFIG_NUM_PREEMPT_PRIORITIES + 1)
+#define _PRIQ_MQ_BITMAP_WORDS ((_PRIQ_MQ_NUM_PRIOS + 31) >> 5)
+
 struct _priq_mq {
-	sys_dlist_t queues[32];
-	unsigned int bitmask; /* bit 1<<i set if queues[i] is non-empty */
+	sys_dlist_t queues[_PRIQ_MQ_NUM_PRIOS];
+	unsigned int bitmask[_PRIQ_MQ_BITMAP_WORDS];
+	unsigned int bitmask_l1;
 };
+#else
+struct _priq_mq;
+#endif
 
 void _priq_mq_add(struct _priq_mq *pq, struct k_thread *thread);
 void _priq_mq_remove(struct _priq_mq *pq, struct k_thread *thread);
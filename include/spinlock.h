@@ -8,6 +8,10 @@
 
 #include <atomic.h>
 
+#ifdef CONFIG_LOCK_STATS
+#include <debug/lock_stats.h>
+#endif
+
 /* These stubs aren't provided by the mocking framework, and I can't
  * find a proper place to put them as mocking seems not to have a
  * proper "arch" layer.
@@ -49,9 +53,29 @@ struct k_spinlock {
 	 */
 	size_t thread_cpu;
 #endif
+
+#ifdef CONFIG_SPIN_CONTENTION_COUNT
+	/* Number of acquisitions which found the lock held by another
+	 * CPU.  Only modified with the lock held.
+	 */
+	u32_t contended;
+#endif
+
+#ifdef CONFIG_LOCK_STATS
+	/* Site and start time of the current hold */
+	struct _lock_stats_hold stats;
+#endif
 };
 
+#ifdef CONFIG_LOCK_STATS
+/* Attribute each acquisition to the source line taking the lock */
+#define k_spin_lock(l) z_spin_lock_site((l), __FILE__ ":" STRINGIFY(__LINE__))
+
+static ALWAYS_INLINE k_spinlock_key_t z_spin_lock_site(struct k_spinlock *l,
+						       const char *site)
+#else
 static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
+#endif
 {
 	ARG_UNUSED(l);
 	k_spinlock_key_t k;
@@ -66,11 +90,29 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 	__ASSERT(z_spin_lock_valid(l), "Recursive spinlock");
 #endif
 
+#ifdef CONFIG_LOCK_STATS
+	u32_t start = z_lock_stats_begin();
+	bool contended = false;
+#endif
+
 #ifdef CONFIG_SMP
-	while (!atomic_cas(&l->locked, 0, 1)) {
+	if (!atomic_cas(&l->locked, 0, 1)) {
+		while (!atomic_cas(&l->locked, 0, 1)) {
+		}
+#ifdef CONFIG_SPIN_CONTENTION_COUNT
+		l->contended++;
+#endif
+#ifdef CONFIG_LOCK_STATS
+		contended = true;
+#endif
 	}
 #endif
 
+#ifdef CONFIG_LOCK_STATS
+	z_lock_stats_acquired(&l->stats, site, LOCK_STATS_SPINLOCK,
+			      start, contended);
+#endif
+
 	return k;
 }
 
@@ -82,6 +124,10 @@ static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
 	__ASSERT(z_spin_unlock_valid(l), "Not my spinlock!");
 #endif
 
+#ifdef CONFIG_LOCK_STATS
+	z_lock_stats_released(&l->stats);
+#endif
+
 #ifdef CONFIG_SMP
 	/* Strictly we don't need atomic_clear() here (which is an
 	 * exchange operation that returns the old value).  We are always
@@ -104,10 +150,29 @@ static ALWAYS_INLINE void k_spin_release(struct k_spinlock *l)
 #ifdef SPIN_VALIDATE
 	__ASSERT(z_spin_unlock_valid(l), "Not my spinlock!");
 #endif
+#ifdef CONFIG_LOCK_STATS
+	z_lock_stats_released(&l->stats);
+#endif
 #ifdef CONFIG_SMP
 	atomic_clear(&l->locked);
 #endif
 }
 
+#ifdef CONFIG_SPIN_CONTENTION_COUNT
+/**
+ * @brief Number of contended acquisitions of a spinlock
+ *
+ * Returns how many times k_spin_lock() found the lock already held
+ * and had to spin.  The value is read without taking the lock and so
+ * is only a snapshot.
+ *
+ * @param l A pointer to the spinlock
+ * @return Contended acquisition count
+ */
+static inline u32_t k_spin_contention_count(struct k_spinlock *l)
+{
+	return l->contended;
+}
+#endif
 
 #endif /* ZEPHYR_INCLUDE_SPINLOCK_H_ */
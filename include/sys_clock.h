@@ -209,7 +209,16 @@ typedef void (*_timeout_func_t)(struct _timeout *t);
 
 struct _timeout {
 	sys_dnode_t node;
+#ifdef CONFIG_TIMEOUT_WHEEL
+	/* low 32 bits of the absolute expiry tick */
+	u32_t expiry;
+#else
 	s32_t dticks;
+#endif
+#ifdef CONFIG_TIMEOUT_SLACK
+	/* ticks the expiry may be deferred to share a wakeup */
+	s32_t slack;
+#endif
 	_timeout_func_t fn;
 };
 
@@ -113,6 +113,22 @@ extern "C" {
 typedef u32_t (*_k_syscall_handler_t)(u32_t arg1, u32_t arg2, u32_t arg3,
 				      u32_t arg4, u32_t arg5, u32_t arg6,
 				      void *ssf);
+
+/**
+ * @brief System call operation for k_syscall_batch()
+ *
+ * Set up with the k_syscall_op_<name>() helper generated for system
+ * call <name>.
+ */
+struct k_syscall_op {
+	/** System call ID, one of K_SYSCALL_* defines */
+	u32_t id;
+	/** Arguments, marshalled as for a single system call */
+	u32_t arg[6];
+	/** Return value of the system call, once made */
+	u32_t ret;
+};
+
 #ifdef CONFIG_USERSPACE
 
 /**
@@ -121,6 +121,12 @@ void z_sys_trace_thread_switched_out(void);
  */
 #define sys_trace_end_call(id)
 
+/**
+ * @brief Emit accumulated statistics for one lock site
+ * @param site Lock statistics entry, see debug/lock_stats.h
+ */
+#define sys_trace_lock_stats(site)
+
 
 #define z_sys_trace_idle()
 
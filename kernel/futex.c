@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file @brief Futex kernel services
+ *
+ * A futex is just a word in memory of the calling threads, the kernel
+ * holds no per-futex state.  Sleeping threads are pended on one of a
+ * small set of wait queues chosen by hashing the futex address, and
+ * remember the futex they wait for in swap_data so that a wakeup only
+ * picks threads waiting on that futex.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <ksched.h>
+#include <wait_q.h>
+#include <init.h>
+#include <errno.h>
+#include <syscall_handler.h>
+
+#define NUM_BUCKETS 16
+
+static struct k_spinlock lock;
+static _wait_q_t buckets[NUM_BUCKETS];
+
+static int init_futex_module(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	for (int i = 0; i < NUM_BUCKETS; i++) {
+		_waitq_init(&buckets[i]);
+	}
+	return 0;
+}
+
+SYS_INIT(init_futex_module, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+
+static _wait_q_t *futex_bucket(struct k_futex *futex)
+{
+	return &buckets[((uintptr_t)futex / sizeof(atomic_t)) % NUM_BUCKETS];
+}
+
+static struct k_thread *first_waiter(struct k_futex *futex)
+{
+	struct k_thread *thread;
+
+	_WAIT_Q_FOR_EACH(futex_bucket(futex), thread) {
+		if (thread->base.swap_data == futex) {
+			return thread;
+		}
+	}
+
+	return NULL;
+}
+
+int _impl_k_futex_wait(struct k_futex *futex, int expected, s32_t timeout)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int ret;
+
+	if (atomic_get(&futex->val) != (atomic_val_t)expected) {
+		k_spin_unlock(&lock, key);
+		return -EAGAIN;
+	}
+
+	if (timeout == K_NO_WAIT) {
+		k_spin_unlock(&lock, key);
+		return -ETIMEDOUT;
+	}
+
+	_current->base.swap_data = futex;
+	ret = _pend_curr(&lock, key, futex_bucket(futex), timeout);
+
+	return (ret == -EAGAIN) ? -ETIMEDOUT : ret;
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_futex_wait, futex, expected, timeout)
+{
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(futex, sizeof(struct k_futex)));
+	return _impl_k_futex_wait((struct k_futex *)futex, expected, timeout);
+}
+#endif
+
+static int wake(struct k_futex *futex, bool wake_all)
+{
+	struct k_thread *thread;
+	int woken = 0;
+
+	do {
+		thread = first_waiter(futex);
+		if (thread == NULL) {
+			break;
+		}
+
+		_unpend_thread(thread);
+		_ready_thread(thread);
+		_set_thread_return_value(thread, 0);
+		woken++;
+	} while (wake_all);
+
+	return woken;
+}
+
+int _futex_wake_no_resched(struct k_futex *futex, bool wake_all)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int woken = wake(futex, wake_all);
+
+	k_spin_unlock(&lock, key);
+
+	return woken;
+}
+
+int _impl_k_futex_wake(struct k_futex *futex, bool wake_all)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int woken = wake(futex, wake_all);
+
+	_reschedule(&lock, key);
+
+	return woken;
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_futex_wake, futex, wake_all)
+{
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(futex, sizeof(struct k_futex)));
+	return _impl_k_futex_wake((struct k_futex *)futex, wake_all != 0);
+}
+#endif
@@ -107,6 +107,17 @@ struct _cpu {
 	/* True when _current is allowed to context switch */
 	u8_t swap_ok;
 #endif
+
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* number of threads this CPU has stolen from other ready queues */
+	u32_t runq_steals;
+
+	/* protects ready_q, taken instead of the global scheduler lock */
+	struct k_spinlock runq_lock;
+
+	/* threads whose home is this CPU */
+	struct _ready_q ready_q;
+#endif
 };
 
 typedef struct _cpu _cpu_t;
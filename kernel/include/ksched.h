@@ -48,6 +48,9 @@ struct k_thread *_unpend_first_thread(_wait_q_t *wait_q);
 void _unpend_thread(struct k_thread *thread);
 int _unpend_all(_wait_q_t *wait_q);
 void _thread_priority_set(struct k_thread *thread, int prio);
+#if CONFIG_PRIORITY_INHERITANCE_DEPTH > 1
+void _mutex_waiter_priority_set(struct k_thread *thread, int prio);
+#endif
 void *_get_next_switch_handle(void *interrupted);
 struct k_thread *_find_first_thread_to_unpend(_wait_q_t *wait_q,
 					      struct k_thread *from);
@@ -236,6 +239,11 @@ static ALWAYS_INLINE void _ready_thread(struct k_thread *thread)
 	sys_trace_thread_ready(thread);
 }
 
+/* Like k_futex_wake(), but leaves the woken threads to the next
+ * reschedule point, for callers that must not be switched out yet
+ */
+int _futex_wake_no_resched(struct k_futex *futex, bool wake_all);
+
 static inline void _ready_one_thread(_wait_q_t *wq)
 {
 	struct k_thread *th = _unpend_first_thread(wq);
@@ -274,7 +282,7 @@ static ALWAYS_INLINE void _sched_unlock_no_reschedule(void)
 
 static ALWAYS_INLINE bool _is_thread_timeout_expired(struct k_thread *thread)
 {
-#ifdef CONFIG_SYS_CLOCK_EXISTS
+#if defined(CONFIG_SYS_CLOCK_EXISTS) && !defined(CONFIG_TIMEOUT_WHEEL)
 	return thread->base.timeout.dticks == _EXPIRED;
 #else
 	return 0;
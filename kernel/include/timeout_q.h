@@ -23,6 +23,9 @@ extern "C" {
 static inline void _init_timeout(struct _timeout *t, _timeout_func_t fn)
 {
 	sys_dnode_init(&t->node);
+#ifdef CONFIG_TIMEOUT_SLACK
+	t->slack = 0;
+#endif
 }
 
 void _add_timeout(struct _timeout *to, _timeout_func_t fn, s32_t ticks);
@@ -13,12 +13,11 @@
 #include <misc/dlist.h>
 #include <ksched.h>
 #include <init.h>
+#include <string.h>
 
 extern struct k_mem_slab _k_mem_slab_list_start[];
 extern struct k_mem_slab _k_mem_slab_list_end[];
 
-static struct k_spinlock lock;
-
 #ifdef CONFIG_OBJECT_TRACING
 struct k_mem_slab *_trace_list_k_mem_slab;
 #endif	/* CONFIG_OBJECT_TRACING */
@@ -83,6 +82,11 @@ void k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->block_size = block_size;
 	slab->buffer = buffer;
 	slab->num_used = 0;
+	slab->lock = (struct k_spinlock) {};
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	atomic_clear(&slab->mag_waiters);
+	(void)memset(slab->mag, 0, sizeof(slab->mag));
+#endif
 	create_free_list(slab);
 	_waitq_init(&slab->wait_q);
 	SYS_TRACING_OBJ_INIT(k_mem_slab, slab);
@@ -90,9 +94,199 @@ void k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	_k_object_init(slab);
 }
 
-int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+
+#define MAG_SIZE CONFIG_MEM_SLAB_MAGAZINE_SIZE
+
+static void slab_free(struct k_mem_slab *slab, void *block);
+
+static inline struct _mem_slab_magazine *local_mag(struct k_mem_slab *slab)
+{
+	/* A migration between reading the CPU id and taking the
+	 * magazine lock only costs locality, not correctness.
+	 */
+	return &slab->mag[_current_cpu->id];
+}
+
+static inline void mag_swap(struct _mem_slab_magazine *mag)
 {
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	char *list = mag->loaded;
+	u8_t count = mag->loaded_count;
+
+	mag->loaded = mag->previous;
+	mag->loaded_count = mag->previous_count;
+	mag->previous = list;
+	mag->previous_count = count;
+}
+
+/* Fill the (empty) loaded magazine from the slab free list.
+ * Called with the magazine lock held.
+ */
+static void mag_refill(struct k_mem_slab *slab,
+		       struct _mem_slab_magazine *mag)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+
+	while (mag->loaded_count < MAG_SIZE && slab->free_list != NULL) {
+		char *block = slab->free_list;
+
+		slab->free_list = *(char **)block;
+		*(char **)block = mag->loaded;
+		mag->loaded = block;
+		mag->loaded_count++;
+		slab->num_used++;
+	}
+
+	k_spin_unlock(&slab->lock, key);
+}
+
+/* Return the whole previous magazine to the slab free list.  Called
+ * with the magazine lock held and no allocator waiting.
+ */
+static void mag_flush_previous(struct k_mem_slab *slab,
+			       struct _mem_slab_magazine *mag)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+
+	while (mag->previous != NULL) {
+		char *block = mag->previous;
+
+		mag->previous = *(char **)block;
+		*(char **)block = slab->free_list;
+		slab->free_list = block;
+		slab->num_used--;
+	}
+	mag->previous_count = 0U;
+
+	k_spin_unlock(&slab->lock, key);
+}
+
+static bool mag_alloc(struct k_mem_slab *slab, void **mem)
+{
+	struct _mem_slab_magazine *mag = local_mag(slab);
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+
+	if (mag->loaded_count == 0U) {
+		if (mag->previous_count != 0U) {
+			mag_swap(mag);
+			mag->hits++;
+		} else {
+			mag_refill(slab, mag);
+			mag->misses++;
+		}
+	} else {
+		mag->hits++;
+	}
+
+	if (mag->loaded_count == 0U) {
+		k_spin_unlock(&mag->lock, key);
+		return false;
+	}
+
+	*mem = mag->loaded;
+	mag->loaded = *(char **)mag->loaded;
+	mag->loaded_count--;
+
+	k_spin_unlock(&mag->lock, key);
+	return true;
+}
+
+static bool mag_free(struct k_mem_slab *slab, void *block)
+{
+	struct _mem_slab_magazine *mag = local_mag(slab);
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+
+	/* Checked under the magazine lock: a thread entering the slow
+	 * path raises mag_waiters before draining this magazine, so
+	 * either it sees our block or we see its flag.
+	 */
+	if (atomic_get(&slab->mag_waiters) != 0) {
+		k_spin_unlock(&mag->lock, key);
+		return false;
+	}
+
+	if (mag->loaded_count == MAG_SIZE) {
+		if (mag->previous_count == MAG_SIZE) {
+			mag_flush_previous(slab, mag);
+			mag->misses++;
+		} else {
+			mag->hits++;
+		}
+		mag_swap(mag);
+	} else {
+		mag->hits++;
+	}
+
+	*(char **)block = mag->loaded;
+	mag->loaded = block;
+	mag->loaded_count++;
+
+	k_spin_unlock(&mag->lock, key);
+	return true;
+}
+
+/* Hand every cached block back to the slab, waking waiters as
+ * blocks become available.  The magazine locks are never held
+ * together with the slab lock taken by slab_free(), keeping the
+ * magazine-then-slab lock order intact.
+ */
+static void mag_drain_all(struct k_mem_slab *slab)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct _mem_slab_magazine *mag = &slab->mag[i];
+		k_spinlock_key_t key = k_spin_lock(&mag->lock);
+		char *list = mag->loaded;
+		char *prev = mag->previous;
+
+		mag->loaded = NULL;
+		mag->previous = NULL;
+		mag->loaded_count = 0U;
+		mag->previous_count = 0U;
+		k_spin_unlock(&mag->lock, key);
+
+		while (list != NULL || prev != NULL) {
+			char *block;
+
+			if (list == NULL) {
+				list = prev;
+				prev = NULL;
+			}
+			block = list;
+			list = *(char **)block;
+			slab_free(slab, block);
+		}
+	}
+}
+
+u32_t z_mem_slab_num_cached(struct k_mem_slab *slab)
+{
+	u32_t cached = 0U;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cached += slab->mag[i].loaded_count +
+			  slab->mag[i].previous_count;
+	}
+
+	return cached;
+}
+
+void k_mem_slab_cache_stats_get(struct k_mem_slab *slab,
+				struct k_mem_slab_cache_stats *stats)
+{
+	stats->hits = 0U;
+	stats->misses = 0U;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		stats->hits += slab->mag[i].hits;
+		stats->misses += slab->mag[i].misses;
+	}
+}
+
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
+
+static int slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 	int result;
 
 	/* block size must be word aligned */
@@ -111,31 +305,65 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
 		result = -ENOMEM;
 	} else {
 		/* wait for a free block or timeout */
-		result = _pend_curr(&lock, key, &slab->wait_q, timeout);
+		result = _pend_curr(&slab->lock, key, &slab->wait_q, timeout);
 		if (result == 0) {
 			*mem = _current->base.swap_data;
 		}
 		return result;
 	}
 
-	k_spin_unlock(&lock, key);
+	k_spin_unlock(&slab->lock, key);
 
 	return result;
 }
 
-void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
+{
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	int result;
+
+	if (mag_alloc(slab, mem)) {
+		return 0;
+	}
+
+	/* The free list is empty but other CPUs may still cache
+	 * blocks.  Stop frees from refilling the magazines and pull
+	 * everything back before failing or pending.
+	 */
+	atomic_inc(&slab->mag_waiters);
+	mag_drain_all(slab);
+	result = slab_alloc(slab, mem, timeout);
+	atomic_dec(&slab->mag_waiters);
+
+	return result;
+#else
+	return slab_alloc(slab, mem, timeout);
+#endif
+}
+
+static void slab_free(struct k_mem_slab *slab, void *block)
 {
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 	struct k_thread *pending_thread = _unpend_first_thread(&slab->wait_q);
 
 	if (pending_thread != NULL) {
-		_set_thread_return_value_with_data(pending_thread, 0, *mem);
+		_set_thread_return_value_with_data(pending_thread, 0, block);
 		_ready_thread(pending_thread);
-		_reschedule(&lock, key);
+		_reschedule(&slab->lock, key);
 	} else {
-		**(char ***)mem = slab->free_list;
-		slab->free_list = *(char **)mem;
+		*(char **)block = slab->free_list;
+		slab->free_list = block;
 		slab->num_used--;
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(&slab->lock, key);
+	}
+}
+
+void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
+{
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	if (mag_free(slab, *mem)) {
+		return;
 	}
+#endif
+	slab_free(slab, *mem);
 }
@@ -11,6 +11,10 @@
 #include <string.h>
 #include <misc/__assert.h>
 #include <stdbool.h>
+#include <misc/mem_stats.h>
+#ifdef CONFIG_HEAP_MEM_POOL_TLSF
+#include <misc/tlsf.h>
+#endif
 
 /* Linker-defined symbols bound the static pool structs */
 extern struct k_mem_pool _k_mem_pool_list_start[];
@@ -136,7 +140,8 @@ void k_mem_pool_free(struct k_mem_block *block)
 	k_mem_pool_free_id(&block->id);
 }
 
-void *k_mem_pool_malloc(struct k_mem_pool *pool, size_t size)
+/* Allocates a block with room for the hidden block descriptor */
+static void *pool_malloc(struct k_mem_pool *pool, size_t size)
 {
 	struct k_mem_block block;
 
@@ -159,17 +164,6 @@ void *k_mem_pool_malloc(struct k_mem_pool *pool, size_t size)
 	return (char *)block.data + sizeof(struct k_mem_block_id);
 }
 
-void k_free(void *ptr)
-{
-	if (ptr != NULL) {
-		/* point to hidden block descriptor at start of block */
-		ptr = (char *)ptr - sizeof(struct k_mem_block_id);
-
-		/* return block to the heap memory pool */
-		k_mem_pool_free_id(ptr);
-	}
-}
-
 #if (CONFIG_HEAP_MEM_POOL_SIZE > 0)
 
 /*
@@ -179,12 +173,130 @@ void k_free(void *ptr)
  * that has the address of the associated memory pool struct.
  */
 
+#ifdef CONFIG_HEAP_MEM_POOL_TLSF
+#define HEAP_TLSF 1
+
+BUILD_ASSERT_MSG(CONFIG_HEAP_MEM_POOL_SIZE <
+		 (1 << CONFIG_SYS_TLSF_MAX_BLOCK_LOG2),
+		 "HEAP_MEM_POOL_SIZE too large, raise SYS_TLSF_MAX_BLOCK_LOG2");
+
+static char __aligned(sizeof(void *)) heap_mem[CONFIG_HEAP_MEM_POOL_SIZE];
+static struct sys_tlsf heap;
+static struct k_spinlock heap_lock;
+
+/* Threads assigned the system heap get this marker as their resource
+ * pool and z_malloc() redirects them to the TLSF heap.  It is only
+ * ever compared, never dereferenced as a k_mem_pool.
+ */
+#define _HEAP_MEM_POOL ((struct k_mem_pool *)&heap)
+
+static int init_heap(struct device *unused)
+{
+	ARG_UNUSED(unused);
+
+	sys_tlsf_init(&heap, heap_mem, sizeof(heap_mem));
+	return 0;
+}
+
+SYS_INIT(init_heap, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+#else
 K_MEM_POOL_DEFINE(_heap_mem_pool, 64, CONFIG_HEAP_MEM_POOL_SIZE, 1, 4);
 #define _HEAP_MEM_POOL (&_heap_mem_pool)
+#endif
+
+#endif /* CONFIG_HEAP_MEM_POOL_SIZE > 0 */
+
+#if defined(CONFIG_SYS_MEM_STATS) && (CONFIG_SYS_MEM_STATS_SITES > 0)
+#define MALLOC_SITES 1
+#define MALLOC_CALLER() __builtin_return_address(0)
+
+/* Call sites of everything that is released with k_free() */
+static struct _sys_mem_sites malloc_sites;
+static struct k_spinlock sites_lock;
+#else
+#define MALLOC_CALLER() NULL
+#endif
+
+/* Common path of all allocations that are released with k_free() */
+static void *z_malloc(struct k_mem_pool *pool, size_t size, const void *site)
+{
+	void *ret;
+
+#ifdef MALLOC_SITES
+	size_t requested = size;
+
+	if (__builtin_add_overflow(size, _SYS_MEM_SITES_HDR_SIZE, &size)) {
+		return NULL;
+	}
+#else
+	ARG_UNUSED(site);
+#endif
+
+#ifdef HEAP_TLSF
+	if (pool == _HEAP_MEM_POOL) {
+		k_spinlock_key_t key = k_spin_lock(&heap_lock);
+
+		ret = sys_tlsf_alloc(&heap, size);
+		k_spin_unlock(&heap_lock, key);
+	} else {
+		ret = pool_malloc(pool, size);
+	}
+#else
+	ret = pool_malloc(pool, size);
+#endif
+
+#ifdef MALLOC_SITES
+	if (ret != NULL) {
+		k_spinlock_key_t key = k_spin_lock(&sites_lock);
+
+		ret = _sys_mem_sites_track(&malloc_sites, ret, requested, site);
+		k_spin_unlock(&sites_lock, key);
+	}
+#endif
+
+	return ret;
+}
+
+void *k_mem_pool_malloc(struct k_mem_pool *pool, size_t size)
+{
+	return z_malloc(pool, size, MALLOC_CALLER());
+}
+
+void k_free(void *ptr)
+{
+	if (ptr == NULL) {
+		return;
+	}
+
+#ifdef MALLOC_SITES
+	k_spinlock_key_t key = k_spin_lock(&sites_lock);
+
+	ptr = _sys_mem_sites_untrack(&malloc_sites, ptr);
+	k_spin_unlock(&sites_lock, key);
+#endif
+
+#ifdef HEAP_TLSF
+	if (sys_tlsf_owns(&heap, ptr)) {
+		k_spinlock_key_t heap_key = k_spin_lock(&heap_lock);
+
+		sys_tlsf_free(&heap, ptr);
+		k_spin_unlock(&heap_lock, heap_key);
+		return;
+	}
+#endif
+
+	/* point to hidden block descriptor at start of block */
+	ptr = (char *)ptr - sizeof(struct k_mem_block_id);
+
+	/* return block to the heap memory pool */
+	k_mem_pool_free_id(ptr);
+}
+
+#if (CONFIG_HEAP_MEM_POOL_SIZE > 0)
 
 void *k_malloc(size_t size)
 {
-	return k_mem_pool_malloc(_HEAP_MEM_POOL, size);
+	return z_malloc(_HEAP_MEM_POOL, size, MALLOC_CALLER());
 }
 
 void *k_calloc(size_t nmemb, size_t size)
@@ -196,7 +308,7 @@ void *k_calloc(size_t nmemb, size_t size)
 		return NULL;
 	}
 
-	ret = k_malloc(bounds);
+	ret = z_malloc(_HEAP_MEM_POOL, bounds, MALLOC_CALLER());
 	if (ret != NULL) {
 		(void)memset(ret, 0, bounds);
 	}
@@ -214,10 +326,53 @@ void *z_thread_malloc(size_t size)
 	void *ret;
 
 	if (_current->resource_pool != NULL) {
-		ret = k_mem_pool_malloc(_current->resource_pool, size);
+		ret = z_malloc(_current->resource_pool, size, MALLOC_CALLER());
 	} else {
 		ret = NULL;
 	}
 
 	return ret;
 }
+
+#ifdef CONFIG_SYS_MEM_STATS
+void k_mem_pool_stats_get(struct k_mem_pool *pool,
+			  struct sys_mem_stats *stats)
+{
+	_sys_mem_pool_base_stats(&pool->base, stats);
+}
+
+int k_malloc_stats_get(struct sys_mem_stats *stats)
+{
+#ifdef HEAP_TLSF
+	k_spinlock_key_t key = k_spin_lock(&heap_lock);
+
+	sys_tlsf_stats_get(&heap, stats);
+	k_spin_unlock(&heap_lock, key);
+	return 0;
+#elif (CONFIG_HEAP_MEM_POOL_SIZE > 0)
+	k_mem_pool_stats_get(_HEAP_MEM_POOL, stats);
+	return 0;
+#else
+	ARG_UNUSED(stats);
+	return -ENOTSUP;
+#endif
+}
+
+#ifdef MALLOC_SITES
+void k_malloc_sites_foreach(sys_mem_site_cb_t cb, void *user_data)
+{
+	struct sys_mem_site copy;
+	k_spinlock_key_t key;
+
+	for (int i = 0; i < CONFIG_SYS_MEM_STATS_SITES; i++) {
+		key = k_spin_lock(&sites_lock);
+		copy = malloc_sites.sites[i];
+		k_spin_unlock(&sites_lock, key);
+
+		if (copy.site != NULL) {
+			cb(&copy, user_data);
+		}
+	}
+}
+#endif
+#endif /* CONFIG_SYS_MEM_STATS */
@@ -166,6 +166,122 @@ Z_SYSCALL_HANDLER(k_msgq_put, msgq_p, data, timeout)
 }
 #endif
 
+/* Copy num_msgs messages into the ring buffer, which has room for them */
+static void ring_put(struct k_msgq *q, const char *data, u32_t num_msgs)
+{
+	while (num_msgs > 0) {
+		u32_t room = (q->buffer_end - q->write_ptr) / q->msg_size;
+		u32_t n = MIN(num_msgs, room);
+		size_t bytes = n * q->msg_size;
+
+		(void)memcpy(q->write_ptr, data, bytes);
+		data += bytes;
+		q->write_ptr += bytes;
+		if (q->write_ptr == q->buffer_end) {
+			q->write_ptr = q->buffer_start;
+		}
+		q->used_msgs += n;
+		num_msgs -= n;
+	}
+}
+
+/* Copy num_msgs messages out of the ring buffer, which holds as many */
+static void ring_get(struct k_msgq *q, char *data, u32_t num_msgs)
+{
+	while (num_msgs > 0) {
+		u32_t avail = (q->buffer_end - q->read_ptr) / q->msg_size;
+		u32_t n = MIN(num_msgs, avail);
+		size_t bytes = n * q->msg_size;
+
+		(void)memcpy(data, q->read_ptr, bytes);
+		data += bytes;
+		q->read_ptr += bytes;
+		if (q->read_ptr == q->buffer_end) {
+			q->read_ptr = q->buffer_start;
+		}
+		q->used_msgs -= n;
+		num_msgs -= n;
+	}
+}
+
+int _impl_k_msgq_put_many(struct k_msgq *q, const void *data,
+			  u32_t num_msgs, s32_t timeout)
+{
+	__ASSERT(!_is_in_isr() || timeout == K_NO_WAIT, "");
+
+	k_spinlock_key_t key = k_spin_lock(&q->lock);
+	const char *src = data;
+	struct k_thread *pending_thread;
+	bool woken = false;
+	u32_t sent = 0;
+	u32_t n;
+	int ret;
+
+	if (num_msgs == 0) {
+		k_spin_unlock(&q->lock, key);
+		return 0;
+	}
+
+	/* readers only wait while the queue is empty: hand them messages
+	 * directly, then buffer the rest
+	 */
+	while (sent < num_msgs && q->used_msgs == 0) {
+		pending_thread = _unpend_first_thread(&q->wait_q);
+		if (pending_thread == NULL) {
+			break;
+		}
+		(void)memcpy(pending_thread->base.swap_data, src, q->msg_size);
+		_set_thread_return_value(pending_thread, 0);
+		_ready_thread(pending_thread);
+		src += q->msg_size;
+		sent++;
+		woken = true;
+	}
+
+	n = MIN(num_msgs - sent, q->max_msgs - q->used_msgs);
+	ring_put(q, src, n);
+	sent += n;
+
+	if (sent > 0) {
+		if (woken) {
+			_reschedule(&q->lock, key);
+		} else {
+			k_spin_unlock(&q->lock, key);
+		}
+		return sent;
+	}
+
+	if (timeout == K_NO_WAIT) {
+		k_spin_unlock(&q->lock, key);
+		return -ENOMSG;
+	}
+
+	/* queue is full: wait until the first message is taken */
+	_current->base.swap_data = (void *)src;
+	ret = _pend_curr(&q->lock, key, &q->wait_q, timeout);
+	if (ret != 0) {
+		return ret;
+	}
+
+	/* then send whatever else fits without waiting again */
+	ret = _impl_k_msgq_put_many(q, src + q->msg_size, num_msgs - 1,
+				    K_NO_WAIT);
+
+	return (ret > 0) ? ret + 1 : 1;
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_msgq_put_many, msgq_p, data, num_msgs, timeout)
+{
+	struct k_msgq *q = (struct k_msgq *)msgq_p;
+
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_READ(data, num_msgs, q->msg_size));
+
+	return _impl_k_msgq_put_many(q, (const void *)data, num_msgs, timeout);
+}
+#endif
+
 void _impl_k_msgq_get_attrs(struct k_msgq *q, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = q->msg_size;
@@ -247,6 +363,77 @@ Z_SYSCALL_HANDLER(k_msgq_get, msgq_p, data, timeout)
 }
 #endif
 
+int _impl_k_msgq_get_many(struct k_msgq *q, void *data, u32_t num_msgs,
+			  s32_t timeout)
+{
+	__ASSERT(!_is_in_isr() || timeout == K_NO_WAIT, "");
+
+	k_spinlock_key_t key = k_spin_lock(&q->lock);
+	struct k_thread *pending_thread;
+	bool woken = false;
+	u32_t n;
+	int ret;
+
+	if (num_msgs == 0) {
+		k_spin_unlock(&q->lock, key);
+		return 0;
+	}
+
+	if (q->used_msgs > 0) {
+		n = MIN(num_msgs, q->used_msgs);
+		ring_get(q, data, n);
+
+		/* refill the freed slots from threads waiting to write */
+		while (q->used_msgs < q->max_msgs) {
+			pending_thread = _unpend_first_thread(&q->wait_q);
+			if (pending_thread == NULL) {
+				break;
+			}
+			ring_put(q, pending_thread->base.swap_data, 1);
+			_set_thread_return_value(pending_thread, 0);
+			_ready_thread(pending_thread);
+			woken = true;
+		}
+
+		if (woken) {
+			_reschedule(&q->lock, key);
+		} else {
+			k_spin_unlock(&q->lock, key);
+		}
+		return n;
+	}
+
+	if (timeout == K_NO_WAIT) {
+		k_spin_unlock(&q->lock, key);
+		return -ENOMSG;
+	}
+
+	/* queue is empty: wait for the first message */
+	_current->base.swap_data = data;
+	ret = _pend_curr(&q->lock, key, &q->wait_q, timeout);
+	if (ret != 0) {
+		return ret;
+	}
+
+	/* then take whatever else arrived meanwhile */
+	ret = _impl_k_msgq_get_many(q, (char *)data + q->msg_size,
+				    num_msgs - 1, K_NO_WAIT);
+
+	return (ret > 0) ? ret + 1 : 1;
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_msgq_get_many, msgq_p, data, num_msgs, timeout)
+{
+	struct k_msgq *q = (struct k_msgq *)msgq_p;
+
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(data, num_msgs, q->msg_size));
+
+	return _impl_k_msgq_get_many(q, (void *)data, num_msgs, timeout);
+}
+#endif
+
 int _impl_k_msgq_peek(struct k_msgq *q, void *data)
 {
 	k_spinlock_key_t key = k_spin_lock(&q->lock);
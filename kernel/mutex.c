@@ -11,7 +11,9 @@
  *
  * Mutexes implement a priority inheritance algorithm that boosts the priority
  * level of the owning thread to match the priority level of the highest
- * priority thread waiting on the mutex.
+ * priority thread waiting on the mutex.  When the owner is itself waiting
+ * on another mutex, the boost is passed on to that mutex's owner, and so on
+ * down the chain for up to CONFIG_PRIORITY_INHERITANCE_DEPTH owners.
  *
  * Each mutex that contributes to priority inheritance must be released in the
  * reverse order in which it was acquired.  Furthermore each subsequent mutex
@@ -79,6 +81,9 @@ void _impl_k_mutex_init(struct k_mutex *mutex)
 {
 	mutex->owner = NULL;
 	mutex->lock_count = 0;
+#ifdef CONFIG_LOCK_STATS
+	mutex->stats.site = NULL;
+#endif
 
 	sys_trace_void(SYS_TRACE_ID_MUTEX_INIT);
 
@@ -117,7 +122,41 @@ static void adjust_owner_prio(struct k_mutex *mutex, s32_t new_prio)
 			'y' : 'n',
 			new_prio, mutex->owner->base.prio);
 
+#if CONFIG_PRIORITY_INHERITANCE_DEPTH > 1
+		/* An owner waiting on another mutex must keep its place
+		 * in that mutex's wait queue
+		 */
+		_mutex_waiter_priority_set(mutex->owner, new_prio);
+#else
 		_thread_priority_set(mutex->owner, new_prio);
+#endif
+	}
+}
+
+/* Boost the owner of mutex to prio, then the owner of the mutex it is
+ * pended on, and so on.  The walk stops at the first owner already at
+ * that priority, since everything past it was boosted along with it.
+ */
+static void inherit_prio(struct k_mutex *mutex, s32_t prio)
+{
+	for (int depth = 0; depth < CONFIG_PRIORITY_INHERITANCE_DEPTH; depth++) {
+		struct k_thread *owner = mutex->owner;
+		s32_t new_prio = new_prio_for_inheritance(prio,
+							  owner->base.prio);
+
+		if (!_is_prio_higher(new_prio, owner->base.prio)) {
+			break;
+		}
+
+		adjust_owner_prio(mutex, new_prio);
+
+#if CONFIG_PRIORITY_INHERITANCE_DEPTH > 1
+		mutex = owner->base.pended_mutex;
+		if (mutex == NULL || mutex->owner == NULL) {
+			break;
+		}
+		prio = new_prio;
+#endif
 	}
 }
 
@@ -125,6 +164,10 @@ int _impl_k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 {
 	int new_prio;
 	k_spinlock_key_t key;
+#ifdef CONFIG_LOCK_STATS
+	const void *site = __builtin_return_address(0);
+	u32_t start;
+#endif
 
 	sys_trace_void(SYS_TRACE_ID_MUTEX_LOCK);
 	_sched_lock();
@@ -133,6 +176,14 @@ int _impl_k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 
 		RECORD_STATE_CHANGE();
 
+#ifdef CONFIG_LOCK_STATS
+		if (mutex->lock_count == 0U) {
+			z_lock_stats_acquired(&mutex->stats, site,
+					      LOCK_STATS_MUTEX,
+					      z_lock_stats_begin(), false);
+		}
+#endif
+
 		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
 					_current->base.prio :
 					mutex->owner_orig_prio;
@@ -158,16 +209,19 @@ int _impl_k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 		return -EBUSY;
 	}
 
-	new_prio = new_prio_for_inheritance(_current->base.prio,
-					    mutex->owner->base.prio);
+#ifdef CONFIG_LOCK_STATS
+	start = z_lock_stats_begin();
+#endif
 
 	key = k_spin_lock(&lock);
 
 	K_DEBUG("adjusting prio up on mutex %p\n", mutex);
 
-	if (_is_prio_higher(new_prio, mutex->owner->base.prio)) {
-		adjust_owner_prio(mutex, new_prio);
-	}
+	inherit_prio(mutex, _current->base.prio);
+
+#if CONFIG_PRIORITY_INHERITANCE_DEPTH > 1
+	_current->base.pended_mutex = mutex;
+#endif
 
 	int got_mutex = _pend_curr(&lock, key, &mutex->wait_q, timeout);
 
@@ -177,6 +231,10 @@ int _impl_k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 		got_mutex ? 'y' : 'n');
 
 	if (got_mutex == 0) {
+#ifdef CONFIG_LOCK_STATS
+		z_lock_stats_acquired(&mutex->stats, site, LOCK_STATS_MUTEX,
+				      start, true);
+#endif
 		k_sched_unlock();
 		sys_trace_end_call(SYS_TRACE_ID_MUTEX_LOCK);
 		return 0;
@@ -196,6 +254,9 @@ int _impl_k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 	K_DEBUG("adjusting prio down on mutex %p\n", mutex);
 
 	key = k_spin_lock(&lock);
+#if CONFIG_PRIORITY_INHERITANCE_DEPTH > 1
+	_current->base.pended_mutex = NULL;
+#endif
 	adjust_owner_prio(mutex, new_prio);
 	k_spin_unlock(&lock, key);
 
@@ -233,6 +294,11 @@ void _impl_k_mutex_unlock(struct k_mutex *mutex)
 		goto k_mutex_unlock_return;
 	}
 
+#ifdef CONFIG_LOCK_STATS
+	/* Before the hand-off, so the next owner's hold is not clobbered */
+	z_lock_stats_released(&mutex->stats);
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
 	adjust_owner_prio(mutex, mutex->owner_orig_prio);
@@ -245,6 +311,9 @@ void _impl_k_mutex_unlock(struct k_mutex *mutex)
 		mutex, new_owner, new_owner ? new_owner->base.prio : -1000);
 
 	if (new_owner != NULL) {
+#if CONFIG_PRIORITY_INHERITANCE_DEPTH > 1
+		new_owner->base.pended_mutex = NULL;
+#endif
 		_ready_thread(new_owner);
 
 		k_spin_unlock(&lock, key);
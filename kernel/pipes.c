@@ -21,6 +21,7 @@
 #include <syscall_handler.h>
 #include <misc/__assert.h>
 #include <kernel_internal.h>
+#include <string.h>
 
 struct k_pipe_desc {
 	unsigned char *buffer;           /* Position in src/dest buffer */
@@ -198,13 +199,8 @@ static size_t pipe_xfer(unsigned char *dest, size_t dest_size,
 			 const unsigned char *src, size_t src_size)
 {
 	size_t num_bytes = MIN(dest_size, src_size);
-	const unsigned char *end = src + num_bytes;
 
-	while (src != end) {
-		*dest = *src;
-		dest++;
-		src++;
-	}
+	(void)memcpy(dest, src, num_bytes);
 
 	return num_bytes;
 }
@@ -781,3 +777,233 @@ void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 				    bytes_to_write, K_FOREVER);
 }
 #endif
+
+/**
+ * @brief Remaining part of @a timeout, which started at @a start
+ */
+static s32_t pipe_timeout_left(s32_t timeout, s64_t start)
+{
+	s64_t left;
+
+	if ((timeout == K_FOREVER) || (timeout == K_NO_WAIT)) {
+		return timeout;
+	}
+
+	left = start + timeout - k_uptime_get();
+
+	return (left > 0) ? (s32_t)left : K_NO_WAIT;
+}
+
+/**
+ * @brief Transfer to or from each of the buffers of @a iov in turn
+ *
+ * Every buffer must be transferred in full before moving on to the next
+ * one, until the remaining minimum fits in the current buffer.
+ */
+static int pipe_iov_xfer(struct k_pipe *pipe, const struct k_iovec *iov,
+			 size_t iovcnt, size_t *bytes_xferred,
+			 size_t min_xfer, s32_t timeout, bool put)
+{
+	s64_t start = k_uptime_get();
+	size_t num_bytes = 0;
+	size_t seg_bytes;
+	size_t seg_min;
+	int ret = 0;
+
+	__ASSERT(bytes_xferred != NULL, "");
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		seg_min = (num_bytes < min_xfer) ? min_xfer - num_bytes : 0;
+		seg_min = MIN(seg_min, iov[i].iov_len);
+
+		if (put) {
+			ret = _k_pipe_put_internal(pipe, NULL,
+					iov[i].iov_base, iov[i].iov_len,
+					&seg_bytes, seg_min,
+					pipe_timeout_left(timeout, start));
+		} else {
+			ret = _impl_k_pipe_get(pipe, iov[i].iov_base,
+					iov[i].iov_len, &seg_bytes, seg_min,
+					pipe_timeout_left(timeout, start));
+		}
+
+		num_bytes += seg_bytes;
+
+		if ((ret != 0) || (seg_bytes < iov[i].iov_len)) {
+			break;
+		}
+	}
+
+	*bytes_xferred = num_bytes;
+
+	if (num_bytes >= min_xfer) {
+		return 0;
+	}
+
+	/* Waiting may have run out before the last buffers were tried */
+	return (timeout == K_NO_WAIT) ? -EIO : -EAGAIN;
+}
+
+int k_pipe_put_iov(struct k_pipe *pipe, const struct k_iovec *iov,
+		   size_t iovcnt, size_t *bytes_written, size_t min_xfer,
+		   s32_t timeout)
+{
+	return pipe_iov_xfer(pipe, iov, iovcnt, bytes_written, min_xfer,
+			     timeout, true);
+}
+
+int k_pipe_get_iov(struct k_pipe *pipe, const struct k_iovec *iov,
+		   size_t iovcnt, size_t *bytes_read, size_t min_xfer,
+		   s32_t timeout)
+{
+	return pipe_iov_xfer(pipe, iov, iovcnt, bytes_read, min_xfer,
+			     timeout, false);
+}
+
+size_t k_pipe_put_claim(struct k_pipe *pipe, u8_t **data, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	size = MIN(size, MIN(pipe->size - pipe->bytes_used,
+			     pipe->size - pipe->write_index));
+	*data = pipe->buffer + pipe->write_index;
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return size;
+}
+
+int k_pipe_put_commit(struct k_pipe *pipe, size_t size)
+{
+	struct k_thread    *reader;
+	struct k_pipe_desc *desc;
+	sys_dlist_t    xfer_list;
+	size_t         bytes_copied;
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if (size > MIN(pipe->size - pipe->bytes_used,
+		       pipe->size - pipe->write_index)) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->bytes_used += size;
+	pipe->write_index += size;
+	if (pipe->write_index == pipe->size) {
+		pipe->write_index = 0;
+	}
+
+	/*
+	 * Readers only wait on an empty pipe: hand them the new data, as
+	 * _impl_k_pipe_get() hands the data of waiting writers.
+	 */
+	(void)pipe_xfer_prepare(&xfer_list, &reader, &pipe->wait_q.readers,
+				0, pipe->bytes_used, 0, K_FOREVER);
+
+	_sched_lock();
+	k_spin_unlock(&pipe->lock, key);
+
+	struct k_thread *thread = (struct k_thread *)
+				  sys_dlist_get(&xfer_list);
+	while (thread != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		/* The thread's read request has been satisfied. Ready it. */
+		_ready_thread(thread);
+
+		thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	}
+
+	if (reader != NULL) {
+		desc = (struct k_pipe_desc *)reader->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+	}
+
+	k_sched_unlock();
+
+	return 0;
+}
+
+size_t k_pipe_get_claim(struct k_pipe *pipe, u8_t **data, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	size = MIN(size, MIN(pipe->bytes_used,
+			     pipe->size - pipe->read_index));
+	*data = pipe->buffer + pipe->read_index;
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return size;
+}
+
+int k_pipe_get_commit(struct k_pipe *pipe, size_t size)
+{
+	struct k_thread    *writer;
+	struct k_pipe_desc *desc;
+	sys_dlist_t    xfer_list;
+	size_t         bytes_copied;
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if (size > MIN(pipe->bytes_used, pipe->size - pipe->read_index)) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->bytes_used -= size;
+	pipe->read_index += size;
+	if (pipe->read_index == pipe->size) {
+		pipe->read_index = 0;
+	}
+
+	/*
+	 * Writers only wait on a full pipe: move their data into the space
+	 * freed, as _impl_k_pipe_get() does.
+	 */
+	(void)pipe_xfer_prepare(&xfer_list, &writer, &pipe->wait_q.writers,
+				0, pipe->size - pipe->bytes_used, 0,
+				K_FOREVER);
+
+	_sched_lock();
+	k_spin_unlock(&pipe->lock, key);
+
+	struct k_thread *thread = (struct k_thread *)
+				  sys_dlist_get(&xfer_list);
+	while (thread != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		/* Write request has been satisfied */
+		pipe_thread_ready(thread);
+
+		thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	}
+
+	if (writer != NULL) {
+		desc = (struct k_pipe_desc *)writer->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+	}
+
+	k_sched_unlock();
+
+	return 0;
+}
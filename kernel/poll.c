@@ -89,16 +89,19 @@ static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 {
 	struct k_poll_event *pending;
 
+	/* Poll sets have no thread of their own: they come after threads */
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
-	if ((pending == NULL) ||
-		_is_t1_higher_prio_than_t2(pending->poller->thread,
-		poller->thread)) {
+	if ((pending == NULL) || poller->is_set ||
+		(!pending->poller->is_set &&
+		 _is_t1_higher_prio_than_t2(pending->poller->thread,
+		 poller->thread))) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (_is_t1_higher_prio_than_t2(poller->thread,
+		if (pending->poller->is_set ||
+		    _is_t1_higher_prio_than_t2(poller->thread,
 					       pending->poller->thread)) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
@@ -334,6 +337,22 @@ oops_free:
 }
 #endif
 
+/* must be called with interrupts locked */
+static void set_event_ready_in_set(struct k_poll_set *set,
+				   struct k_poll_event *event, u32_t state)
+{
+	struct k_thread *thread;
+
+	event->state = state;
+	sys_dlist_append(&set->ready, &event->_node);
+
+	thread = _unpend_first_thread(&set->wait_q);
+	if (thread != NULL) {
+		_set_thread_return_value(thread, 0);
+		_ready_thread(thread);
+	}
+}
+
 /* must be called with interrupts locked */
 static int signal_poll_event(struct k_poll_event *event, u32_t state)
 {
@@ -341,6 +360,13 @@ static int signal_poll_event(struct k_poll_event *event, u32_t state)
 		goto ready_event;
 	}
 
+	if (event->poller->is_set) {
+		set_event_ready_in_set(CONTAINER_OF(event->poller,
+						    struct k_poll_set, poller),
+				       event, state);
+		return 0;
+	}
+
 	struct k_thread *thread = event->poller->thread;
 
 	__ASSERT(event->poller->thread != NULL,
@@ -381,6 +407,131 @@ void _handle_obj_poll_events(sys_dlist_t *events, u32_t state)
 	}
 }
 
+void k_poll_set_init(struct k_poll_set *set, u32_t flags)
+{
+	set->poller.thread = NULL;
+	set->poller.is_polling = false;
+	set->poller.is_set = true;
+	sys_dlist_init(&set->ready);
+	_waitq_init(&set->wait_q);
+	set->flags = flags;
+}
+
+void k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	u32_t state;
+
+	sys_dnode_init(&event->_node);
+	event->poller = &set->poller;
+
+	if (is_condition_met(event, &state)) {
+		set_event_ready_in_set(set, event, state);
+	} else {
+		event->state = K_POLL_STATE_NOT_READY;
+		(void)register_event(event, &set->poller);
+	}
+
+	_reschedule(&lock, key);
+}
+
+void k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	__ASSERT(event->poller == &set->poller, "event not in set\n");
+
+	/* Either on its object's list or on the set's ready list */
+	if (sys_dnode_is_linked(&event->_node)) {
+		sys_dlist_remove(&event->_node);
+	}
+	event->poller = NULL;
+
+	k_spin_unlock(&lock, key);
+}
+
+/* must be called with interrupts locked */
+static int set_collect(struct k_poll_set *set, struct k_poll_event **ready,
+		       int max_events)
+{
+	bool edge = (set->flags & K_POLL_SET_EDGE_TRIGGERED) != 0U;
+	struct k_poll_event *event;
+	sys_dlist_t reported;
+	sys_dnode_t *node;
+	u32_t state;
+	int num_events = 0;
+
+	sys_dlist_init(&reported);
+
+	while (num_events < max_events) {
+		event = (struct k_poll_event *)sys_dlist_get(&set->ready);
+		if (event == NULL) {
+			break;
+		}
+
+		if (edge || (event->state == K_POLL_STATE_CANCELLED)) {
+			/* Rearm right away, so that nothing happening from
+			 * now on is missed.
+			 */
+			(void)register_event(event, &set->poller);
+		} else if (is_condition_met(event, &state)) {
+			event->state = state;
+			sys_dlist_append(&reported, &event->_node);
+		} else {
+			/* Consumed since it was signaled */
+			event->state = K_POLL_STATE_NOT_READY;
+			(void)register_event(event, &set->poller);
+			continue;
+		}
+
+		ready[num_events++] = event;
+	}
+
+	/* Level-triggered events stay ready until found not to be, behind
+	 * the ones not reported yet.
+	 */
+	while ((node = sys_dlist_get(&reported)) != NULL) {
+		sys_dlist_append(&set->ready, node);
+	}
+
+	return num_events;
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max_events, s32_t timeout)
+{
+	__ASSERT(!_is_in_isr(), "");
+	__ASSERT(max_events > 0, "zero events\n");
+
+	s64_t end = k_uptime_get() + timeout;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int num_events;
+
+	/* Another waiter may have collected the events it was woken for */
+	while ((num_events = set_collect(set, ready, max_events)) == 0) {
+		if (timeout == K_NO_WAIT) {
+			k_spin_unlock(&lock, key);
+			return -EAGAIN;
+		}
+
+		if (_pend_curr(&lock, key, &set->wait_q, timeout) != 0) {
+			return -EAGAIN;
+		}
+
+		if (timeout != K_FOREVER) {
+			s64_t left = end - k_uptime_get();
+
+			timeout = (left > 0) ? (s32_t)left : K_NO_WAIT;
+		}
+
+		key = k_spin_lock(&lock);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return num_events;
+}
+
 void _impl_k_poll_signal_init(struct k_poll_signal *signal)
 {
 	sys_dlist_init(&signal->poll_events);
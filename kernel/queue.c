@@ -349,6 +349,37 @@ void *_impl_k_queue_get(struct k_queue *queue, s32_t timeout)
 #endif /* CONFIG_POLL */
 }
 
+int _impl_k_queue_get_many(struct k_queue *queue, void **data, int max,
+			   s32_t timeout)
+{
+	k_spinlock_key_t key;
+	int n = 0;
+
+	if (max <= 0) {
+		return 0;
+	}
+
+	key = k_spin_lock(&queue->lock);
+	while (n < max && !sys_sflist_is_empty(&queue->data_q)) {
+		sys_sfnode_t *node = sys_sflist_get_not_empty(&queue->data_q);
+
+		data[n++] = z_queue_node_peek(node, true);
+	}
+	k_spin_unlock(&queue->lock, key);
+
+	if (n > 0 || timeout == K_NO_WAIT) {
+		return n;
+	}
+
+	/* empty: wait for the first item, then take what else arrived */
+	data[0] = _impl_k_queue_get(queue, timeout);
+	if (data[0] == NULL) {
+		return 0;
+	}
+
+	return 1 + _impl_k_queue_get_many(queue, data + 1, max - 1, K_NO_WAIT);
+}
+
 #ifdef CONFIG_USERSPACE
 Z_SYSCALL_HANDLER(k_queue_get, queue, timeout_p)
 {
@@ -359,6 +390,15 @@ Z_SYSCALL_HANDLER(k_queue_get, queue, timeout_p)
 	return (u32_t)_impl_k_queue_get((struct k_queue *)queue, timeout);
 }
 
+Z_SYSCALL_HANDLER(k_queue_get_many, queue, data, max, timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(queue, K_OBJ_QUEUE));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(data, max, sizeof(void *)));
+
+	return _impl_k_queue_get_many((struct k_queue *)queue, (void **)data,
+				      max, timeout);
+}
+
 Z_SYSCALL_HANDLER1_SIMPLE(k_queue_is_empty, K_OBJ_QUEUE, struct k_queue *);
 Z_SYSCALL_HANDLER1_SIMPLE(k_queue_peek_head, K_OBJ_QUEUE, struct k_queue *);
 Z_SYSCALL_HANDLER1_SIMPLE(k_queue_peek_tail, K_OBJ_QUEUE, struct k_queue *);
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file @brief Reader-writer lock kernel services
+ *
+ * Readers and writers wait on a single priority ordered queue.  A new
+ * reader only gets the lock straight away if nobody is waiting, so a
+ * queued writer is never starved.  On release the lock is handed over
+ * to the first waiter: either one writer, or that reader and all the
+ * readers queued right behind it.  Waiters are granted the lock before
+ * they run, so no other thread can barge in between.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <ksched.h>
+#include <wait_q.h>
+#include <errno.h>
+#include <syscall_handler.h>
+
+/* What a pended thread waits for, in its swap_data */
+#define WANT_READ	((void *)0)
+#define WANT_WRITE	((void *)1)
+
+static struct k_spinlock lock;
+
+void _impl_k_rwlock_init(struct k_rwlock *rwlock)
+{
+	rwlock->writer = NULL;
+	rwlock->readers = 0U;
+	_waitq_init(&rwlock->wait_q);
+
+	_k_object_init(rwlock);
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_rwlock_init, rwlock)
+{
+	Z_OOPS(Z_SYSCALL_OBJ_INIT(rwlock, K_OBJ_RWLOCK));
+	_impl_k_rwlock_init((struct k_rwlock *)rwlock);
+
+	return 0;
+}
+#endif
+
+static void grant(struct k_thread *thread)
+{
+	_unpend_thread(thread);
+	_ready_thread(thread);
+	_set_thread_return_value(thread, 0);
+}
+
+/* Hand the lock, not held for writing, over to the first waiter(s) */
+static void wake_waiters(struct k_rwlock *rwlock)
+{
+	struct k_thread *thread = _waitq_head(&rwlock->wait_q);
+
+	if (thread != NULL && thread->base.swap_data == WANT_WRITE) {
+		if (rwlock->readers == 0U) {
+			rwlock->writer = thread;
+			grant(thread);
+		}
+		return;
+	}
+
+	while (thread != NULL && thread->base.swap_data == WANT_READ) {
+		rwlock->readers++;
+		grant(thread);
+		thread = _waitq_head(&rwlock->wait_q);
+	}
+}
+
+static int wait_for(struct k_rwlock *rwlock, k_spinlock_key_t key,
+		    void *want, s32_t timeout)
+{
+	if (timeout == K_NO_WAIT) {
+		k_spin_unlock(&lock, key);
+		return -EBUSY;
+	}
+
+	_current->base.swap_data = want;
+
+	int ret = _pend_curr(&lock, key, &rwlock->wait_q, timeout);
+
+	if (ret != 0) {
+		/* Timed out: the threads queued behind may now be able
+		 * to take the lock
+		 */
+		key = k_spin_lock(&lock);
+		if (rwlock->writer == NULL) {
+			wake_waiters(rwlock);
+		}
+		_reschedule(&lock, key);
+	}
+
+	return ret;
+}
+
+int _impl_k_rwlock_read_lock(struct k_rwlock *rwlock, s32_t timeout)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (rwlock->writer == NULL && _waitq_head(&rwlock->wait_q) == NULL) {
+		rwlock->readers++;
+		k_spin_unlock(&lock, key);
+		return 0;
+	}
+
+	__ASSERT(rwlock->writer != _current, "read lock held for writing");
+
+	return wait_for(rwlock, key, WANT_READ, timeout);
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_rwlock_read_lock, rwlock, timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return _impl_k_rwlock_read_lock((struct k_rwlock *)rwlock,
+					(s32_t)timeout);
+}
+#endif
+
+int _impl_k_rwlock_write_lock(struct k_rwlock *rwlock, s32_t timeout)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (rwlock->writer == NULL && rwlock->readers == 0U) {
+		rwlock->writer = _current;
+		k_spin_unlock(&lock, key);
+		return 0;
+	}
+
+	__ASSERT(rwlock->writer != _current, "write lock is not recursive");
+
+	return wait_for(rwlock, key, WANT_WRITE, timeout);
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_rwlock_write_lock, rwlock, timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return _impl_k_rwlock_write_lock((struct k_rwlock *)rwlock,
+					 (s32_t)timeout);
+}
+#endif
+
+void _impl_k_rwlock_read_unlock(struct k_rwlock *rwlock)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	__ASSERT(rwlock->readers > 0U, "");
+
+	rwlock->readers--;
+	if (rwlock->readers == 0U) {
+		wake_waiters(rwlock);
+	}
+
+	_reschedule(&lock, key);
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_rwlock_read_unlock, rwlock)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	Z_OOPS(Z_SYSCALL_VERIFY(((struct k_rwlock *)rwlock)->readers > 0));
+	_impl_k_rwlock_read_unlock((struct k_rwlock *)rwlock);
+	return 0;
+}
+#endif
+
+void _impl_k_rwlock_write_unlock(struct k_rwlock *rwlock)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	__ASSERT(rwlock->writer == _current, "");
+
+	rwlock->writer = NULL;
+	wake_waiters(rwlock);
+
+	_reschedule(&lock, key);
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_rwlock_write_unlock, rwlock)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	Z_OOPS(Z_SYSCALL_VERIFY(((struct k_rwlock *)rwlock)->writer ==
+				_current));
+	_impl_k_rwlock_write_unlock((struct k_rwlock *)rwlock);
+	return 0;
+}
+#endif
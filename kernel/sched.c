@@ -176,6 +176,154 @@ static ALWAYS_INLINE struct k_thread *_priq_dumb_mask_best(sys_dlist_t *pq)
 }
 #endif
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+/* With per-CPU ready queues, a runnable thread lives in the queue of
+ * exactly one CPU (base.runq_cpu), and that queue is protected by the
+ * owning CPU's runq_lock rather than sched_lock.  A queued thread
+ * only changes queues when it is stolen, which happens under the
+ * locks of both queues.
+ */
+static inline bool cpu_allowed(struct k_thread *thread, int cpu)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	return (thread->base.cpu_mask & BIT(cpu)) != 0;
+#else
+	return true;
+#endif
+}
+
+/* Preferred home for a thread being made ready: the CPU it last ran
+ * on (its cache is likely still warm), else the first CPU it is
+ * allowed to run on.
+ */
+static struct _cpu *runq_home(struct k_thread *thread)
+{
+	if (cpu_allowed(thread, thread->base.cpu)) {
+		return &_kernel.cpus[thread->base.cpu];
+	}
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (cpu_allowed(thread, i)) {
+			return &_kernel.cpus[i];
+		}
+	}
+
+	return &_kernel.cpus[thread->base.cpu];
+}
+
+/* Locks and returns the CPU whose ready queue holds the thread, or
+ * which should hold it if it is not queued.
+ */
+static struct _cpu *runq_lock(struct k_thread *thread,
+			      k_spinlock_key_t *key)
+{
+	while (true) {
+		struct _cpu *cpu = _is_thread_queued(thread) ?
+			&_kernel.cpus[thread->base.runq_cpu] :
+			runq_home(thread);
+
+		*key = k_spin_lock(&cpu->runq_lock);
+		if (!_is_thread_queued(thread) ||
+		    thread->base.runq_cpu == cpu->id) {
+			return cpu;
+		}
+
+		/* Raced against a steal, try again */
+		k_spin_unlock(&cpu->runq_lock, *key);
+	}
+}
+
+static inline void runq_unlock(struct _cpu *cpu, k_spinlock_key_t key)
+{
+	k_spin_unlock(&cpu->runq_lock, key);
+}
+
+static inline void runq_add(struct _cpu *cpu, struct k_thread *thread)
+{
+	thread->base.runq_cpu = cpu->id;
+	_priq_run_add(&cpu->ready_q.runq, thread);
+}
+
+static inline void runq_remove(struct _cpu *cpu, struct k_thread *thread)
+{
+	_priq_run_remove(&cpu->ready_q.runq, thread);
+}
+
+static inline struct k_thread *runq_best(struct _cpu *cpu)
+{
+	return _priq_run_best(&cpu->ready_q.runq);
+}
+
+/* Called by a CPU about to go idle: pulls the best thread it is
+ * allowed to run out of another CPU's queue and into its own.  Both
+ * queues are locked for the move, lowest CPU id first, so that the
+ * thread stays queued throughout and anyone suspending, aborting or
+ * reprioritizing it meanwhile finds it in one queue or the other.
+ */
+static void runq_steal(struct _cpu *thief)
+{
+	for (int i = 1; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct _cpu *victim =
+			&_kernel.cpus[(thief->id + i) % CONFIG_MP_NUM_CPUS];
+		struct _cpu *first = thief->id < victim->id ? thief : victim;
+		struct _cpu *second = first == thief ? victim : thief;
+		k_spinlock_key_t key1 = k_spin_lock(&first->runq_lock);
+		k_spinlock_key_t key2 = k_spin_lock(&second->runq_lock);
+		struct k_thread *th = runq_best(victim);
+
+		if (th != NULL) {
+			runq_remove(victim, th);
+			runq_add(thief, th);
+			thief->runq_steals++;
+		}
+
+		k_spin_unlock(&second->runq_lock, key2);
+		k_spin_unlock(&first->runq_lock, key1);
+
+		if (th != NULL) {
+			return;
+		}
+	}
+}
+#else
+static inline struct _cpu *runq_lock(struct k_thread *thread,
+				     k_spinlock_key_t *key)
+{
+	ARG_UNUSED(thread);
+
+	*key = k_spin_lock(&sched_lock);
+	return _current_cpu;
+}
+
+static inline void runq_unlock(struct _cpu *cpu, k_spinlock_key_t key)
+{
+	ARG_UNUSED(cpu);
+
+	k_spin_unlock(&sched_lock, key);
+}
+
+static inline void runq_add(struct _cpu *cpu, struct k_thread *thread)
+{
+	ARG_UNUSED(cpu);
+
+	_priq_run_add(&_kernel.ready_q.runq, thread);
+}
+
+static inline void runq_remove(struct _cpu *cpu, struct k_thread *thread)
+{
+	ARG_UNUSED(cpu);
+
+	_priq_run_remove(&_kernel.ready_q.runq, thread);
+}
+
+static inline struct k_thread *runq_best(struct _cpu *cpu)
+{
+	ARG_UNUSED(cpu);
+
+	return _priq_run_best(&_kernel.ready_q.runq);
+}
+#endif
+
 static ALWAYS_INLINE struct k_thread *next_up(void)
 {
 #ifndef CONFIG_SMP
@@ -202,8 +350,21 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 	int queued = _is_thread_queued(_current);
 	int active = !_is_thread_prevented_from_running(_current);
 
+	struct _cpu *cpu = _current_cpu;
+
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	k_spinlock_key_t key = k_spin_lock(&cpu->runq_lock);
+
+	/* Nothing local to do and about to go idle: go find work */
+	if (runq_best(cpu) == NULL && (!active || _is_idle(_current))) {
+		k_spin_unlock(&cpu->runq_lock, key);
+		runq_steal(cpu);
+		key = k_spin_lock(&cpu->runq_lock);
+	}
+#endif
+
 	/* Choose the best thread that is not current */
-	struct k_thread *th = _priq_run_best(&_kernel.ready_q.runq);
+	struct k_thread *th = runq_best(cpu);
 	if (th == NULL) {
 		th = _current_cpu->idle_thread;
 	}
@@ -221,16 +382,20 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 
 	/* Put _current back into the queue */
 	if (th != _current && active && !_is_idle(_current) && !queued) {
-		_priq_run_add(&_kernel.ready_q.runq, _current);
+		runq_add(cpu, _current);
 		_mark_thread_as_queued(_current);
 	}
 
 	/* Take the new _current out of the queue */
 	if (_is_thread_queued(th)) {
-		_priq_run_remove(&_kernel.ready_q.runq, th);
+		runq_remove(cpu, th);
 	}
 	_mark_thread_as_not_queued(th);
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	k_spin_unlock(&cpu->runq_lock, key);
+#endif
+
 	return th;
 #endif
 }
@@ -330,32 +495,44 @@ static void update_cache(int preempt_ok)
 
 void _add_thread_to_ready_q(struct k_thread *thread)
 {
-	LOCKED(&sched_lock) {
-		_priq_run_add(&_kernel.ready_q.runq, thread);
-		_mark_thread_as_queued(thread);
-		update_cache(0);
-	}
+	k_spinlock_key_t key;
+	struct _cpu *cpu = runq_lock(thread, &key);
+
+	runq_add(cpu, thread);
+	_mark_thread_as_queued(thread);
+	update_cache(0);
+
+	runq_unlock(cpu, key);
 }
 
 void _move_thread_to_end_of_prio_q(struct k_thread *thread)
 {
-	LOCKED(&sched_lock) {
-		_priq_run_remove(&_kernel.ready_q.runq, thread);
-		_priq_run_add(&_kernel.ready_q.runq, thread);
-		_mark_thread_as_queued(thread);
-		update_cache(thread == _current);
+	k_spinlock_key_t key;
+	struct _cpu *cpu = runq_lock(thread, &key);
+
+	if (!IS_ENABLED(CONFIG_SCHED_PER_CPU_RUNQ) ||
+	    _is_thread_queued(thread)) {
+		runq_remove(cpu, thread);
 	}
+	runq_add(cpu, thread);
+	_mark_thread_as_queued(thread);
+	update_cache(thread == _current);
+
+	runq_unlock(cpu, key);
 }
 
 void _remove_thread_from_ready_q(struct k_thread *thread)
 {
-	LOCKED(&sched_lock) {
-		if (_is_thread_queued(thread)) {
-			_priq_run_remove(&_kernel.ready_q.runq, thread);
-			_mark_thread_as_not_queued(thread);
-			update_cache(thread == _current);
-		}
+	k_spinlock_key_t key;
+	struct _cpu *cpu = runq_lock(thread, &key);
+
+	if (_is_thread_queued(thread)) {
+		runq_remove(cpu, thread);
+		_mark_thread_as_not_queued(thread);
+		update_cache(thread == _current);
 	}
+
+	runq_unlock(cpu, key);
 }
 
 static void pend(struct k_thread *thread, _wait_q_t *wait_q, s32_t timeout)
@@ -409,6 +586,9 @@ ALWAYS_INLINE void _unpend_thread_no_timeout(struct k_thread *thread)
 	LOCKED(&sched_lock) {
 		_priq_wait_remove(&pended_on(thread)->waitq, thread);
 		_mark_thread_as_not_pending(thread);
+#if CONFIG_PRIORITY_INHERITANCE_DEPTH > 1
+		thread->base.pended_mutex = NULL;
+#endif
 	}
 
 	thread->base.pended_on = NULL;
@@ -475,18 +655,22 @@ void _thread_priority_set(struct k_thread *thread, int prio)
 {
 	bool need_sched = 0;
 
-	LOCKED(&sched_lock) {
-		need_sched = _is_thread_ready(thread);
+	k_spinlock_key_t key;
+	struct _cpu *cpu = runq_lock(thread, &key);
 
-		if (need_sched) {
-			_priq_run_remove(&_kernel.ready_q.runq, thread);
-			thread->base.prio = prio;
-			_priq_run_add(&_kernel.ready_q.runq, thread);
-			update_cache(1);
-		} else {
-			thread->base.prio = prio;
-		}
+	need_sched = _is_thread_ready(thread);
+
+	if (need_sched && (!IS_ENABLED(CONFIG_SCHED_PER_CPU_RUNQ) ||
+			   _is_thread_queued(thread))) {
+		runq_remove(cpu, thread);
+		thread->base.prio = prio;
+		runq_add(cpu, thread);
+		update_cache(1);
+	} else {
+		thread->base.prio = prio;
 	}
+
+	runq_unlock(cpu, key);
 	sys_trace_thread_priority_set(thread);
 
 	if (need_sched && _current->base.sched_locked == 0) {
@@ -494,6 +678,33 @@ void _thread_priority_set(struct k_thread *thread, int prio)
 	}
 }
 
+#if CONFIG_PRIORITY_INHERITANCE_DEPTH > 1
+/* Changes the priority of a mutex owner.  If it is pended on another
+ * mutex, the wait queue is kept sorted for the next owner: the caller
+ * holds the mutex lock, so that the queue is not walked meanwhile.
+ * Otherwise it may be in the run queue, so go the usual way.
+ */
+void _mutex_waiter_priority_set(struct k_thread *thread, int prio)
+{
+	bool waiting = false;
+
+	LOCKED(&sched_lock) {
+		if (thread->base.pended_mutex != NULL) {
+			_priq_wait_remove(&pended_on(thread)->waitq, thread);
+			thread->base.prio = prio;
+			_priq_wait_add(&pended_on(thread)->waitq, thread);
+			waiting = true;
+		}
+	}
+
+	if (waiting) {
+		sys_trace_thread_priority_set(thread);
+	} else {
+		_thread_priority_set(thread, prio);
+	}
+}
+#endif
+
 static inline int resched(void)
 {
 #ifdef CONFIG_SMP
@@ -554,9 +765,14 @@ struct k_thread *_get_next_ready_thread(void)
 {
 	struct k_thread *ret = 0;
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* next_up() locks the local ready queue itself */
+	ret = next_up();
+#else
 	LOCKED(&sched_lock) {
 		ret = next_up();
 	}
+#endif
 
 	return ret;
 }
@@ -568,22 +784,35 @@ void *_get_next_switch_handle(void *interrupted)
 	_current->switch_handle = interrupted;
 
 #ifdef CONFIG_SMP
-	LOCKED(&sched_lock) {
-		struct k_thread *th = next_up();
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* next_up() takes the local ready queue lock itself, only
+	 * local interrupts need to be masked here
+	 */
+	unsigned int key = _arch_irq_lock();
+#else
+	k_spinlock_key_t key = k_spin_lock(&sched_lock);
+#endif
+	struct k_thread *th = next_up();
 
-		if (_current != th) {
-			reset_time_slice();
-			_current_cpu->swap_ok = 0;
+	if (_current != th) {
+		reset_time_slice();
+		_current_cpu->swap_ok = 0;
 #ifdef CONFIG_TRACING
-			sys_trace_thread_switched_out();
+		sys_trace_thread_switched_out();
 #endif
-			_current = th;
+		th->base.cpu = _current_cpu->id;
+		_current = th;
 #ifdef CONFIG_TRACING
-			sys_trace_thread_switched_in();
+		sys_trace_thread_switched_in();
 #endif
-		}
 	}
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	_arch_irq_unlock(key);
+#else
+	k_spin_unlock(&sched_lock, key);
+#endif
+
 #else
 #ifdef CONFIG_TRACING
 	sys_trace_thread_switched_out();
@@ -697,37 +926,63 @@ struct k_thread *_priq_rb_best(struct _priq_rb *pq)
 }
 
 #ifdef CONFIG_SCHED_MULTIQ
-# if (K_LOWEST_THREAD_PRIO - K_HIGHEST_THREAD_PRIO) > 31
-# error Too many priorities for multiqueue scheduler (max 32)
-# endif
-#endif
+BUILD_ASSERT_MSG(_PRIQ_MQ_BITMAP_WORDS <= 32,
+		 "Too many priorities for multiqueue scheduler (max 1024)");
 
 ALWAYS_INLINE void _priq_mq_add(struct _priq_mq *pq, struct k_thread *thread)
 {
 	int priority_bit = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	sys_dlist_t *l = &pq->queues[priority_bit];
+
+	sys_dnode_t *next = NULL;
 
-	sys_dlist_append(&pq->queues[priority_bit], &thread->base.qnode_dlist);
-	pq->bitmask |= (1 << priority_bit);
+#ifdef CONFIG_SCHED_DEADLINE
+	struct k_thread *t;
+
+	/* Only threads of the same priority share a list, so this
+	 * only has to order them by deadline
+	 */
+	SYS_DLIST_FOR_EACH_CONTAINER(l, t, base.qnode_dlist) {
+		if (_is_t1_higher_prio_than_t2(thread, t)) {
+			next = &t->base.qnode_dlist;
+			break;
+		}
+	}
+#endif
+
+	if (next != NULL) {
+		sys_dlist_insert(next, &thread->base.qnode_dlist);
+	} else {
+		sys_dlist_append(l, &thread->base.qnode_dlist);
+	}
+
+	pq->bitmask[priority_bit >> 5] |= BIT(priority_bit & 31);
+	pq->bitmask_l1 |= BIT(priority_bit >> 5);
 }
 
 ALWAYS_INLINE void _priq_mq_remove(struct _priq_mq *pq, struct k_thread *thread)
 {
 	int priority_bit = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	unsigned int *word = &pq->bitmask[priority_bit >> 5];
 
 	sys_dlist_remove(&thread->base.qnode_dlist);
 	if (sys_dlist_is_empty(&pq->queues[priority_bit])) {
-		pq->bitmask &= ~(1 << priority_bit);
+		*word &= ~BIT(priority_bit & 31);
+		if (*word == 0) {
+			pq->bitmask_l1 &= ~BIT(priority_bit >> 5);
+		}
 	}
 }
 
 struct k_thread *_priq_mq_best(struct _priq_mq *pq)
 {
-	if (!pq->bitmask) {
+	if (!pq->bitmask_l1) {
 		return NULL;
 	}
 
 	struct k_thread *t = NULL;
-	sys_dlist_t *l = &pq->queues[__builtin_ctz(pq->bitmask)];
+	int w = __builtin_ctz(pq->bitmask_l1);
+	sys_dlist_t *l = &pq->queues[(w << 5) + __builtin_ctz(pq->bitmask[w])];
 	sys_dnode_t *n = sys_dlist_peek_head(l);
 
 	if (n != NULL) {
@@ -735,6 +990,7 @@ struct k_thread *_priq_mq_best(struct _priq_mq *pq)
 	}
 	return t;
 }
+#endif /* CONFIG_SCHED_MULTIQ */
 
 int _unpend_all(_wait_q_t *wait_q)
 {
@@ -770,6 +1026,28 @@ void _sched_init(void)
 	}
 #endif
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct _ready_q *rq = &_kernel.cpus[i].ready_q;
+
+# ifdef CONFIG_SCHED_DUMB
+		sys_dlist_init(&rq->runq);
+# endif
+# ifdef CONFIG_SCHED_SCALABLE
+		rq->runq = (struct _priq_rb) {
+			.tree = {
+				.lessthan_fn = _priq_rb_lessthan,
+			}
+		};
+# endif
+# ifdef CONFIG_SCHED_MULTIQ
+		for (int j = 0; j < ARRAY_SIZE(rq->runq.queues); j++) {
+			sys_dlist_init(&rq->runq.queues[j]);
+		}
+# endif
+	}
+#endif
+
 #ifdef CONFIG_TIMESLICING
 	k_sched_time_slice_set(CONFIG_TIMESLICE_SIZE,
 		CONFIG_TIMESLICE_PRIORITY);
@@ -817,18 +1095,42 @@ Z_SYSCALL_HANDLER(k_thread_priority_set, thread_p, prio)
 }
 #endif
 
+#ifdef CONFIG_TIMEOUT_SLACK
+void _impl_k_thread_timer_slack_set(k_tid_t tid, s32_t slack)
+{
+	struct k_thread *thread = tid;
+
+	thread->base.timeout.slack = _ms_to_ticks(MAX(slack, 0));
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(k_thread_timer_slack_set, thread_p, slack)
+{
+	struct k_thread *thread = (struct k_thread *)thread_p;
+
+	Z_OOPS(Z_SYSCALL_OBJ(thread, K_OBJ_THREAD));
+
+	_impl_k_thread_timer_slack_set((k_tid_t)thread, (s32_t)slack);
+	return 0;
+}
+#endif
+#endif
+
 #ifdef CONFIG_SCHED_DEADLINE
 void _impl_k_thread_deadline_set(k_tid_t tid, int deadline)
 {
 	struct k_thread *th = tid;
 
-	LOCKED(&sched_lock) {
-		th->base.prio_deadline = k_cycle_get_32() + deadline;
-		if (_is_thread_queued(th)) {
-			_priq_run_remove(&_kernel.ready_q.runq, th);
-			_priq_run_add(&_kernel.ready_q.runq, th);
-		}
+	k_spinlock_key_t key;
+	struct _cpu *cpu = runq_lock(th, &key);
+
+	th->base.prio_deadline = k_cycle_get_32() + deadline;
+	if (_is_thread_queued(th)) {
+		runq_remove(cpu, th);
+		runq_add(cpu, th);
 	}
+
+	runq_unlock(cpu, key);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -852,11 +1154,23 @@ void _impl_k_yield(void)
 	__ASSERT(!_is_in_isr(), "");
 
 	if (!_is_idle(_current)) {
-		LOCKED(&sched_lock) {
-			_priq_run_remove(&_kernel.ready_q.runq, _current);
-			_priq_run_add(&_kernel.ready_q.runq, _current);
-			update_cache(1);
+		k_spinlock_key_t key;
+		struct _cpu *cpu = runq_lock(_current, &key);
+
+		/* Under per-CPU queues _current is never queued, and
+		 * yielding puts it back into its own CPU's queue
+		 */
+		if (!IS_ENABLED(CONFIG_SCHED_PER_CPU_RUNQ) ||
+		    _is_thread_queued(_current)) {
+			runq_remove(cpu, _current);
+		}
+		runq_add(cpu, _current);
+		if (IS_ENABLED(CONFIG_SCHED_PER_CPU_RUNQ)) {
+			_mark_thread_as_queued(_current);
 		}
+		update_cache(1);
+
+		runq_unlock(cpu, key);
 	}
 
 	_Swap_unlocked();
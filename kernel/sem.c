@@ -32,15 +32,6 @@
 extern struct k_sem _k_sem_list_start[];
 extern struct k_sem _k_sem_list_end[];
 
-/* We use a system-wide lock to synchronize semaphores, which has
- * unfortunate performance impact vs. using a per-object lock
- * (semaphores are *very* widely used).  But per-object locks require
- * significant extra RAM.  A properly spin-aware semaphore
- * implementation would spin on atomic access to the count variable,
- * and not a spinlock per se.  Useful optimization for the future...
- */
-static struct k_spinlock lock;
-
 #ifdef CONFIG_OBJECT_TRACING
 
 struct k_sem *_trace_list_k_sem;
@@ -73,6 +64,7 @@ void _impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
 	sys_trace_void(SYS_TRACE_ID_SEMA_INIT);
 	sem->count = initial_count;
 	sem->limit = limit;
+	sem->lock = (struct k_spinlock) {};
 	_waitq_init(&sem->wait_q);
 #if defined(CONFIG_POLL)
 	sys_dlist_init(&sem->poll_events);
@@ -123,12 +115,12 @@ static void do_sem_give(struct k_sem *sem)
 
 void _impl_k_sem_give(struct k_sem *sem)
 {
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = k_spin_lock(&sem->lock);
 
 	sys_trace_void(SYS_TRACE_ID_SEMA_GIVE);
 	do_sem_give(sem);
 	sys_trace_end_call(SYS_TRACE_ID_SEMA_GIVE);
-	_reschedule(&lock, key);
+	_reschedule(&sem->lock, key);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -140,24 +132,24 @@ int _impl_k_sem_take(struct k_sem *sem, s32_t timeout)
 	__ASSERT(((_is_in_isr() == false) || (timeout == K_NO_WAIT)), "");
 
 	sys_trace_void(SYS_TRACE_ID_SEMA_TAKE);
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = k_spin_lock(&sem->lock);
 
 	if (likely(sem->count > 0U)) {
 		sem->count--;
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(&sem->lock, key);
 		sys_trace_end_call(SYS_TRACE_ID_SEMA_TAKE);
 		return 0;
 	}
 
 	if (timeout == K_NO_WAIT) {
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(&sem->lock, key);
 		sys_trace_end_call(SYS_TRACE_ID_SEMA_TAKE);
 		return -EBUSY;
 	}
 
 	sys_trace_end_call(SYS_TRACE_ID_SEMA_TAKE);
 
-	int ret = _pend_curr(&lock, key, &sem->wait_q, timeout);
+	int ret = _pend_curr(&sem->lock, key, &sem->wait_q, timeout);
 	return ret;
 }
 
@@ -30,6 +30,7 @@
 #include <init.h>
 #include <tracing.h>
 #include <stdbool.h>
+#include <string.h>
 
 extern struct _static_thread_data _static_thread_data_list_start[];
 extern struct _static_thread_data _static_thread_data_list_end[];
@@ -394,6 +395,10 @@ void _setup_new_thread(struct k_thread *new_thread,
 #ifdef CONFIG_SCHED_CPU_MASK
 	new_thread->base.cpu_mask = -1;
 #endif
+#ifdef CONFIG_TRACING_CPU_STATS_THREADS
+	(void)memset(&new_thread->runtime_stats, 0,
+		     sizeof(new_thread->runtime_stats));
+#endif
 #ifdef CONFIG_ARCH_HAS_CUSTOM_SWAP_TO_MAIN
 	/* _current may be null if the dummy thread is not used */
 	if (!_current) {
@@ -679,6 +684,10 @@ void _init_thread_base(struct _thread_base *thread_base, int priority,
 
 	thread_base->sched_locked = 0;
 
+#if CONFIG_PRIORITY_INHERITANCE_DEPTH > 1
+	thread_base->pended_mutex = NULL;
+#endif
+
 	/* swap_data does not need to be initialized */
 
 	_init_thread_timeout(thread_base);
@@ -17,8 +17,6 @@
 
 static u64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
-
 static struct k_spinlock timeout_lock;
 
 static bool can_wait_forever;
@@ -30,6 +28,240 @@ static int announce_remaining;
 int z_clock_hw_cycles_per_sec = CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC;
 #endif
 
+static s32_t elapsed(void)
+{
+	return announce_remaining == 0 ? z_clock_elapsed() : 0;
+}
+
+#ifdef CONFIG_TIMEOUT_WHEEL
+
+/* Hierarchical timing wheel.  Slot i of level L holds timeouts whose
+ * absolute expiry tick first differs from the current tick in the
+ * bits [L * WHEEL_BITS, (L + 1) * WHEEL_BITS), and has i in those
+ * bits.  So level 0 timeouts expire exactly at the tick matching
+ * their slot, and level L > 0 timeouts are "cascaded" (reinserted,
+ * landing in a lower level) when the current tick crosses into their
+ * slot.  Slot occupancy is tracked in one bitmap per level so that
+ * finding the next tick with work to do is a handful of
+ * count-trailing-zeros operations.  Bits are cleared lazily: an
+ * aborted timeout may leave its slot flagged but empty, which is
+ * cleaned up next time the slot is inspected.  A slot whose bit is
+ * clear may contain stale list pointers and is (re)initialized on
+ * first use.
+ *
+ * Tick values are handled modulo 2^32, which is fine as timeouts
+ * never exceed INT_MAX ticks.
+ */
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS BIT(WHEEL_BITS)
+#define WHEEL_MASK (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS ((32 + WHEEL_BITS - 1) / WHEEL_BITS)
+#define SLOT_BIT(i) (1ULL << (i))
+
+struct wheel_level {
+	u64_t occupied;
+	sys_dlist_t slots[WHEEL_SLOTS];
+};
+
+static struct wheel_level wheel[WHEEL_LEVELS];
+
+static inline u32_t now_tick(void)
+{
+	return (u32_t)curr_tick;
+}
+
+static void wheel_insert(struct _timeout *to)
+{
+	u32_t diff = to->expiry ^ now_tick();
+	int lvl = diff == 0 ? 0 : (31 - __builtin_clz(diff)) / WHEEL_BITS;
+	int idx = (to->expiry >> (lvl * WHEEL_BITS)) & WHEEL_MASK;
+	struct wheel_level *l = &wheel[lvl];
+
+	if ((l->occupied & SLOT_BIT(idx)) == 0) {
+		sys_dlist_init(&l->slots[idx]);
+		l->occupied |= SLOT_BIT(idx);
+	}
+	sys_dlist_append(&l->slots[idx], &to->node);
+}
+
+static void wheel_cascade(int lvl, int idx)
+{
+	struct wheel_level *l = &wheel[lvl];
+	sys_dnode_t *n;
+
+	if ((l->occupied & SLOT_BIT(idx)) == 0) {
+		return;
+	}
+	l->occupied &= ~SLOT_BIT(idx);
+
+	while ((n = sys_dlist_get(&l->slots[idx])) != NULL) {
+		wheel_insert(CONTAINER_OF(n, struct _timeout, node));
+	}
+}
+
+/* Finds the next tick (after the current one) at which the wheel has
+ * work to do: either the expiry of a level 0 timeout or the cascade
+ * of an upper level slot.  Events of a lower level always precede
+ * those of any higher level, so the first non-empty level wins.
+ */
+static bool wheel_next_event(u32_t *tick)
+{
+	u32_t now = now_tick();
+
+	for (int lvl = 0; lvl < WHEEL_LEVELS; lvl++) {
+		struct wheel_level *l = &wheel[lvl];
+		int shift = lvl * WHEEL_BITS;
+		int cur = (now >> shift) & WHEEL_MASK;
+		u64_t later = l->occupied & ~((2ULL << cur) - 1);
+
+		/* Only the top level can wrap around */
+		if (later == 0 && lvl == WHEEL_LEVELS - 1) {
+			later = l->occupied;
+		}
+
+		while (later != 0) {
+			int idx = __builtin_ctzll(later);
+
+			if (!sys_dlist_is_empty(&l->slots[idx])) {
+				u64_t span = (u64_t)WHEEL_SLOTS << shift;
+
+				*tick = (u32_t)(now & ~(span - 1)) |
+					((u32_t)idx << shift);
+				return true;
+			}
+
+			l->occupied &= ~SLOT_BIT(idx);
+			later &= ~SLOT_BIT(idx);
+		}
+	}
+
+	return false;
+}
+
+/* Advances the wheel to the given event tick, performing any cascades
+ * due at it.  Afterwards level 0 holds the timeouts expiring now.
+ */
+static void wheel_advance(u32_t tick)
+{
+	curr_tick += tick - now_tick();
+
+	for (int lvl = WHEEL_LEVELS - 1; lvl > 0; lvl--) {
+		int shift = lvl * WHEEL_BITS;
+
+		if ((tick & (u32_t)((1ULL << shift) - 1)) == 0) {
+			wheel_cascade(lvl, (tick >> shift) & WHEEL_MASK);
+		}
+	}
+}
+
+static struct _timeout *wheel_pop_expired(void)
+{
+	struct wheel_level *l = &wheel[0];
+	int idx = now_tick() & WHEEL_MASK;
+	sys_dnode_t *n = NULL;
+
+	if ((l->occupied & SLOT_BIT(idx)) != 0) {
+		n = sys_dlist_get(&l->slots[idx]);
+		if (n == NULL) {
+			l->occupied &= ~SLOT_BIT(idx);
+		}
+	}
+
+	return n == NULL ? NULL : CONTAINER_OF(n, struct _timeout, node);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	sys_dlist_remove(&t->node);
+}
+
+static s32_t next_timeout(void)
+{
+	int maxw = can_wait_forever ? K_FOREVER : INT_MAX;
+	u32_t tick;
+	s32_t ret = !wheel_next_event(&tick) ? maxw :
+		MAX(0, (s32_t)(tick - now_tick()) - elapsed());
+
+#ifdef CONFIG_TIMESLICING
+	if (_current_cpu->slice_ticks && _current_cpu->slice_ticks < ret) {
+		ret = _current_cpu->slice_ticks;
+	}
+#endif
+	return ret;
+}
+
+void _add_timeout(struct _timeout *to, _timeout_func_t fn, s32_t ticks)
+{
+	__ASSERT(!sys_dnode_is_linked(&to->node), "");
+	to->fn = fn;
+	ticks = MAX(1, ticks);
+
+	LOCKED(&timeout_lock) {
+		u32_t tick;
+		bool pending = wheel_next_event(&tick);
+
+		to->expiry = now_tick() + ticks + elapsed();
+		wheel_insert(to);
+
+		if (!pending ||
+		    (to->expiry - now_tick()) < (tick - now_tick())) {
+			z_clock_set_timeout(next_timeout(), false);
+		}
+	}
+}
+
+s32_t z_timeout_remaining(struct _timeout *timeout)
+{
+	s32_t ticks = 0;
+
+	if (_is_inactive_timeout(timeout)) {
+		return 0;
+	}
+
+	LOCKED(&timeout_lock) {
+		ticks = (s32_t)(timeout->expiry - now_tick());
+	}
+
+	return ticks;
+}
+
+void z_clock_announce(s32_t ticks)
+{
+#ifdef CONFIG_TIMESLICING
+	z_time_slice(ticks);
+#endif
+
+	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
+	u32_t tick;
+
+	announce_remaining = ticks;
+
+	while (wheel_next_event(&tick) &&
+	       (s32_t)(tick - now_tick()) <= announce_remaining) {
+		struct _timeout *t;
+
+		announce_remaining -= tick - now_tick();
+		wheel_advance(tick);
+
+		while ((t = wheel_pop_expired()) != NULL) {
+			k_spin_unlock(&timeout_lock, key);
+			t->fn(t);
+			key = k_spin_lock(&timeout_lock);
+		}
+	}
+
+	curr_tick += announce_remaining;
+	announce_remaining = 0;
+
+	z_clock_set_timeout(next_timeout(), false);
+
+	k_spin_unlock(&timeout_lock, key);
+}
+
+#else /* !CONFIG_TIMEOUT_WHEEL */
+
+static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -53,16 +285,43 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
-static s32_t elapsed(void)
+#ifdef CONFIG_TIMEOUT_SLACK
+static u32_t wakeups_avoided;
+
+/* Latest tick, relative to curr_tick, by which every pending timeout
+ * is still within its slack: the minimum of expiry + slack.  Only
+ * timeouts expiring before the current bound can lower it and the
+ * list is sorted by expiry, so the walk usually ends after a few
+ * entries.
+ */
+static s32_t coalesced_dticks(void)
 {
-	return announce_remaining == 0 ? z_clock_elapsed() : 0;
+	s32_t bound = INT_MAX;
+	s32_t expiry = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		expiry += t->dticks;
+		if (expiry > bound) {
+			break;
+		}
+		if (t->slack < bound - expiry) {
+			bound = expiry + t->slack;
+		}
+	}
+
+	return bound;
 }
+#endif
 
 static s32_t next_timeout(void)
 {
 	int maxw = can_wait_forever ? K_FOREVER : INT_MAX;
 	struct _timeout *to = first();
+#ifdef CONFIG_TIMEOUT_SLACK
+	s32_t ret = to == NULL ? maxw : MAX(0, coalesced_dticks() - elapsed());
+#else
 	s32_t ret = to == NULL ? maxw : MAX(0, to->dticks - elapsed());
+#endif
 
 #ifdef CONFIG_TIMESLICING
 	if (_current_cpu->slice_ticks && _current_cpu->slice_ticks < ret) {
@@ -80,6 +339,10 @@ void _add_timeout(struct _timeout *to, _timeout_func_t fn, s32_t ticks)
 
 	LOCKED(&timeout_lock) {
 		struct _timeout *t;
+#ifdef CONFIG_TIMEOUT_SLACK
+		s32_t bound = coalesced_dticks();
+		s32_t expiry = ticks + elapsed();
+#endif
 
 		to->dticks = ticks + elapsed();
 		for (t = first(); t != NULL; t = next(t)) {
@@ -97,24 +360,17 @@ void _add_timeout(struct _timeout *to, _timeout_func_t fn, s32_t ticks)
 			sys_dlist_append(&timeout_list, &to->node);
 		}
 
-		if (to == first()) {
+#ifdef CONFIG_TIMEOUT_SLACK
+		/* Reprogram only if the coalesced wakeup moved earlier */
+		if (expiry <= bound && to->slack < bound - expiry) {
 			z_clock_set_timeout(next_timeout(), false);
 		}
-	}
-}
-
-int _abort_timeout(struct _timeout *to)
-{
-	int ret = -EINVAL;
-
-	LOCKED(&timeout_lock) {
-		if (sys_dnode_is_linked(&to->node)) {
-			remove_timeout(to);
-			ret = 0;
+#else
+		if (to == first()) {
+			z_clock_set_timeout(next_timeout(), false);
 		}
+#endif
 	}
-
-	return ret;
 }
 
 s32_t z_timeout_remaining(struct _timeout *timeout)
@@ -137,35 +393,6 @@ s32_t z_timeout_remaining(struct _timeout *timeout)
 	return ticks;
 }
 
-s32_t _get_next_timeout_expiry(void)
-{
-	s32_t ret = K_FOREVER;
-
-	LOCKED(&timeout_lock) {
-		ret = next_timeout();
-	}
-	return ret;
-}
-
-void z_set_timeout_expiry(s32_t ticks, bool idle)
-{
-	LOCKED(&timeout_lock) {
-		int next = next_timeout();
-		bool sooner = (next == K_FOREVER) || (ticks < next);
-		bool imminent = next <= 1;
-
-		/* Only set new timeouts when they are sooner than
-		 * what we have.  Also don't try to set a timeout when
-		 * one is about to expire: drivers have internal logic
-		 * that will bump the timeout to the "next" tick if
-		 * it's not considered to be settable as directed.
-		 */
-		if (sooner && !imminent) {
-			z_clock_set_timeout(ticks, idle);
-		}
-	}
-}
-
 void z_clock_announce(s32_t ticks)
 {
 #ifdef CONFIG_TIMESLICING
@@ -173,6 +400,9 @@ void z_clock_announce(s32_t ticks)
 #endif
 
 	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
+#ifdef CONFIG_TIMEOUT_SLACK
+	u32_t expiries = 0U;
+#endif
 
 	announce_remaining = ticks;
 
@@ -180,6 +410,12 @@ void z_clock_announce(s32_t ticks)
 		struct _timeout *t = first();
 		int dt = t->dticks;
 
+#ifdef CONFIG_TIMEOUT_SLACK
+		/* Each distinct expiry tick would have been a wakeup */
+		if (dt != 0 || expiries == 0U) {
+			expiries++;
+		}
+#endif
 		curr_tick += dt;
 		announce_remaining -= dt;
 		t->dticks = 0;
@@ -194,6 +430,12 @@ void z_clock_announce(s32_t ticks)
 		first()->dticks -= announce_remaining;
 	}
 
+#ifdef CONFIG_TIMEOUT_SLACK
+	if (expiries > 1) {
+		wakeups_avoided += expiries - 1;
+	}
+#endif
+
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
 
@@ -202,6 +444,58 @@ void z_clock_announce(s32_t ticks)
 	k_spin_unlock(&timeout_lock, key);
 }
 
+#endif /* CONFIG_TIMEOUT_WHEEL */
+
+#ifdef CONFIG_TIMEOUT_SLACK
+u32_t k_timeout_wakeups_avoided_get(void)
+{
+	return wakeups_avoided;
+}
+#endif
+
+int _abort_timeout(struct _timeout *to)
+{
+	int ret = -EINVAL;
+
+	LOCKED(&timeout_lock) {
+		if (sys_dnode_is_linked(&to->node)) {
+			remove_timeout(to);
+			ret = 0;
+		}
+	}
+
+	return ret;
+}
+
+s32_t _get_next_timeout_expiry(void)
+{
+	s32_t ret = K_FOREVER;
+
+	LOCKED(&timeout_lock) {
+		ret = next_timeout();
+	}
+	return ret;
+}
+
+void z_set_timeout_expiry(s32_t ticks, bool idle)
+{
+	LOCKED(&timeout_lock) {
+		int next = next_timeout();
+		bool sooner = (next == K_FOREVER) || (ticks < next);
+		bool imminent = next <= 1;
+
+		/* Only set new timeouts when they are sooner than
+		 * what we have.  Also don't try to set a timeout when
+		 * one is about to expire: drivers have internal logic
+		 * that will bump the timeout to the "next" tick if
+		 * it's not considered to be settable as directed.
+		 */
+		if (sooner && !imminent) {
+			z_clock_set_timeout(ticks, idle);
+		}
+	}
+}
+
 int k_enable_sys_clock_always_on(void)
 {
 	int ret = !can_wait_forever;
@@ -224,3 +224,12 @@ Z_SYSCALL_HANDLER(k_timer_user_data_set, timer, user_data)
 	return 0;
 }
 #endif
+
+#if defined(CONFIG_USERSPACE) && defined(CONFIG_TIMEOUT_SLACK)
+Z_SYSCALL_HANDLER(k_timer_slack_set, timer, slack)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(timer, K_OBJ_TIMER));
+	_impl_k_timer_slack_set((struct k_timer *)timer, (s32_t)slack);
+	return 0;
+}
+#endif
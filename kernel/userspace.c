@@ -8,7 +8,6 @@
 #include <kernel.h>
 #include <string.h>
 #include <misc/printk.h>
-#include <misc/rb.h>
 #include <kernel_structs.h>
 #include <sys_io.h>
 #include <ksched.h>
@@ -31,7 +30,7 @@ LOG_MODULE_DECLARE(kernel);
  * not.
  */
 #ifdef CONFIG_DYNAMIC_OBJECTS
-static struct k_spinlock lists_lock;       /* kobj rbtree/dlist */
+static struct k_spinlock lists_lock;       /* kobj hash table */
 static struct k_spinlock objfree_lock;     /* k_object_free */
 #endif
 static struct k_spinlock obj_lock;         /* kobj struct data */
@@ -86,8 +85,7 @@ struct perm_ctx {
 #ifdef CONFIG_DYNAMIC_OBJECTS
 struct dyn_obj {
 	struct _k_object kobj;
-	sys_dnode_t obj_list;
-	struct rbnode node; /* must be immediately before data member */
+	sys_snode_t obj_list;
 	u8_t data[]; /* The object itself */
 };
 
@@ -95,26 +93,14 @@ extern struct _k_object *_k_object_gperf_find(void *obj);
 extern void _k_object_gperf_wordlist_foreach(_wordlist_cb_func_t func,
 					     void *context);
 
-static bool node_lessthan(struct rbnode *a, struct rbnode *b);
-
-/*
- * Red/black tree of allocated kernel objects, for reasonably fast lookups
- * based on object pointer values.
- */
-static struct rbtree obj_rb_tree = {
-	.lessthan_fn = node_lessthan
-};
-
 /*
- * Linked list of allocated kernel objects, for iteration over all allocated
- * objects (and potentially deleting them during iteration).
- */
-static sys_dlist_t obj_list = SYS_DLIST_STATIC_INIT(&obj_list);
-
-/*
- * TODO: Write some hash table code that will replace both obj_rb_tree
- * and obj_list.
+ * Hash table of allocated kernel objects, chained, keyed by object
+ * pointer value.  Every syscall taking a dynamic object looks it up
+ * here, so lookups take constant time as long as the buckets are kept
+ * short.  Also used to iterate over all allocated objects (and
+ * potentially delete them during iteration).
  */
+static sys_slist_t obj_table[CONFIG_DYNAMIC_OBJECTS_HASH_SIZE];
 
 static size_t obj_size_get(enum k_objects otype)
 {
@@ -130,39 +116,52 @@ static size_t obj_size_get(enum k_objects otype)
 	return ret;
 }
 
-static bool node_lessthan(struct rbnode *a, struct rbnode *b)
+static sys_slist_t *obj_bucket(void *obj)
 {
-	return a < b;
-}
+	u32_t hash = (u32_t)(uintptr_t)obj;
 
-static inline struct dyn_obj *node_to_dyn_obj(struct rbnode *node)
-{
-	return CONTAINER_OF(node, struct dyn_obj, node);
+	/* Objects come from a heap whose blocks are aligned to their
+	 * size, mix the high bits into the low ones
+	 */
+	hash ^= hash >> 16;
+	hash *= 0x45d9f3bU;
+	hash ^= hash >> 16;
+
+	return &obj_table[hash % CONFIG_DYNAMIC_OBJECTS_HASH_SIZE];
 }
 
 static struct dyn_obj *dyn_object_find(void *obj)
 {
-	struct rbnode *node;
-	struct dyn_obj *ret;
-
-	/* For any dynamically allocated kernel object, the object
-	 * pointer is just a member of the conatining struct dyn_obj,
-	 * so just a little arithmetic is necessary to locate the
-	 * corresponding struct rbnode
-	 */
-	node = (struct rbnode *)((char *)obj - sizeof(struct rbnode));
+	struct dyn_obj *dyn_obj, *ret = NULL;
 
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
-	if (rb_contains(&obj_rb_tree, node)) {
-		ret = node_to_dyn_obj(node);
-	} else {
-		ret = NULL;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(obj_bucket(obj), dyn_obj, obj_list) {
+		if (dyn_obj->kobj.name == obj) {
+			ret = dyn_obj;
+			break;
+		}
 	}
 	k_spin_unlock(&lists_lock, key);
 
 	return ret;
 }
 
+/* Caller holds lists_lock */
+static void dyn_object_remove_locked(struct dyn_obj *dyn_obj)
+{
+	(void)sys_slist_find_and_remove(obj_bucket(dyn_obj->kobj.name),
+					&dyn_obj->obj_list);
+}
+
+static void dyn_object_remove(struct dyn_obj *dyn_obj)
+{
+	k_spinlock_key_t key = k_spin_lock(&lists_lock);
+
+	dyn_object_remove_locked(dyn_obj);
+	k_spin_unlock(&lists_lock, key);
+}
+
 /**
  * @internal
  *
@@ -266,8 +265,7 @@ void *_impl_k_object_alloc(enum k_objects otype)
 
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
 
-	rb_insert(&obj_rb_tree, &dyn_obj->node);
-	sys_dlist_append(&obj_list, &dyn_obj->obj_list);
+	sys_slist_prepend(obj_bucket(dyn_obj->kobj.name), &dyn_obj->obj_list);
 	k_spin_unlock(&lists_lock, key);
 
 	return dyn_obj->kobj.name;
@@ -286,8 +284,7 @@ void k_object_free(void *obj)
 
 	dyn_obj = dyn_object_find(obj);
 	if (dyn_obj != NULL) {
-		rb_remove(&obj_rb_tree, &dyn_obj->node);
-		sys_dlist_remove(&dyn_obj->obj_list);
+		dyn_object_remove(dyn_obj);
 
 		if (dyn_obj->kobj.type == K_OBJ_THREAD) {
 			_thread_idx_free(dyn_obj->kobj.data);
@@ -322,12 +319,18 @@ void _k_object_wordlist_foreach(_wordlist_cb_func_t func, void *context)
 {
 	struct dyn_obj *obj, *next;
 
-	_k_object_gperf_wordlist_foreach(func, context);
-
+	/* Callbacks may unlink the object they are passed, see
+	 * unref_check_locked()
+	 */
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
 
-	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&obj_list, obj, next, obj_list) {
-		func(&obj->kobj, context);
+	_k_object_gperf_wordlist_foreach(func, context);
+
+	for (int i = 0; i < ARRAY_SIZE(obj_table); i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&obj_table[i], obj, next,
+						  obj_list) {
+			func(&obj->kobj, context);
+		}
 	}
 	k_spin_unlock(&lists_lock, key);
 }
@@ -346,7 +349,11 @@ static int thread_index_get(struct k_thread *t)
 	return ko->data;
 }
 
-static void unref_check(struct _k_object *ko, int index)
+/* With dynamic objects, the caller holds lists_lock, which is always
+ * taken before obj_lock.  _k_object_wordlist_foreach() callbacks run
+ * with it held.
+ */
+static void unref_check_locked(struct _k_object *ko, int index)
 {
 	k_spinlock_key_t key = k_spin_lock(&obj_lock);
 
@@ -386,14 +393,25 @@ static void unref_check(struct _k_object *ko, int index)
 		break;
 	}
 
-	rb_remove(&obj_rb_tree, &dyn_obj->node);
-	sys_dlist_remove(&dyn_obj->obj_list);
+	dyn_object_remove_locked(dyn_obj);
 	k_free(dyn_obj);
 out:
 #endif
 	k_spin_unlock(&obj_lock, key);
 }
 
+static void unref_check(struct _k_object *ko, int index)
+{
+#ifdef CONFIG_DYNAMIC_OBJECTS
+	k_spinlock_key_t key = k_spin_lock(&lists_lock);
+
+	unref_check_locked(ko, index);
+	k_spin_unlock(&lists_lock, key);
+#else
+	unref_check_locked(ko, index);
+#endif
+}
+
 static void wordlist_cb(struct _k_object *ko, void *ctx_ptr)
 {
 	struct perm_ctx *ctx = (struct perm_ctx *)ctx_ptr;
@@ -440,7 +458,7 @@ static void clear_perms_cb(struct _k_object *ko, void *ctx_ptr)
 {
 	int id = (int)ctx_ptr;
 
-	unref_check(ko, id);
+	unref_check_locked(ko, id);
 }
 
 void _thread_perms_all_clear(struct k_thread *thread)
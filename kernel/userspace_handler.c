@@ -5,6 +5,7 @@
  */
 
 #include <kernel.h>
+#include <string.h>
 #include <syscall_handler.h>
 #include <kernel_structs.h>
 
@@ -69,3 +70,33 @@ Z_SYSCALL_HANDLER(k_object_alloc, otype)
 
 	return (u32_t)_impl_k_object_alloc(otype);
 }
+
+Z_SYSCALL_HANDLER(k_syscall_batch, ops_p, num_ops)
+{
+	struct k_syscall_op *ops = (struct k_syscall_op *)ops_p;
+	struct k_syscall_op op;
+
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(ops, num_ops, sizeof(*ops)));
+
+	for (u32_t i = 0; i < num_ops; i++) {
+		/* Work on a copy: other user threads may change the
+		 * array while the operation runs
+		 */
+		(void)memcpy(&op, &ops[i], sizeof(op));
+
+		Z_OOPS(Z_SYSCALL_VERIFY_MSG(op.id < K_SYSCALL_BAD &&
+					    op.id != K_SYSCALL_K_SYSCALL_BATCH,
+					    "invalid batched system call %u",
+					    op.id));
+
+		/* The handler validates the arguments, as for a single
+		 * system call, and oopses on this batch's stack frame
+		 */
+		ops[i].ret = _k_syscall_table[op.id](op.arg[0], op.arg[1],
+						     op.arg[2], op.arg[3],
+						     op.arg[4], op.arg[5],
+						     ssf);
+	}
+
+	return num_ops;
+}
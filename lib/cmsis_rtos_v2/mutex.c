@@ -17,6 +17,62 @@ static const osMutexAttr_t init_mutex_attrs = {
 	.cb_size = 0,
 };
 
+/* Mutexes without priority inheritance are futex based sys_mutexes,
+ * which need no kernel call unless contended.  The kernel does not
+ * track their owner, so we do.
+ */
+static inline bool is_fast(struct cv2_mutex *mutex)
+{
+	return (mutex->state & osMutexPrioInherit) == 0;
+}
+
+static k_tid_t mutex_owner(struct cv2_mutex *mutex)
+{
+	return is_fast(mutex) ? mutex->fast_owner : mutex->z_mutex.owner;
+}
+
+static u32_t mutex_lock_count(struct cv2_mutex *mutex)
+{
+	return is_fast(mutex) ? mutex->fast_lock_count :
+		mutex->z_mutex.lock_count;
+}
+
+static int mutex_lock(struct cv2_mutex *mutex, s32_t timeout)
+{
+	int status;
+
+	if (!is_fast(mutex)) {
+		return k_mutex_lock(&mutex->z_mutex, timeout);
+	}
+
+	if (mutex->fast_owner == _current) {
+		mutex->fast_lock_count++;
+		return 0;
+	}
+
+	status = sys_mutex_lock(&mutex->fast_mutex, timeout);
+	if (status == 0) {
+		mutex->fast_owner = _current;
+		mutex->fast_lock_count = 1U;
+	}
+
+	return status;
+}
+
+static void mutex_unlock(struct cv2_mutex *mutex)
+{
+	if (!is_fast(mutex)) {
+		k_mutex_unlock(&mutex->z_mutex);
+		return;
+	}
+
+	mutex->fast_lock_count--;
+	if (mutex->fast_lock_count == 0U) {
+		mutex->fast_owner = NULL;
+		sys_mutex_unlock(&mutex->fast_mutex);
+	}
+}
+
 /**
  * @brief Create and Initialize a Mutex object.
  */
@@ -32,9 +88,6 @@ osMutexId_t osMutexNew(const osMutexAttr_t *attr)
 		attr = &init_mutex_attrs;
 	}
 
-	__ASSERT(attr->attr_bits & osMutexPrioInherit,
-		 "Zephyr supports osMutexPrioInherit by default. Do not unselect it\n");
-
 	__ASSERT(!(attr->attr_bits & osMutexRobust),
 		 "Zephyr does not support osMutexRobust.\n");
 
@@ -45,6 +98,7 @@ osMutexId_t osMutexNew(const osMutexAttr_t *attr)
 	}
 
 	k_mutex_init(&mutex->z_mutex);
+	sys_mutex_init(&mutex->fast_mutex);
 	mutex->state = attr->attr_bits;
 
 	if (attr->name == NULL) {
@@ -73,27 +127,22 @@ osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout)
 		return osErrorISR;
 	}
 
-	if (mutex->z_mutex.lock_count == 0 ||
-	    mutex->z_mutex.owner == _current) {
-	}
-
 	/* Throw an error if the mutex is not configured to be recursive and
 	 * the current thread is trying to acquire the mutex again.
 	 */
 	if ((mutex->state & osMutexRecursive) == 0) {
-		if ((mutex->z_mutex.owner == _current) &&
-		    (mutex->z_mutex.lock_count != 0)) {
+		if ((mutex_owner(mutex) == _current) &&
+		    (mutex_lock_count(mutex) != 0)) {
 			return osErrorResource;
 		}
 	}
 
 	if (timeout == osWaitForever) {
-		status = k_mutex_lock(&mutex->z_mutex, K_FOREVER);
+		status = mutex_lock(mutex, K_FOREVER);
 	} else if (timeout == 0) {
-		status = k_mutex_lock(&mutex->z_mutex, K_NO_WAIT);
+		status = mutex_lock(mutex, K_NO_WAIT);
 	} else {
-		status = k_mutex_lock(&mutex->z_mutex,
-				      __ticks_to_ms(timeout));
+		status = mutex_lock(mutex, __ticks_to_ms(timeout));
 	}
 
 	if (status == -EBUSY) {
@@ -121,12 +170,12 @@ osStatus_t osMutexRelease(osMutexId_t mutex_id)
 	}
 
 	/* Mutex was not obtained before or was not owned by current thread */
-	if ((mutex->z_mutex.lock_count == 0) ||
-	    (mutex->z_mutex.owner != _current)) {
+	if ((mutex_lock_count(mutex) == 0) ||
+	    (mutex_owner(mutex) != _current)) {
 		return osErrorResource;
 	}
 
-	k_mutex_unlock(&mutex->z_mutex);
+	mutex_unlock(mutex);
 
 	return osOK;
 }
@@ -165,11 +214,11 @@ osThreadId_t osMutexGetOwner(osMutexId_t mutex_id)
 	}
 
 	/* Mutex was not obtained before */
-	if (mutex->z_mutex.lock_count == 0) {
+	if (mutex_lock_count(mutex) == 0) {
 		return NULL;
 	}
 
-	return get_cmsis_thread_id(mutex->z_mutex.owner);
+	return get_cmsis_thread_id(mutex_owner(mutex));
 }
 
 const char *osMutexGetName(osMutexId_t mutex_id)
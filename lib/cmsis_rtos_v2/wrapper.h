@@ -8,6 +8,7 @@
 #define __WRAPPER_H__
 
 #include <kernel.h>
+#include <misc/mutex.h>
 #include <cmsis_os2.h>
 
 #define TRUE    1
@@ -36,6 +37,10 @@ struct cv2_timer {
 
 struct cv2_mutex {
 	struct k_mutex z_mutex;
+	/* Used instead of z_mutex when priority inheritance is not needed */
+	struct sys_mutex fast_mutex;
+	k_tid_t fast_owner;
+	u32_t fast_lock_count;
 	char name[16];
 	u32_t state;
 };
@@ -9,6 +9,10 @@
 #include <init.h>
 #include <errno.h>
 #include <misc/mempool.h>
+#ifdef CONFIG_MINIMAL_LIBC_MALLOC_TLSF
+#include <misc/tlsf.h>
+#endif
+#include <misc/mem_stats.h>
 #include <string.h>
 #include <app_memory/app_memdomain.h>
 
@@ -20,6 +24,15 @@ LOG_MODULE_DECLARE(os);
 K_APPMEM_PARTITION_DEFINE(z_malloc_partition);
 #endif
 
+#if defined(CONFIG_SYS_MEM_STATS) && (CONFIG_SYS_MEM_STATS_SITES > 0)
+#define MALLOC_SITES 1
+#define MALLOC_CALLER() __builtin_return_address(0)
+#define MALLOC_HDR_SIZE _SYS_MEM_SITES_HDR_SIZE
+#else
+#define MALLOC_CALLER() NULL
+#define MALLOC_HDR_SIZE 0
+#endif
+
 #if (CONFIG_MINIMAL_LIBC_MALLOC_ARENA_SIZE > 0)
 #ifdef CONFIG_APP_SHARED_MEM
 #define POOL_SECTION K_APP_DMEM_SECTION(z_malloc_partition)
@@ -28,21 +41,130 @@ K_APPMEM_PARTITION_DEFINE(z_malloc_partition);
 #endif /* CONFIG_APP_SHARED_MEM */
 
 K_MUTEX_DEFINE(malloc_mutex);
+
+#ifdef MALLOC_SITES
+/* Protected by malloc_mutex */
+_GENERIC_SECTION(POOL_SECTION) static struct _sys_mem_sites z_malloc_sites;
+#endif
+
+#ifdef CONFIG_MINIMAL_LIBC_MALLOC_TLSF
+#define MALLOC_TLSF 1
+
+BUILD_ASSERT_MSG(CONFIG_MINIMAL_LIBC_MALLOC_ARENA_SIZE <
+		 (1 << CONFIG_SYS_TLSF_MAX_BLOCK_LOG2),
+		 "malloc arena too large, raise SYS_TLSF_MAX_BLOCK_LOG2");
+
+char __aligned(sizeof(void *)) _GENERIC_SECTION(POOL_SECTION)
+	z_malloc_arena[CONFIG_MINIMAL_LIBC_MALLOC_ARENA_SIZE];
+_GENERIC_SECTION(POOL_SECTION) struct sys_tlsf z_malloc_heap;
+
+static void *arena_alloc(size_t size)
+{
+	void *ret;
+
+	k_mutex_lock(&malloc_mutex, K_FOREVER);
+	ret = sys_tlsf_alloc(&z_malloc_heap, size);
+	k_mutex_unlock(&malloc_mutex);
+
+	return ret;
+}
+
+static void arena_free(void *ptr)
+{
+	k_mutex_lock(&malloc_mutex, K_FOREVER);
+	sys_tlsf_free(&z_malloc_heap, ptr);
+	k_mutex_unlock(&malloc_mutex);
+}
+#else
 SYS_MEM_POOL_DEFINE(z_malloc_mem_pool, &malloc_mutex, 16,
 		    CONFIG_MINIMAL_LIBC_MALLOC_ARENA_SIZE, 1, 4, POOL_SECTION);
 
-void *malloc(size_t size)
+static void *arena_alloc(size_t size)
+{
+	return sys_mem_pool_alloc(&z_malloc_mem_pool, size);
+}
+
+static void arena_free(void *ptr)
+{
+	sys_mem_pool_free(ptr);
+}
+#endif
+
+static void *malloc_site(size_t size, const void *site)
 {
 	void *ret;
 
-	ret = sys_mem_pool_alloc(&z_malloc_mem_pool, size);
+#ifdef MALLOC_SITES
+	if (size > UINT32_MAX - MALLOC_HDR_SIZE) {
+		errno = ENOMEM;
+		return NULL;
+	}
+#endif
+
+	ret = arena_alloc(size + MALLOC_HDR_SIZE);
 	if (ret == NULL) {
 		errno = ENOMEM;
+		return NULL;
 	}
 
+#ifdef MALLOC_SITES
+	k_mutex_lock(&malloc_mutex, K_FOREVER);
+	ret = _sys_mem_sites_track(&z_malloc_sites, ret, size, site);
+	k_mutex_unlock(&malloc_mutex);
+#else
+	ARG_UNUSED(site);
+#endif
+
 	return ret;
 }
 
+void free(void *ptr)
+{
+	if (ptr == NULL) {
+		return;
+	}
+
+#ifdef MALLOC_SITES
+	k_mutex_lock(&malloc_mutex, K_FOREVER);
+	ptr = _sys_mem_sites_untrack(&z_malloc_sites, ptr);
+	k_mutex_unlock(&malloc_mutex);
+#endif
+
+	arena_free(ptr);
+}
+
+#ifdef CONFIG_SYS_MEM_STATS
+int sys_malloc_stats_get(struct sys_mem_stats *stats)
+{
+#ifdef MALLOC_TLSF
+	k_mutex_lock(&malloc_mutex, K_FOREVER);
+	sys_tlsf_stats_get(&z_malloc_heap, stats);
+	k_mutex_unlock(&malloc_mutex);
+#else
+	sys_mem_pool_stats_get(&z_malloc_mem_pool, stats);
+#endif
+
+	return 0;
+}
+#endif
+
+#ifdef MALLOC_SITES
+void sys_malloc_sites_foreach(sys_mem_site_cb_t cb, void *user_data)
+{
+	for (int i = 0; i < CONFIG_SYS_MEM_STATS_SITES; i++) {
+		struct sys_mem_site site;
+
+		k_mutex_lock(&malloc_mutex, K_FOREVER);
+		site = z_malloc_sites.sites[i];
+		k_mutex_unlock(&malloc_mutex);
+
+		if (site.site != NULL) {
+			cb(&site, user_data);
+		}
+	}
+}
+#endif
+
 static int malloc_prepare(struct device *unused)
 {
 	ARG_UNUSED(unused);
@@ -50,29 +172,56 @@ static int malloc_prepare(struct device *unused)
 #ifdef CONFIG_USERSPACE
 	k_object_access_all_grant(&malloc_mutex);
 #endif
+#ifdef MALLOC_TLSF
+	sys_tlsf_init(&z_malloc_heap, z_malloc_arena, sizeof(z_malloc_arena));
+#else
 	sys_mem_pool_init(&z_malloc_mem_pool);
+#endif
 
 	return 0;
 }
 
 SYS_INIT(malloc_prepare, APPLICATION, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
 #else /* No malloc arena */
-void *malloc(size_t size)
+static void *malloc_site(size_t size, const void *site)
 {
 	ARG_UNUSED(size);
+	ARG_UNUSED(site);
 
 	LOG_DBG("CONFIG_MINIMAL_LIBC_MALLOC_ARENA_SIZE is 0");
 	errno = ENOMEM;
 
 	return NULL;
 }
-#endif
 
 void free(void *ptr)
 {
 	sys_mem_pool_free(ptr);
 }
 
+#ifdef CONFIG_SYS_MEM_STATS
+int sys_malloc_stats_get(struct sys_mem_stats *stats)
+{
+	ARG_UNUSED(stats);
+
+	return -ENOTSUP;
+}
+#endif
+
+#ifdef MALLOC_SITES
+void sys_malloc_sites_foreach(sys_mem_site_cb_t cb, void *user_data)
+{
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+}
+#endif
+#endif
+
+void *malloc(size_t size)
+{
+	return malloc_site(size, MALLOC_CALLER());
+}
+
 static bool size_t_mul_overflow(size_t a, size_t b, size_t *res)
 {
 #if __SIZEOF_SIZE_T__ == 4
@@ -94,7 +243,7 @@ void *calloc(size_t nmemb, size_t size)
 		return NULL;
 	}
 
-	ret = malloc(size);
+	ret = malloc_site(size, MALLOC_CALLER());
 
 	if (ret != NULL) {
 		(void)memset(ret, 0, size);
@@ -103,42 +252,54 @@ void *calloc(size_t nmemb, size_t size)
 	return ret;
 }
 
-void *realloc(void *ptr, size_t requested_size)
+/* Bytes usable at ptr, most likely a bit more than was requested */
+static size_t usable_size(void *ptr)
 {
-	struct sys_mem_pool_block *blk;
-	size_t block_size, total_requested_size;
-	void *new_ptr;
+	/* Site tracking header, if any, is not usable */
+	ptr = (char *)ptr - MALLOC_HDR_SIZE;
 
-	if (requested_size == 0) {
-		return NULL;
-	}
+#ifdef MALLOC_TLSF
+	return sys_tlsf_usable_size(ptr) - MALLOC_HDR_SIZE;
+#else
+	struct sys_mem_pool_block *blk;
+	size_t block_size;
 
 	/* Stored right before the pointer passed to the user */
 	blk = (struct sys_mem_pool_block *)((char *)ptr - sizeof(*blk));
 
-	/* Determine size of previously allocated block by its level.
-	 * Most likely a bit larger than the original allocation
-	 */
+	/* Determine size of previously allocated block by its level */
 	block_size = _ALIGN4(blk->pool->base.max_sz);
 	for (int i = 1; i <= blk->level; i++) {
 		block_size = _ALIGN4(block_size / 4);
 	}
 
-	/* We really need this much memory */
-	total_requested_size = requested_size +
-		sizeof(struct sys_mem_pool_block);
+	return block_size - sizeof(struct sys_mem_pool_block) -
+	       MALLOC_HDR_SIZE;
+#endif
+}
+
+void *realloc(void *ptr, size_t requested_size)
+{
+	size_t block_size;
+	void *new_ptr;
+
+	if (requested_size == 0) {
+		return NULL;
+	}
+
+	block_size = usable_size(ptr);
 
-	if (block_size >= total_requested_size) {
+	if (block_size >= requested_size) {
 		/* Existing block large enough, nothing to do */
 		return ptr;
 	}
 
-	new_ptr = malloc(requested_size);
+	new_ptr = malloc_site(requested_size, MALLOC_CALLER());
 	if (new_ptr == NULL) {
 		return NULL;
 	}
 
-	memcpy(new_ptr, ptr, block_size - sizeof(struct sys_mem_pool_block));
+	memcpy(new_ptr, ptr, block_size);
 	free(ptr);
 
 	return new_ptr;
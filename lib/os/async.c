@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <errno.h>
+#include <spinlock.h>
+#include <misc/async.h>
+#ifdef CONFIG_NET_SOCKETS
+#include <misc/fdtable.h>
+#include <net/socket.h>
+#endif
+
+#define ASYNC_THREAD_NAME	"async"
+
+#define NO_DEADLINE		INT64_MAX
+
+void _sys_async_set_timeout(struct sys_async *task, s32_t timeout)
+{
+	task->result = 0;
+	task->deadline = (timeout == K_FOREVER) ? NO_DEADLINE :
+			 k_uptime_get() + timeout;
+}
+
+void _sys_async_wait_event(struct sys_async *task, u32_t type, void *obj)
+{
+	if (type == K_POLL_TYPE_IGNORE) {
+		task->event.type = K_POLL_TYPE_IGNORE;
+	} else {
+		k_poll_event_init(&task->event, type, K_POLL_MODE_NOTIFY_ONLY,
+				  obj);
+	}
+}
+
+#ifdef CONFIG_NET_SOCKETS
+int _sys_async_wait_fd(struct sys_async *task, int fd, int events)
+{
+	struct zsock_pollfd pfd = { .fd = fd, .events = events };
+	struct k_poll_event *pev = &task->event;
+	const struct fd_op_vtable *vtable;
+	void *obj;
+
+	obj = z_get_fd_obj_and_vtable(fd, &vtable);
+	if (obj == NULL) {
+		task->result = -errno;
+		return task->result;
+	}
+
+	if (z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_PREPARE,
+				 &pfd, &pev, pev + 1) < 0) {
+		/* EALREADY: ready right away */
+		task->result = (errno == EALREADY) ? 0 : -errno;
+		return 1;
+	}
+
+	if (pev == &task->event) {
+		/* Nothing to wait for, e.g. POLLOUT which is always
+		 * reported
+		 */
+		return 1;
+	}
+
+	return 0;
+}
+#else
+int _sys_async_wait_fd(struct sys_async *task, int fd, int events)
+{
+	task->result = -ENOTSUP;
+	return task->result;
+}
+#endif
+
+int sys_async_spawn(struct sys_async_runtime *rt, struct sys_async *task,
+		    sys_async_fn_t fn)
+{
+	k_spinlock_key_t key = k_spin_lock(&rt->lock);
+
+	if (task->rt != NULL) {
+		k_spin_unlock(&rt->lock, key);
+		return -EBUSY;
+	}
+
+	task->fn = fn;
+	task->rt = rt;
+	task->resume = 0U;
+	task->result = 0;
+	sys_dlist_append(&rt->spawned, &task->node);
+
+	k_spin_unlock(&rt->lock, key);
+
+	(void)k_poll_signal_raise(&rt->wake, 0);
+
+	return 0;
+}
+
+static void suspend(struct sys_async_runtime *rt, struct sys_async *task)
+{
+	if (task->event.type == K_POLL_TYPE_IGNORE) {
+		sys_dlist_append(&rt->sleeping, &task->node);
+	} else if (rt->num_waiting == rt->max_waiting) {
+		task->result = -ENOMEM;
+		sys_dlist_append(&rt->ready, &task->node);
+	} else {
+		rt->events[rt->num_waiting + 1] = task->event;
+		rt->waiting[rt->num_waiting++] = task;
+	}
+}
+
+static void done(struct sys_async_runtime *rt, struct sys_async *task)
+{
+	k_spinlock_key_t key = k_spin_lock(&rt->lock);
+
+	task->rt = NULL;
+
+	k_spin_unlock(&rt->lock, key);
+}
+
+static void run_ready(struct sys_async_runtime *rt)
+{
+	sys_dlist_t run;
+	sys_dnode_t *node;
+
+	/* Tasks yielding now go after the new events */
+	sys_dlist_init(&run);
+	while ((node = sys_dlist_get(&rt->ready)) != NULL) {
+		sys_dlist_append(&run, node);
+	}
+
+	while ((node = sys_dlist_get(&run)) != NULL) {
+		struct sys_async *task = CONTAINER_OF(node, struct sys_async,
+						      node);
+
+		switch (task->fn(task)) {
+		case _SYS_ASYNC_YIELD:
+			sys_dlist_append(&rt->ready, &task->node);
+			break;
+		case _SYS_ASYNC_WAIT:
+			suspend(rt, task);
+			break;
+		default:
+			done(rt, task);
+			break;
+		}
+	}
+}
+
+static s32_t next_timeout(struct sys_async_runtime *rt)
+{
+	s64_t deadline = NO_DEADLINE;
+	struct sys_async *task;
+	s64_t delay;
+
+	if (!sys_dlist_is_empty(&rt->ready)) {
+		return K_NO_WAIT;
+	}
+
+	for (int i = 0; i < rt->num_waiting; i++) {
+		deadline = MIN(deadline, rt->waiting[i]->deadline);
+	}
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&rt->sleeping, task, node) {
+		deadline = MIN(deadline, task->deadline);
+	}
+
+	if (deadline == NO_DEADLINE) {
+		return K_FOREVER;
+	}
+
+	delay = deadline - k_uptime_get();
+
+	return (s32_t)MIN(MAX(delay, 0), INT32_MAX);
+}
+
+/* Move the tasks whose wait is over to the ready list */
+static void collect(struct sys_async_runtime *rt)
+{
+	s64_t now = k_uptime_get();
+	struct sys_async *task, *next;
+	k_spinlock_key_t key;
+	sys_dnode_t *node;
+
+	for (int i = 0; i < rt->num_waiting; ) {
+		struct k_poll_event *event = &rt->events[i + 1];
+
+		task = rt->waiting[i];
+		if (event->state & K_POLL_STATE_CANCELLED) {
+			task->result = -EINTR;
+		} else if (event->state != K_POLL_STATE_NOT_READY) {
+			task->result = 0;
+		} else if (task->deadline <= now) {
+			task->result = -EAGAIN;
+		} else {
+			i++;
+			continue;
+		}
+
+		task->event.state = event->state;
+		sys_dlist_append(&rt->ready, &task->node);
+
+		rt->num_waiting--;
+		rt->waiting[i] = rt->waiting[rt->num_waiting];
+		*event = rt->events[rt->num_waiting + 1];
+	}
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&rt->sleeping, task, next, node) {
+		if (task->deadline <= now) {
+			task->result = -EAGAIN;
+			sys_dlist_remove(&task->node);
+			sys_dlist_append(&rt->ready, &task->node);
+		}
+	}
+
+	if (rt->events[0].state != K_POLL_STATE_NOT_READY) {
+		rt->events[0].state = K_POLL_STATE_NOT_READY;
+		k_poll_signal_reset(&rt->wake);
+
+		key = k_spin_lock(&rt->lock);
+		while ((node = sys_dlist_get(&rt->spawned)) != NULL) {
+			sys_dlist_append(&rt->ready, node);
+		}
+		k_spin_unlock(&rt->lock, key);
+	}
+}
+
+static void async_main(void *p1, void *p2, void *p3)
+{
+	struct sys_async_runtime *rt = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		run_ready(rt);
+
+		(void)k_poll(rt->events, rt->num_waiting + 1,
+			     next_timeout(rt));
+
+		collect(rt);
+	}
+}
+
+void sys_async_runtime_start(struct sys_async_runtime *rt,
+			     struct k_poll_event *events,
+			     struct sys_async **waiting, int max_waiting,
+			     k_thread_stack_t *stack, size_t stack_size,
+			     int prio)
+{
+	k_poll_signal_init(&rt->wake);
+	sys_dlist_init(&rt->spawned);
+	sys_dlist_init(&rt->ready);
+	sys_dlist_init(&rt->sleeping);
+	rt->events = events;
+	rt->waiting = waiting;
+	rt->num_waiting = 0;
+	rt->max_waiting = max_waiting;
+
+	k_poll_event_init(&events[0], K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &rt->wake);
+
+	(void)k_thread_create(&rt->thread, stack, stack_size, async_main, rt,
+			      NULL, NULL, prio, 0, 0);
+	k_thread_name_set(&rt->thread, ASYNC_THREAD_NAME);
+}
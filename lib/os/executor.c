@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <errno.h>
+#include <limits.h>
+#include <spinlock.h>
+#include <misc/executor.h>
+
+#define EXECUTOR_THREAD_NAME	"executor"
+
+int sys_future_wait(struct sys_future *future, int *result, s32_t timeout)
+{
+	struct k_poll_event event;
+	int ret;
+
+	sys_future_poll_event(&event, future);
+	ret = k_poll(&event, 1, timeout);
+	if (ret != 0) {
+		return ret;
+	}
+
+	(void)sys_future_is_done(future, result);
+	return 0;
+}
+
+static void push(struct sys_executor_worker *worker, struct sys_task *task,
+		 int prio, bool front)
+{
+	k_spinlock_key_t key = k_spin_lock(&worker->lock);
+
+	if (front) {
+		sys_dlist_prepend(&worker->deque[prio], &task->node);
+	} else {
+		sys_dlist_append(&worker->deque[prio], &task->node);
+	}
+	worker->ready |= BIT(prio);
+
+	k_spin_unlock(&worker->lock, key);
+}
+
+/* Take the highest priority task of @a worker, from the front of its
+ * deque for the worker itself, from the back for a thief
+ */
+static struct sys_task *pop(struct sys_executor_worker *worker, bool front)
+{
+	k_spinlock_key_t key = k_spin_lock(&worker->lock);
+	struct sys_task *task = NULL;
+	sys_dnode_t *node;
+	int prio;
+
+	if (worker->ready != 0U) {
+		prio = find_lsb_set(worker->ready) - 1;
+		node = front ? sys_dlist_peek_head(&worker->deque[prio]) :
+			       sys_dlist_peek_tail(&worker->deque[prio]);
+		sys_dlist_remove(node);
+		if (sys_dlist_is_empty(&worker->deque[prio])) {
+			worker->ready &= ~BIT(prio);
+		}
+		task = CONTAINER_OF(node, struct sys_task, node);
+	}
+
+	k_spin_unlock(&worker->lock, key);
+
+	return task;
+}
+
+static struct sys_task *next_task(struct sys_executor_worker *self)
+{
+	struct sys_executor *exec = self->exec;
+	int id = self - exec->workers;
+	struct sys_task *task;
+
+	/* The semaphore count taken by the caller guarantees there is a
+	 * task for it somewhere, but a thief may take the one it was
+	 * about to find, in which case another one has been queued
+	 * meanwhile: keep looking.
+	 */
+	while (true) {
+		task = pop(self, true);
+		if (task != NULL) {
+			return task;
+		}
+
+		for (int i = 1; i < exec->num_workers; i++) {
+			task = pop(&exec->workers[(id + i) % exec->num_workers],
+				   false);
+			if (task != NULL) {
+				return task;
+			}
+		}
+	}
+}
+
+static void executor_main(void *p1, void *p2, void *p3)
+{
+	struct sys_executor_worker *self = p1;
+	struct sys_task *task;
+	k_spinlock_key_t key;
+	int result;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_sem_take(&self->exec->pending, K_FOREVER);
+
+		task = next_task(self);
+		result = task->handler(task);
+
+		/* Done under the lock taken by sys_executor_submit(), so
+		 * that the task cannot be resubmitted, and its future
+		 * reset, before this run's result is in.  Whoever waits
+		 * for the future may free the task as soon as it
+		 * completes, so it must be the last thing touched.
+		 */
+		key = k_spin_lock(&self->exec->lock);
+		atomic_clear(&task->busy);
+		sys_future_complete(&task->future, result);
+		k_spin_unlock(&self->exec->lock, key);
+
+		/* Make sure we don't hog the CPU */
+		k_yield();
+	}
+}
+
+void sys_executor_start(struct sys_executor *exec,
+			struct sys_executor_worker *workers, int num_workers,
+			k_thread_stack_t *stacks, size_t stack_stride,
+			size_t stack_size, int prio)
+{
+	__ASSERT(num_workers > 0, "");
+
+	exec->workers = workers;
+	exec->num_workers = num_workers;
+	atomic_clear(&exec->next);
+	k_sem_init(&exec->pending, 0, UINT_MAX);
+
+	for (int i = 0; i < num_workers; i++) {
+		struct sys_executor_worker *worker = &workers[i];
+
+		worker->exec = exec;
+		worker->ready = 0U;
+		for (int p = 0; p < CONFIG_SYS_EXECUTOR_PRIORITIES; p++) {
+			sys_dlist_init(&worker->deque[p]);
+		}
+	}
+
+	/* Only start the threads once all the deques are ready to be
+	 * stolen from
+	 */
+	for (int i = 0; i < num_workers; i++) {
+		k_thread_stack_t *stack = (k_thread_stack_t *)
+			((char *)stacks + i * stack_stride);
+
+		(void)k_thread_create(&workers[i].thread, stack, stack_size,
+				      executor_main, &workers[i], NULL, NULL,
+				      prio, 0, 0);
+		k_thread_name_set(&workers[i].thread, EXECUTOR_THREAD_NAME);
+	}
+}
+
+static struct sys_executor_worker *current_worker(struct sys_executor *exec)
+{
+	k_tid_t current = k_current_get();
+
+	for (int i = 0; i < exec->num_workers; i++) {
+		if (&exec->workers[i].thread == current) {
+			return &exec->workers[i];
+		}
+	}
+
+	return NULL;
+}
+
+int sys_executor_submit(struct sys_executor *exec, struct sys_task *task,
+			int prio)
+{
+	struct sys_executor_worker *worker;
+	k_spinlock_key_t key;
+
+	if (prio < 0 || prio >= CONFIG_SYS_EXECUTOR_PRIORITIES) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&exec->lock);
+
+	if (!atomic_cas(&task->busy, 0, 1)) {
+		k_spin_unlock(&exec->lock, key);
+		return -EBUSY;
+	}
+
+	sys_future_init(&task->future);
+
+	k_spin_unlock(&exec->lock, key);
+
+	worker = k_is_in_isr() ? NULL : current_worker(exec);
+	if (worker != NULL) {
+		push(worker, task, prio, true);
+	} else {
+		worker = &exec->workers[(u32_t)atomic_inc(&exec->next) %
+					exec->num_workers];
+		push(worker, task, prio, false);
+	}
+
+	k_sem_give(&exec->pending);
+
+	return 0;
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/types.h>
+#include <misc/mem_stats.h>
+
+#if CONFIG_SYS_MEM_STATS_SITES > 0
+
+#define NUM_SITES CONFIG_SYS_MEM_STATS_SITES
+#define NO_SITE 0xffffffffU
+
+/* Open-addressed table keyed by call site.  Entries are never removed,
+ * so a site keeps its slot (and its history) once it has allocated.
+ */
+static u32_t site_index(struct _sys_mem_sites *t, const void *site)
+{
+	u32_t i = ((uintptr_t)site >> 2) % NUM_SITES;
+
+	for (int n = 0; n < NUM_SITES; n++) {
+		struct sys_mem_site *s = &t->sites[i];
+
+		if (s->site == site) {
+			return i;
+		}
+
+		if (s->site == NULL) {
+			s->site = site;
+			return i;
+		}
+
+		i = (i + 1) % NUM_SITES;
+	}
+
+	return NO_SITE;
+}
+
+void *_sys_mem_sites_track(struct _sys_mem_sites *t, void *mem,
+			   size_t size, const void *site)
+{
+	struct _sys_mem_site_hdr *hdr = mem;
+	u32_t i = site_index(t, site);
+
+	hdr->index = i;
+	hdr->size = size;
+
+	if (i != NO_SITE) {
+		struct sys_mem_site *s = &t->sites[i];
+
+		s->allocs++;
+		s->live++;
+		s->live_bytes += size;
+		if (s->live_bytes > s->max_live_bytes) {
+			s->max_live_bytes = s->live_bytes;
+		}
+	} else {
+		t->dropped++;
+	}
+
+	return hdr + 1;
+}
+
+void *_sys_mem_sites_untrack(struct _sys_mem_sites *t, void *ptr)
+{
+	struct _sys_mem_site_hdr *hdr = (struct _sys_mem_site_hdr *)ptr - 1;
+
+	if (hdr->index != NO_SITE) {
+		struct sys_mem_site *s = &t->sites[hdr->index];
+
+		s->live--;
+		s->live_bytes -= hdr->size;
+	}
+
+	return hdr;
+}
+
+#endif /* CONFIG_SYS_MEM_STATS_SITES > 0 */
@@ -9,6 +9,7 @@
 #include <misc/__assert.h>
 #include <misc/mempool_base.h>
 #include <misc/mempool.h>
+#include <misc/mem_stats.h>
 
 static bool level_empty(struct sys_mem_pool_base *p, int l)
 {
@@ -192,6 +193,9 @@ static void block_free(struct sys_mem_pool_base *p, int level,
 {
 	unsigned int key = pool_irq_lock(p);
 
+#ifdef CONFIG_SYS_MEM_STATS
+	p->allocated -= lsizes[level];
+#endif
 	key = bfree_recombine(p, level, lsizes, bn, key);
 	pool_irq_unlock(p, key);
 }
@@ -286,6 +290,14 @@ int _sys_mem_pool_block_alloc(struct sys_mem_pool_base *p, size_t size,
 			break;
 		}
 	}
+#ifdef CONFIG_SYS_MEM_STATS
+	if (data != NULL) {
+		p->allocated += lsizes[alloc_l];
+		if (p->allocated > p->max_allocated) {
+			p->max_allocated = p->allocated;
+		}
+	}
+#endif
 	pool_irq_unlock(p, key);
 
 	*level_p = alloc_l;
@@ -315,6 +327,30 @@ void _sys_mem_pool_block_free(struct sys_mem_pool_base *p, u32_t level,
 	block_free(p, level, lsizes, block);
 }
 
+#ifdef CONFIG_SYS_MEM_STATS
+void _sys_mem_pool_base_stats(struct sys_mem_pool_base *p,
+			      struct sys_mem_stats *stats)
+{
+	size_t lsz = _ALIGN4(p->max_sz);
+	unsigned int key = pool_irq_lock(p);
+
+	stats->total_bytes = buf_size(p);
+	stats->allocated_bytes = p->allocated;
+	stats->max_allocated_bytes = p->max_allocated;
+	stats->largest_free_bytes = 0;
+
+	for (int i = 0; i < p->n_levels; i++) {
+		if (!level_empty(p, i)) {
+			stats->largest_free_bytes = lsz;
+			break;
+		}
+		lsz = _ALIGN4(lsz / 4);
+	}
+
+	pool_irq_unlock(p, key);
+}
+#endif
+
 /*
  * Functions specific to user-mode blocks
  */
@@ -361,3 +397,12 @@ void sys_mem_pool_free(void *ptr)
 	k_mutex_unlock(p->mutex);
 }
 
+#ifdef CONFIG_SYS_MEM_STATS
+void sys_mem_pool_stats_get(struct sys_mem_pool *p,
+			    struct sys_mem_stats *stats)
+{
+	k_mutex_lock(p->mutex, K_FOREVER);
+	_sys_mem_pool_base_stats(&p->base, stats);
+	k_mutex_unlock(p->mutex);
+}
+#endif
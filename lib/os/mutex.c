@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <errno.h>
+#include <misc/mutex.h>
+
+int sys_mutex_lock(struct sys_mutex *mutex, s32_t timeout)
+{
+	atomic_t *val = &mutex->futex.val;
+	s64_t end = 0;
+
+	if (likely(atomic_cas(val, _SYS_MUTEX_UNLOCKED, _SYS_MUTEX_LOCKED))) {
+		return 0;
+	}
+
+	if (timeout == K_NO_WAIT) {
+		return -EBUSY;
+	}
+
+	if (timeout != K_FOREVER) {
+		end = k_uptime_get() + timeout;
+	}
+
+	/* Whoever gets the mutex on the slow path leaves it marked as
+	 * contended, since it cannot know whether other threads still
+	 * wait; at worst this costs one spurious wakeup on unlock.
+	 */
+	while (atomic_set(val, _SYS_MUTEX_CONTENDED) != _SYS_MUTEX_UNLOCKED) {
+		if (timeout != K_FOREVER) {
+			timeout = (s32_t)MAX(end - k_uptime_get(), 0);
+		}
+
+		if (k_futex_wait(&mutex->futex, _SYS_MUTEX_CONTENDED,
+				 timeout) == -ETIMEDOUT) {
+			return -EAGAIN;
+		}
+	}
+
+	return 0;
+}
+
+void sys_mutex_unlock(struct sys_mutex *mutex)
+{
+	atomic_val_t old = atomic_set(&mutex->futex.val, _SYS_MUTEX_UNLOCKED);
+
+	if (unlikely(old == _SYS_MUTEX_CONTENDED)) {
+		k_futex_wake(&mutex->futex, false);
+	}
+}
@@ -106,11 +106,42 @@ static inline u32_t wrap(u32_t val, u32_t max)
 	return val >= max ? (val - max) : val;
 }
 
+/*
+ * In byte mode the producer owns tail and tmp_tail and the consumer owns
+ * head and tmp_head.  Each side reads the other's index with acquire
+ * semantics, so the data it covers is visible, and publishes its own
+ * with release semantics, after it is done with the data.
+ */
+static inline u32_t load_acquire(u32_t *index)
+{
+	return __atomic_load_n(index, __ATOMIC_ACQUIRE);
+}
+
+static inline void store_release(u32_t *index, u32_t val)
+{
+	__atomic_store_n(index, val, __ATOMIC_RELEASE);
+}
+
+static inline void notify_consumer(struct ring_buf *buf)
+{
+#ifdef CONFIG_POLL
+	if (buf->signal != NULL) {
+		/* Pairs with the barrier in ring_buf_wait(): either the
+		 * consumer sees the new tail or we see it waiting.
+		 */
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		if (__atomic_load_n(&buf->waiting, __ATOMIC_RELAXED) != 0U) {
+			k_poll_signal_raise(buf->signal, 0);
+		}
+	}
+#endif
+}
+
 u32_t ring_buf_put_claim(struct ring_buf *buf, u8_t **data, u32_t size)
 {
 	u32_t space, trail_size, allocated;
 
-	space = z_ring_buf_custom_space_get(buf->size, buf->head,
+	space = z_ring_buf_custom_space_get(buf->size, load_acquire(&buf->head),
 					    buf->misc.byte_mode.tmp_tail);
 
 	/* Limit requested size to available size. */
@@ -129,12 +160,21 @@ u32_t ring_buf_put_claim(struct ring_buf *buf, u8_t **data, u32_t size)
 
 int ring_buf_put_finish(struct ring_buf *buf, u32_t size)
 {
-	if (size > ring_buf_space_get(buf)) {
+	u32_t tail;
+
+	if (size > z_ring_buf_custom_space_get(buf->size,
+					       load_acquire(&buf->head),
+					       buf->tail)) {
 		return -EINVAL;
 	}
 
-	buf->tail = wrap(buf->tail + size, buf->size);
-	buf->misc.byte_mode.tmp_tail = buf->tail;
+	tail = wrap(buf->tail + size, buf->size);
+	buf->misc.byte_mode.tmp_tail = tail;
+	store_release(&buf->tail, tail);
+
+	if (size > 0) {
+		notify_consumer(buf);
+	}
 
 	return 0;
 }
@@ -165,7 +205,7 @@ u32_t ring_buf_get_claim(struct ring_buf *buf, u8_t **data, u32_t size)
 	space = (buf->size - 1) -
 		z_ring_buf_custom_space_get(buf->size,
 					    buf->misc.byte_mode.tmp_head,
-					    buf->tail);
+					    load_acquire(&buf->tail));
 	trail_size = buf->size - buf->misc.byte_mode.tmp_head;
 
 	/* Limit requested size to available size. */
@@ -183,14 +223,18 @@ u32_t ring_buf_get_claim(struct ring_buf *buf, u8_t **data, u32_t size)
 
 int ring_buf_get_finish(struct ring_buf *buf, u32_t size)
 {
-	u32_t allocated = (buf->size - 1) - ring_buf_space_get(buf);
+	u32_t allocated, head;
 
+	allocated = (buf->size - 1) -
+		    z_ring_buf_custom_space_get(buf->size, buf->head,
+						load_acquire(&buf->tail));
 	if (size > allocated) {
 		return -EINVAL;
 	}
 
-	buf->head = wrap(buf->head + size, buf->size);
-	buf->misc.byte_mode.tmp_head = buf->head;
+	head = wrap(buf->head + size, buf->size);
+	buf->misc.byte_mode.tmp_head = head;
+	store_release(&buf->head, head);
 
 	return 0;
 }
@@ -213,3 +257,29 @@ u32_t ring_buf_get(struct ring_buf *buf, u8_t *data, u32_t size)
 
 	return total_size;
 }
+
+#ifdef CONFIG_POLL
+int ring_buf_wait(struct ring_buf *buf, s32_t timeout)
+{
+	struct k_poll_event event;
+	int ret = 0;
+
+	__ASSERT(buf->signal != NULL, "no signal attached");
+
+	k_poll_signal_reset(buf->signal);
+	k_poll_event_init(&event, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+			  buf->signal);
+
+	__atomic_store_n(&buf->waiting, 1U, __ATOMIC_RELAXED);
+	/* Pairs with the barrier in notify_consumer() */
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+	if (load_acquire(&buf->tail) == buf->head) {
+		ret = k_poll(&event, 1, timeout);
+	}
+
+	__atomic_store_n(&buf->waiting, 0U, __ATOMIC_RELAXED);
+
+	return ret;
+}
+#endif
@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/types.h>
+#include <string.h>
+#include <misc/__assert.h>
+#include <misc/tlsf.h>
+#include <misc/mem_stats.h>
+
+/*
+ * Block layout.  A block's payload starts right after its size word.
+ * The prev_phys field overlaps the last word of the previous block's
+ * payload and is only valid while that block is free; likewise the
+ * free list links overlap this block's payload and are only valid
+ * while it is free.  So a used block costs one size word of overhead.
+ */
+struct _tlsf_block {
+	struct _tlsf_block *prev_phys;
+	size_t size;
+	struct _tlsf_block *next_free;
+	struct _tlsf_block *prev_free;
+};
+
+/* The low bits of size are flags; sizes are multiples of ALIGN */
+#define BLOCK_FREE	((size_t)1)
+#define PREV_FREE	((size_t)2)
+
+#define ALIGN		((size_t)1 << _TLSF_ALIGN_LOG2)
+#define OVERHEAD	sizeof(size_t)
+#define START_OFFSET	(offsetof(struct _tlsf_block, size) + sizeof(size_t))
+#define SIZE_MIN	(sizeof(struct _tlsf_block) - \
+			 sizeof(struct _tlsf_block *))
+#define SIZE_MAX_	((size_t)1 << CONFIG_SYS_TLSF_MAX_BLOCK_LOG2)
+#define SMALL_SIZE	((size_t)1 << _TLSF_FL_SHIFT)
+
+typedef struct _tlsf_block block_t;
+
+static inline int fls_size(size_t x)
+{
+	return (sizeof(size_t) == 8) ?
+		63 - __builtin_clzll((unsigned long long)x) :
+		31 - __builtin_clz((unsigned int)x);
+}
+
+static inline int ffs32(u32_t x)
+{
+	return __builtin_ctz(x);
+}
+
+static inline size_t block_size(block_t *b)
+{
+	return b->size & ~(BLOCK_FREE | PREV_FREE);
+}
+
+static inline void block_set_size(block_t *b, size_t size)
+{
+	b->size = size | (b->size & (BLOCK_FREE | PREV_FREE));
+}
+
+static inline bool block_is_free(block_t *b)
+{
+	return (b->size & BLOCK_FREE) != 0;
+}
+
+static inline bool block_is_prev_free(block_t *b)
+{
+	return (b->size & PREV_FREE) != 0;
+}
+
+static inline void *block_to_ptr(block_t *b)
+{
+	return (char *)b + START_OFFSET;
+}
+
+static inline block_t *block_from_ptr(void *ptr)
+{
+	return (block_t *)((char *)ptr - START_OFFSET);
+}
+
+static inline block_t *block_next(block_t *b)
+{
+	return (block_t *)((char *)block_to_ptr(b) + block_size(b) - OVERHEAD);
+}
+
+static inline block_t *block_link_next(block_t *b)
+{
+	block_t *next = block_next(b);
+
+	next->prev_phys = b;
+	return next;
+}
+
+static void block_mark_free(block_t *b)
+{
+	block_t *next = block_link_next(b);
+
+	next->size |= PREV_FREE;
+	b->size |= BLOCK_FREE;
+}
+
+static void block_mark_used(block_t *b)
+{
+	block_t *next = block_next(b);
+
+	next->size &= ~PREV_FREE;
+	b->size &= ~BLOCK_FREE;
+}
+
+static void mapping_insert(size_t size, int *fl, int *sl)
+{
+	if (size < SMALL_SIZE) {
+		*fl = 0;
+		*sl = size / (SMALL_SIZE / _TLSF_SL_COUNT);
+	} else {
+		int f = fls_size(size);
+
+		*sl = (int)(size >> (f - _TLSF_SL_LOG2)) ^ _TLSF_SL_COUNT;
+		*fl = f - (_TLSF_FL_SHIFT - 1);
+	}
+}
+
+/* Like mapping_insert(), but rounds up to the next list so that any
+ * block found there is large enough without a list walk.
+ */
+static void mapping_search(size_t size, int *fl, int *sl)
+{
+	if (size >= SMALL_SIZE) {
+		size += ((size_t)1 << (fls_size(size) - _TLSF_SL_LOG2)) - 1;
+	}
+	mapping_insert(size, fl, sl);
+}
+
+static block_t *search_suitable(struct sys_tlsf *h, int *fl, int *sl)
+{
+	u32_t sl_map = h->sl_bitmap[*fl] & (~0U << *sl);
+
+	if (sl_map == 0U) {
+		u32_t fl_map = h->fl_bitmap & (~0U << (*fl + 1));
+
+		if (fl_map == 0U) {
+			return NULL;
+		}
+
+		*fl = ffs32(fl_map);
+		sl_map = h->sl_bitmap[*fl];
+	}
+
+	*sl = ffs32(sl_map);
+	return h->blocks[*fl][*sl];
+}
+
+static void list_remove(struct sys_tlsf *h, block_t *b, int fl, int sl)
+{
+	block_t *prev = b->prev_free;
+	block_t *next = b->next_free;
+
+	if (next != NULL) {
+		next->prev_free = prev;
+	}
+	if (prev != NULL) {
+		prev->next_free = next;
+	} else {
+		h->blocks[fl][sl] = next;
+		if (next == NULL) {
+			h->sl_bitmap[fl] &= ~(1U << sl);
+			if (h->sl_bitmap[fl] == 0U) {
+				h->fl_bitmap &= ~(1U << fl);
+			}
+		}
+	}
+}
+
+static void list_insert(struct sys_tlsf *h, block_t *b, int fl, int sl)
+{
+	block_t *head = h->blocks[fl][sl];
+
+	b->next_free = head;
+	b->prev_free = NULL;
+	if (head != NULL) {
+		head->prev_free = b;
+	}
+	h->blocks[fl][sl] = b;
+	h->fl_bitmap |= 1U << fl;
+	h->sl_bitmap[fl] |= 1U << sl;
+}
+
+static void block_remove(struct sys_tlsf *h, block_t *b)
+{
+	int fl, sl;
+
+	mapping_insert(block_size(b), &fl, &sl);
+	list_remove(h, b, fl, sl);
+}
+
+static void block_insert(struct sys_tlsf *h, block_t *b)
+{
+	int fl, sl;
+
+	mapping_insert(block_size(b), &fl, &sl);
+	list_insert(h, b, fl, sl);
+}
+
+/* Split off everything past size bytes of payload as a new free
+ * block and put it on the free lists.
+ */
+static void block_trim(struct sys_tlsf *h, block_t *b, size_t size)
+{
+	block_t *rest;
+
+	if (block_size(b) < sizeof(block_t) + size) {
+		return;
+	}
+
+	rest = (block_t *)((char *)block_to_ptr(b) + size - OVERHEAD);
+	rest->size = block_size(b) - (size + OVERHEAD);
+	block_set_size(b, size);
+	block_mark_free(rest);
+	block_link_next(b);
+	rest->size |= PREV_FREE;
+	block_insert(h, rest);
+}
+
+/* Merge b into prev, both physically adjacent */
+static block_t *block_absorb(block_t *prev, block_t *b)
+{
+	prev->size += block_size(b) + OVERHEAD;
+	block_link_next(prev);
+	return prev;
+}
+
+void sys_tlsf_init(struct sys_tlsf *h, void *mem, size_t bytes)
+{
+	size_t pool_bytes = (bytes - 2 * OVERHEAD) & ~(ALIGN - 1);
+	block_t *b, *last;
+
+	__ASSERT(((uintptr_t)mem & (ALIGN - 1)) == 0, "unaligned heap");
+	__ASSERT(pool_bytes >= SIZE_MIN && pool_bytes < SIZE_MAX_,
+		 "heap size out of range, see SYS_TLSF_MAX_BLOCK_LOG2");
+
+	/* A block this large has no free list: leave the excess unused
+	 * rather than index past the end of the control structure.
+	 */
+	if (pool_bytes >= SIZE_MAX_) {
+		pool_bytes = SIZE_MAX_ - ALIGN;
+	}
+
+	(void)memset(h, 0, sizeof(*h));
+	h->start = mem;
+	h->end = (char *)mem + pool_bytes + 2 * OVERHEAD;
+
+	/* The first block starts one word before the memory: its
+	 * prev_phys field is never touched since nothing precedes it.
+	 */
+	b = (block_t *)((char *)mem - OVERHEAD);
+	b->size = pool_bytes | BLOCK_FREE;
+	block_insert(h, b);
+
+	/* Zero-sized, permanently used sentinel stops coalescing */
+	last = block_link_next(b);
+	last->size = PREV_FREE;
+}
+
+void *sys_tlsf_alloc(struct sys_tlsf *h, size_t bytes)
+{
+	size_t size;
+	block_t *b;
+	int fl, sl;
+
+	if (bytes == 0 || bytes >= SIZE_MAX_) {
+		return NULL;
+	}
+
+	size = (bytes + ALIGN - 1) & ~(ALIGN - 1);
+	if (size < SIZE_MIN) {
+		size = SIZE_MIN;
+	}
+
+	mapping_search(size, &fl, &sl);
+	if (fl >= _TLSF_FL_COUNT) {
+		return NULL;
+	}
+
+	b = search_suitable(h, &fl, &sl);
+	if (b == NULL) {
+		return NULL;
+	}
+
+	list_remove(h, b, fl, sl);
+	block_trim(h, b, size);
+	block_mark_used(b);
+
+#ifdef CONFIG_SYS_MEM_STATS
+	h->allocated += block_size(b) + OVERHEAD;
+	if (h->allocated > h->max_allocated) {
+		h->max_allocated = h->allocated;
+	}
+#endif
+
+	return block_to_ptr(b);
+}
+
+void sys_tlsf_free(struct sys_tlsf *h, void *ptr)
+{
+	block_t *b, *next;
+
+	if (ptr == NULL) {
+		return;
+	}
+
+	b = block_from_ptr(ptr);
+	__ASSERT(!block_is_free(b), "double free of %p", ptr);
+
+#ifdef CONFIG_SYS_MEM_STATS
+	h->allocated -= block_size(b) + OVERHEAD;
+#endif
+	block_mark_free(b);
+
+	if (block_is_prev_free(b)) {
+		block_t *prev = b->prev_phys;
+
+		block_remove(h, prev);
+		b = block_absorb(prev, b);
+	}
+
+	next = block_next(b);
+	if (block_is_free(next)) {
+		block_remove(h, next);
+		b = block_absorb(b, next);
+	}
+
+	block_insert(h, b);
+}
+
+size_t sys_tlsf_usable_size(void *ptr)
+{
+	return block_size(block_from_ptr(ptr));
+}
+
+#ifdef CONFIG_SYS_MEM_STATS
+void sys_tlsf_stats_get(struct sys_tlsf *h, struct sys_mem_stats *stats)
+{
+	size_t largest = 0;
+
+	/* The largest free block is in the highest non-empty list,
+	 * though not necessarily at its head.
+	 */
+	if (h->fl_bitmap != 0U) {
+		int fl = 31 - __builtin_clz(h->fl_bitmap);
+		int sl = 31 - __builtin_clz(h->sl_bitmap[fl]);
+
+		for (block_t *b = h->blocks[fl][sl]; b != NULL;
+		     b = b->next_free) {
+			if (block_size(b) > largest) {
+				largest = block_size(b);
+			}
+		}
+	}
+
+	stats->total_bytes = h->end - h->start;
+	stats->allocated_bytes = h->allocated;
+	stats->max_allocated_bytes = h->max_allocated;
+	stats->largest_free_bytes = largest;
+}
+#endif
@@ -15,9 +15,15 @@ static int cond_wait(pthread_cond_t *cv, pthread_mutex_t *mut, int timeout)
 
 	int ret, key = irq_lock();
 
+	/* Release the mutex without switching to a waiter for it, which
+	 * could signal the condition before we pend on it.
+	 */
 	mut->lock_count = 0;
 	mut->owner = NULL;
-	_ready_one_thread(&mut->wait_q);
+	if (atomic_set(&mut->lock.futex.val, _SYS_MUTEX_UNLOCKED) ==
+	    _SYS_MUTEX_CONTENDED) {
+		_futex_wake_no_resched(&mut->lock.futex, false);
+	}
 	ret = _pend_curr_irqlock(key, &cv->wait_q, timeout);
 
 	/* FIXME: this extra lock (and the potential context switch it
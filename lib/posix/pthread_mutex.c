@@ -5,8 +5,6 @@
  */
 
 #include <kernel.h>
-#include <ksched.h>
-#include <wait_q.h>
 #include <posix/pthread.h>
 
 #define MUTEX_MAX_REC_LOCK 32767
@@ -18,17 +16,16 @@ static const pthread_mutexattr_t def_attr = {
 	.type = PTHREAD_MUTEX_DEFAULT,
 };
 
+/* The lock itself is a futex based sys_mutex, so that an uncontended
+ * lock or unlock is a single atomic operation.  Only the owner writes
+ * the owner and lock count, so checking for recursion needs no lock.
+ */
 static int acquire_mutex(pthread_mutex_t *m, int timeout)
 {
-	int rc = 0, key = irq_lock();
-
-	if (m->lock_count == 0 && m->owner == NULL) {
-		m->lock_count++;
-		m->owner = pthread_self();
+	pthread_t self = pthread_self();
+	int rc;
 
-		irq_unlock(key);
-		return 0;
-	} else if (m->owner == pthread_self()) {
+	if (m->owner == self) {
 		if (m->type == PTHREAD_MUTEX_RECURSIVE &&
 		    m->lock_count < MUTEX_MAX_REC_LOCK) {
 			m->lock_count++;
@@ -39,21 +36,20 @@ static int acquire_mutex(pthread_mutex_t *m, int timeout)
 			rc = EINVAL;
 		}
 
-		irq_unlock(key);
 		return rc;
 	}
 
-	if (timeout == K_NO_WAIT) {
-		irq_unlock(key);
-		return EINVAL;
+	rc = sys_mutex_lock(&m->lock, timeout);
+	if (rc == -EBUSY) {
+		return EBUSY;
+	} else if (rc != 0) {
+		return ETIMEDOUT;
 	}
 
-	rc = _pend_curr_irqlock(key, &m->wait_q, timeout);
-	if (rc != 0) {
-		rc = ETIMEDOUT;
-	}
+	m->owner = self;
+	m->lock_count = 1;
 
-	return rc;
+	return 0;
 }
 
 /**
@@ -95,7 +91,7 @@ int pthread_mutex_init(pthread_mutex_t *m,
 
 	m->type = mattr->type;
 
-	_waitq_init(&m->wait_q);
+	sys_mutex_init(&m->lock);
 
 	return 0;
 }
@@ -118,36 +114,21 @@ int pthread_mutex_lock(pthread_mutex_t *m)
  */
 int pthread_mutex_unlock(pthread_mutex_t *m)
 {
-	unsigned int key = irq_lock();
-
-	k_tid_t thread;
-
 	if (m->owner != pthread_self()) {
-		irq_unlock(key);
 		return EPERM;
 	}
 
 	if (m->lock_count == 0) {
-		irq_unlock(key);
 		return EINVAL;
 	}
 
 	m->lock_count--;
 
 	if (m->lock_count == 0) {
-		thread = _unpend_first_thread(&m->wait_q);
-		if (thread) {
-			m->owner = (pthread_t)thread;
-			m->lock_count++;
-			_ready_thread(thread);
-			_set_thread_return_value(thread, 0);
-			_reschedule_irqlock(key);
-			return 0;
-		}
 		m->owner = NULL;
-
+		sys_mutex_unlock(&m->lock);
 	}
-	irq_unlock(key);
+
 	return 0;
 }
 
@@ -74,6 +74,13 @@ extern u32_t %s(u32_t arg1, u32_t arg2, u32_t arg3,
                 u32_t arg4, u32_t arg5, u32_t arg6, void *ssf);
 """
 
+op_template = """
+static inline void k_syscall_op_%s(struct k_syscall_op *op%s)
+{
+	op->id = %s;
+%s}
+"""
+
 weak_template = """
 __weak ALIAS_OF(handler_no_syscall)
 u32_t %s(u32_t arg1, u32_t arg2, u32_t arg3,
@@ -154,7 +161,21 @@ def analyze_fn(match_group):
     # Entry in _k_syscall_table
     table_entry = "[%s] = %s" % (sys_id, handler)
 
-    return (handler, invocation, sys_id, table_entry)
+    # Helper setting up a k_syscall_batch() operation. System calls with
+    # more than 6 arguments or 64-bit values go through memory owned by
+    # the caller's stub, and cannot be batched
+    wide = ["s64_t", "u64_t"]
+    if (func_name != "k_syscall_batch" and len(args) <= 6 and
+            func_type not in wide and
+            not any(t in wide for t, _ in args)):
+        params = "".join([", %s %s" % (t, n) for t, n in args])
+        marshal = "".join(["\top->arg[%d] = (u32_t)%s;\n" % (i, n)
+                           for i, (_, n) in enumerate(args)])
+        op = op_template % (func_name, params, sys_id, marshal)
+    else:
+        op = None
+
+    return (handler, invocation, sys_id, table_entry, op)
 
 def parse_args():
     global args
@@ -180,17 +201,21 @@ def main():
         syscalls = json.load(fd)
 
     invocations = {}
+    ops = {}
     ids = []
     table_entries = []
     handlers = []
 
     for match_group, fn in syscalls:
-        handler, inv, sys_id, entry = analyze_fn(match_group)
+        handler, inv, sys_id, entry, op = analyze_fn(match_group)
 
         if fn not in invocations:
             invocations[fn] = []
+            ops[fn] = []
 
         invocations[fn].append(inv)
+        if op:
+            ops[fn].append(op)
         ids.append(sys_id)
         table_entries.append(entry)
         handlers.append(handler)
@@ -218,7 +243,11 @@ def main():
     for fn, invo_list in invocations.items():
         out_fn = os.path.join(args.base_output, fn)
 
-        header = syscall_template % "\n\n".join(invo_list)
+        body = "\n\n".join(invo_list)
+        if ops[fn]:
+            body += ("\n\n#ifdef CONFIG_USERSPACE\n%s\n#endif" %
+                     "".join(ops[fn]))
+        header = syscall_template % body
 
         with open(out_fn, "w") as fp:
             fp.write(header)
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <debug/lock_stats.h>
+#include <tracing.h>
+#include <string.h>
+
+#define NUM_SITES CONFIG_LOCK_STATS_SITES
+
+/* Open-addressed table keyed by site pointer.  Entries are never
+ * removed except by lock_stats_reset(), so a linear probe stops at
+ * the first empty slot.
+ */
+static struct lock_stats_site sites[NUM_SITES];
+
+static u32_t dropped;
+
+/* The table is protected with a bare atomic flag rather than a
+ * k_spinlock, which would itself be instrumented.
+ */
+static atomic_t table_lock;
+
+/* Set while this CPU is inside a hook.  k_cycle_get_32() may take a
+ * spinlock on some timer drivers, and that acquisition must not be
+ * recorded or it would recurse into the hooks.  Only touched with
+ * interrupts masked, so no atomics are needed.
+ */
+static u8_t in_hook[CONFIG_MP_NUM_CPUS];
+
+static inline u8_t *hook_flag(void)
+{
+#ifdef CONFIG_SMP
+	return &in_hook[_arch_curr_cpu()->id];
+#else
+	return &in_hook[0];
+#endif
+}
+
+static void table_lock_take(void)
+{
+	while (!atomic_cas(&table_lock, 0, 1)) {
+	}
+}
+
+static void table_lock_give(void)
+{
+	atomic_clear(&table_lock);
+}
+
+static struct lock_stats_site *site_get(const void *site, u8_t type)
+{
+	unsigned int i = ((uintptr_t)site >> 2) % NUM_SITES;
+
+	for (int n = 0; n < NUM_SITES; n++) {
+		struct lock_stats_site *s = &sites[i];
+
+		if (s->site == site) {
+			return s;
+		}
+
+		if (s->site == NULL) {
+			s->site = site;
+			s->type = type;
+			return s;
+		}
+
+		i = (i + 1) % NUM_SITES;
+	}
+
+	return NULL;
+}
+
+u32_t z_lock_stats_begin(void)
+{
+	int key = _arch_irq_lock();
+	u8_t *flag = hook_flag();
+	u32_t now = 0;
+
+	if (*flag == 0) {
+		*flag = 1;
+		now = k_cycle_get_32();
+		*flag = 0;
+	}
+
+	_arch_irq_unlock(key);
+
+	return now;
+}
+
+void z_lock_stats_acquired(struct _lock_stats_hold *hold, const void *site,
+			   enum lock_stats_type type, u32_t start,
+			   bool contended)
+{
+	int key = _arch_irq_lock();
+	u8_t *flag = hook_flag();
+	struct lock_stats_site *s;
+	u32_t now, wait;
+
+	hold->site = NULL;
+
+	if (*flag != 0) {
+		goto out;
+	}
+
+	*flag = 1;
+	now = k_cycle_get_32();
+	wait = now - start;
+
+	table_lock_take();
+	s = site_get(site, type);
+	if (s != NULL) {
+		s->count++;
+		s->wait_cycles += wait;
+		if (contended) {
+			s->contended++;
+		}
+		if (wait > s->max_wait_cycles) {
+			s->max_wait_cycles = wait;
+		}
+	} else {
+		dropped++;
+	}
+	table_lock_give();
+
+	hold->site = s;
+	hold->start = now;
+	*flag = 0;
+
+out:
+	_arch_irq_unlock(key);
+}
+
+void z_lock_stats_released(struct _lock_stats_hold *hold)
+{
+	struct lock_stats_site *s = hold->site;
+	int key;
+	u8_t *flag;
+	u32_t held;
+
+	if (s == NULL) {
+		return;
+	}
+
+	hold->site = NULL;
+
+	key = _arch_irq_lock();
+	flag = hook_flag();
+	if (*flag == 0) {
+		*flag = 1;
+		held = k_cycle_get_32() - hold->start;
+
+		table_lock_take();
+		/* Skip entries cleared by a reset during the hold */
+		if (s->site != NULL) {
+			s->hold_cycles += held;
+			if (held > s->max_hold_cycles) {
+				s->max_hold_cycles = held;
+			}
+		}
+		table_lock_give();
+
+		*flag = 0;
+	}
+	_arch_irq_unlock(key);
+}
+
+void lock_stats_foreach(lock_stats_cb_t cb, void *user_data)
+{
+	struct lock_stats_site copy;
+	int key;
+
+	for (int i = 0; i < NUM_SITES; i++) {
+		key = _arch_irq_lock();
+		table_lock_take();
+		copy = sites[i];
+		table_lock_give();
+		_arch_irq_unlock(key);
+
+		if (copy.site != NULL) {
+			cb(&copy, user_data);
+		}
+	}
+}
+
+void lock_stats_reset(void)
+{
+	int key = _arch_irq_lock();
+
+	table_lock_take();
+	(void)memset(sites, 0, sizeof(sites));
+	dropped = 0;
+	table_lock_give();
+
+	_arch_irq_unlock(key);
+}
+
+u32_t lock_stats_dropped(void)
+{
+	return dropped;
+}
+
+static void trace_site(const struct lock_stats_site *site, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	sys_trace_lock_stats(site);
+}
+
+void lock_stats_trace_dump(void)
+{
+	lock_stats_foreach(trace_site, NULL);
+}
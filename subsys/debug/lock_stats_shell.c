@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <shell/shell.h>
+#include <debug/lock_stats.h>
+
+static void print_site(const struct lock_stats_site *site, void *user_data)
+{
+	const struct shell *shell = user_data;
+	u32_t avg_wait = (u32_t)(site->wait_cycles / site->count);
+	u32_t avg_hold = (u32_t)(site->hold_cycles / site->count);
+
+	if (site->type == LOCK_STATS_SPINLOCK) {
+		shell_fprintf(shell, SHELL_NORMAL, "spin  %s\n",
+			      (const char *)site->site);
+	} else {
+		shell_fprintf(shell, SHELL_NORMAL, "mutex %p\n", site->site);
+	}
+
+	shell_fprintf(shell, SHELL_NORMAL,
+		      "      count %u contended %u wait avg %u max %u"
+		      " hold avg %u max %u\n",
+		      site->count, site->contended, avg_wait,
+		      site->max_wait_cycles, avg_hold, site->max_hold_cycles);
+}
+
+static int cmd_lock_stats_show(const struct shell *shell,
+			       size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_fprintf(shell, SHELL_NORMAL, "Lock sites (times in cycles):\n");
+	lock_stats_foreach(print_site, (void *)shell);
+	shell_fprintf(shell, SHELL_NORMAL, "Dropped acquisitions: %u\n",
+		      lock_stats_dropped());
+	return 0;
+}
+
+static int cmd_lock_stats_reset(const struct shell *shell,
+				size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	lock_stats_reset();
+	return 0;
+}
+
+static int cmd_lock_stats_trace(const struct shell *shell,
+				size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	lock_stats_trace_dump();
+	return 0;
+}
+
+SHELL_CREATE_STATIC_SUBCMD_SET(sub_lock_stats)
+{
+	/* Alphabetically sorted. */
+	SHELL_CMD(reset, NULL, "Clear lock statistics.", cmd_lock_stats_reset),
+	SHELL_CMD(show, NULL, "Show lock statistics.", cmd_lock_stats_show),
+	SHELL_CMD(trace, NULL, "Export lock statistics to the trace stream.",
+		  cmd_lock_stats_trace),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+};
+
+SHELL_CMD_REGISTER(lock_stats, &sub_lock_stats, "Lock statistics", NULL);
@@ -6,6 +6,9 @@
 
 #include <tracing_cpu_stats.h>
 #include <misc/printk.h>
+#ifdef CONFIG_TRACING_CPU_STATS_THREADS
+#include <ksched.h>
+#endif
 
 enum cpu_state {
 	CPU_STATE_IDLE,
@@ -102,6 +105,118 @@ void cpu_stats_reset_counters(void)
 	irq_unlock(key);
 }
 
+#ifdef CONFIG_TRACING_CPU_STATS_THREADS
+static u32_t latency_hist[CPU_STATS_LATENCY_BUCKETS];
+
+/* The dummy thread used to start multithreading is not set up */
+static bool is_accounted(struct k_thread *thread)
+{
+	return (thread != NULL) &&
+	       ((thread->base.thread_state & _THREAD_DUMMY) == 0);
+}
+
+static void thread_stats_switched_out(struct k_thread *thread)
+{
+	struct k_thread_runtime_stats *stats = &thread->runtime_stats;
+	u32_t now = k_cycle_get_32();
+
+	stats->cycles += now - stats->stamp;
+	stats->stamp = now;
+
+	/* Preempted and yielding threads wait for the CPU from now on */
+	stats->ready = _is_thread_ready(thread);
+}
+
+static void thread_stats_switched_in(struct k_thread *prev,
+				     struct k_thread *thread)
+{
+	struct k_thread_runtime_stats *stats = &thread->runtime_stats;
+	u32_t now = k_cycle_get_32();
+	u32_t latency, us;
+
+	if (thread == prev) {
+		/* The same thread was picked again, or this is called
+		 * before the actual switch: it keeps running from the time
+		 * it was switched out.
+		 */
+		return;
+	}
+
+	if (is_accounted(prev)) {
+		if (prev->runtime_stats.ready) {
+			prev->runtime_stats.involuntary++;
+		} else {
+			prev->runtime_stats.voluntary++;
+		}
+	}
+
+	if (stats->ready) {
+		latency = now - stats->stamp;
+		if (latency > stats->max_latency) {
+			stats->max_latency = latency;
+		}
+
+		us = (u32_t)(SYS_CLOCK_HW_CYCLES_TO_NS64(latency) /
+			     NSEC_PER_USEC);
+		latency_hist[MIN(find_msb_set(us),
+				 CPU_STATS_LATENCY_BUCKETS - 1)]++;
+	}
+
+	stats->ready = false;
+	stats->stamp = now;
+}
+
+void sys_trace_thread_ready(struct k_thread *thread)
+{
+	int key = irq_lock();
+	struct k_thread_runtime_stats *stats = &thread->runtime_stats;
+
+	/* Keep the time it was first made ready if it already was */
+	if ((thread != current_thread) && !stats->ready &&
+	    _is_thread_ready(thread)) {
+		stats->ready = true;
+		stats->stamp = k_cycle_get_32();
+	}
+
+	irq_unlock(key);
+}
+
+void cpu_stats_thread_get(k_tid_t thread,
+			  struct k_thread_runtime_stats *stats)
+{
+	int key = irq_lock();
+
+	*stats = thread->runtime_stats;
+	if (thread == current_thread) {
+		stats->cycles += k_cycle_get_32() - stats->stamp;
+	}
+
+	irq_unlock(key);
+}
+
+void cpu_stats_latency_get(u32_t *hist)
+{
+	int key = irq_lock();
+
+	for (int i = 0; i < CPU_STATS_LATENCY_BUCKETS; i++) {
+		hist[i] = latency_hist[i];
+	}
+
+	irq_unlock(key);
+}
+
+void cpu_stats_latency_reset(void)
+{
+	int key = irq_lock();
+
+	for (int i = 0; i < CPU_STATS_LATENCY_BUCKETS; i++) {
+		latency_hist[i] = 0U;
+	}
+
+	irq_unlock(key);
+}
+#endif /* CONFIG_TRACING_CPU_STATS_THREADS */
+
 void sys_trace_thread_switched_in(void)
 {
 	int key = irq_lock();
@@ -109,6 +224,11 @@ void sys_trace_thread_switched_in(void)
 	__ASSERT_NO_MSG(nested_interrupts == 0);
 
 	cpu_stats_update_counters();
+#ifdef CONFIG_TRACING_CPU_STATS_THREADS
+	if (is_accounted(k_current_get())) {
+		thread_stats_switched_in(current_thread, k_current_get());
+	}
+#endif
 	current_thread = k_current_get();
 	if (is_idle_thread(current_thread)) {
 		last_cpu_state = CPU_STATE_IDLE;
@@ -126,6 +246,11 @@ void sys_trace_thread_switched_out(void)
 	__ASSERT_NO_MSG(current_thread == k_current_get());
 
 	cpu_stats_update_counters();
+#ifdef CONFIG_TRACING_CPU_STATS_THREADS
+	if (is_accounted(current_thread)) {
+		thread_stats_switched_out(current_thread);
+	}
+#endif
 	last_cpu_state = CPU_STATE_SCHEDULER;
 	irq_unlock(key);
 }
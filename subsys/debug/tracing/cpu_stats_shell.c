@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <shell/shell.h>
+#include <tracing_cpu_stats.h>
+
+struct top_ctx {
+	const struct shell *shell;
+	u64_t total_cycles;
+};
+
+static void sum_thread(const struct k_thread *thread, void *user_data)
+{
+	struct top_ctx *ctx = user_data;
+	struct k_thread_runtime_stats stats;
+
+	cpu_stats_thread_get((k_tid_t)thread, &stats);
+	ctx->total_cycles += stats.cycles;
+}
+
+static void print_thread(const struct k_thread *thread, void *user_data)
+{
+	struct top_ctx *ctx = user_data;
+	struct k_thread_runtime_stats stats;
+	const char *tname;
+	u32_t permille = 0U;
+
+	cpu_stats_thread_get((k_tid_t)thread, &stats);
+	tname = k_thread_name_get((k_tid_t)thread);
+
+	if (ctx->total_cycles != 0U) {
+		permille = (u32_t)((stats.cycles * 1000U) / ctx->total_cycles);
+	}
+
+	shell_fprintf(ctx->shell, SHELL_NORMAL,
+		      "%p %-10s %4d %3u.%u %10u %10u %10u\n",
+		      thread, tname ? tname : "NA", thread->base.prio,
+		      permille / 10U, permille % 10U, stats.voluntary,
+		      stats.involuntary,
+		      SYS_CLOCK_HW_CYCLES_TO_NS(stats.max_latency) /
+		      NSEC_PER_USEC);
+}
+
+static int cmd_top(const struct shell *shell, size_t argc, char **argv)
+{
+	struct top_ctx ctx = { .shell = shell };
+	u32_t hist[CPU_STATS_LATENCY_BUCKETS];
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_thread_foreach(sum_thread, &ctx);
+
+	shell_fprintf(shell, SHELL_NORMAL,
+		      "%-10s %-10s %4s %5s %10s %10s %10s\n", "thread",
+		      "name", "prio", "cpu%", "voluntary", "involunt.",
+		      "max lat us");
+	k_thread_foreach(print_thread, &ctx);
+
+	cpu_stats_latency_get(hist);
+
+	shell_fprintf(shell, SHELL_NORMAL, "\nScheduling latency (us):\n");
+	shell_fprintf(shell, SHELL_NORMAL, "%10s %10u\n", "< 1", hist[0]);
+	for (int i = 1; i < CPU_STATS_LATENCY_BUCKETS - 1; i++) {
+		shell_fprintf(shell, SHELL_NORMAL, "%10u %10u\n",
+			      1U << (i - 1), hist[i]);
+	}
+	shell_fprintf(shell, SHELL_NORMAL, ">= %7u %10u\n",
+		      1U << (CPU_STATS_LATENCY_BUCKETS - 2),
+		      hist[CPU_STATS_LATENCY_BUCKETS - 1]);
+
+	return 0;
+}
+
+static int cmd_top_reset(const struct shell *shell, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	cpu_stats_latency_reset();
+	return 0;
+}
+
+SHELL_CREATE_STATIC_SUBCMD_SET(sub_top)
+{
+	/* Alphabetically sorted. */
+	SHELL_CMD(reset, NULL, "Clear the scheduling latency histogram.",
+		  cmd_top_reset),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+};
+
+SHELL_CMD_REGISTER(top, &sub_top,
+		   "Show per-thread CPU usage and scheduling latency", cmd_top);
@@ -69,7 +69,8 @@ typedef enum {
 	CTF_EVENT_ISR_EXIT_TO_SCHEDULER =  0x22,
 	CTF_EVENT_IDLE                  =  0x30,
 	CTF_EVENT_ID_START_CALL         =  0x41,
-	CTF_EVENT_ID_END_CALL           =  0x42
+	CTF_EVENT_ID_END_CALL           =  0x42,
+	CTF_EVENT_LOCK_STATS            =  0x50
 } ctf_event_t;
 
 
@@ -214,4 +215,28 @@ static inline void ctf_middle_end_call(u32_t id)
 		);
 }
 
+static inline void ctf_middle_lock_stats(
+	u32_t site,
+	u8_t type,
+	u32_t count,
+	u32_t contended,
+	u64_t wait_cycles,
+	u32_t max_wait_cycles,
+	u64_t hold_cycles,
+	u32_t max_hold_cycles
+	)
+{
+	CTF_EVENT(
+		CTF_LITERAL(u8_t, CTF_EVENT_LOCK_STATS),
+		site,
+		type,
+		count,
+		contended,
+		wait_cycles,
+		max_wait_cycles,
+		hold_cycles,
+		max_hold_cycles
+		);
+}
+
 #endif /* SUBSYS_DEBUG_TRACING_CTF_MIDDLE_H */
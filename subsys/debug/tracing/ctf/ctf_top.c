@@ -7,6 +7,7 @@
 #include <zephyr.h>
 #include <kernel_structs.h>
 #include <init.h>
+#include <debug/lock_stats.h>
 
 #include <ctf_middle.h>
 #include "ctf_top.h"
@@ -138,6 +139,22 @@ void sys_trace_end_call(unsigned int id)
 	ctf_middle_end_call(id);
 }
 
+#ifdef CONFIG_LOCK_STATS
+void sys_trace_lock_stats(const struct lock_stats_site *site)
+{
+	ctf_middle_lock_stats(
+		(u32_t)(uintptr_t)site->site,
+		site->type,
+		site->count,
+		site->contended,
+		site->wait_cycles,
+		site->max_wait_cycles,
+		site->hold_cycles,
+		site->max_hold_cycles
+		);
+}
+#endif
+
 
 void z_sys_trace_thread_switched_out(void)
 {
@@ -26,6 +26,42 @@ void cpu_stats_get_ns(struct cpu_stats *cpu_stats_ns);
 u32_t cpu_stats_non_idle_and_sched_get_percent(void);
 void cpu_stats_reset_counters(void);
 
+#ifdef CONFIG_TRACING_CPU_STATS_THREADS
+#define CPU_STATS_LATENCY_BUCKETS CONFIG_TRACING_CPU_STATS_LATENCY_BUCKETS
+
+/**
+ * @brief Get the runtime statistics of a thread
+ *
+ * Times are in cycles, as returned by k_cycle_get_32().  The cycles of
+ * a running thread include its current run.
+ *
+ * @param thread Thread
+ * @param stats Structure to fill
+ */
+void cpu_stats_thread_get(k_tid_t thread,
+			  struct k_thread_runtime_stats *stats);
+
+/**
+ * @brief Get the scheduling latency histogram
+ *
+ * Bucket 0 counts the waits from being made ready to running shorter
+ * than 1 us, bucket N those from 2^(N-1) to 2^N - 1 us, and the last
+ * bucket all the longer ones.
+ *
+ * @param hist Array of CPU_STATS_LATENCY_BUCKETS counts to fill
+ */
+void cpu_stats_latency_get(u32_t *hist);
+
+/**
+ * @brief Clear the scheduling latency histogram
+ */
+void cpu_stats_latency_reset(void);
+
+void sys_trace_thread_ready(struct k_thread *thread);
+#else
+#define sys_trace_thread_ready(thread)
+#endif
+
 #define sys_trace_isr_exit_to_scheduler()
 
 #define sys_trace_thread_priority_set(thread)
@@ -34,10 +70,10 @@ void cpu_stats_reset_counters(void);
 #define sys_trace_thread_abort(thread)
 #define sys_trace_thread_suspend(thread)
 #define sys_trace_thread_resume(thread)
-#define sys_trace_thread_ready(thread)
 #define sys_trace_thread_pend(thread)
 
 #define sys_trace_void(id)
 #define sys_trace_end_call(id)
+#define sys_trace_lock_stats(site)
 
 #endif /* _TRACE_CPU_STATS_H */
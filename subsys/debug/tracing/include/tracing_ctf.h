@@ -32,6 +32,9 @@ void sys_trace_idle(void);
 void sys_trace_void(unsigned int id);
 void sys_trace_end_call(unsigned int id);
 
+struct lock_stats_site;
+void sys_trace_lock_stats(const struct lock_stats_site *site);
+
 #ifdef __cplusplus
 }
 #endif
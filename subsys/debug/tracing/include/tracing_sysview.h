@@ -93,4 +93,6 @@ static inline void sys_trace_thread_info(struct k_thread *thread)
 
 #define sys_trace_end_call(id) SEGGER_SYSVIEW_RecordEndCall(id)
 
+#define sys_trace_lock_stats(site)
+
 #endif /* _TRACE_SYSVIEW_H */
@@ -122,6 +122,7 @@ int net_ipv4_finalize(struct net_pkt *pkt, u8_t next_header_proto)
 
 	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) ||
 	    next_header_proto == IPPROTO_ICMP) {
+		ipv4_hdr->chksum = 0;
 		ipv4_hdr->chksum = net_calc_chksum_ipv4(pkt);
 
 		net_pkt_set_data(pkt, &ipv4_access);
@@ -1319,6 +1319,8 @@ static int sendto(struct net_pkt *pkt,
 		break;
 
 	case IPPROTO_TCP:
+		/* The pkt may be merged into a queued one */
+		net_pkt_set_token(pkt, token);
 		ret = net_tcp_queue_data(context, pkt);
 		break;
 
@@ -1346,10 +1348,10 @@ static int sendto(struct net_pkt *pkt,
 
 	context->send_cb = cb;
 	context->user_data = user_data;
-	net_pkt_set_token(pkt, token);
 
 	switch (net_context_get_ip_proto(context)) {
 	case IPPROTO_UDP:
+		net_pkt_set_token(pkt, token);
 		return net_send_data(pkt);
 
 	case IPPROTO_TCP:
@@ -1357,6 +1359,7 @@ static int sendto(struct net_pkt *pkt,
 
 #if defined(CONFIG_NET_SOCKETS_CAN)
 	case CAN_RAW:
+		net_pkt_set_token(pkt, token);
 		return net_send_data(pkt);
 #endif
 
@@ -1458,9 +1461,30 @@ int net_context_sendto(struct net_pkt *pkt,
 	return ret;
 }
 
+/* Gather len bytes from the buffers into the packet */
+static int context_write_iov(struct net_pkt *pkt, const struct k_iovec *iov,
+			     size_t iovcnt, size_t len)
+{
+	int ret;
+
+	for (; iovcnt && len; iov++, iovcnt--) {
+		size_t chunk = MIN(iov->iov_len, len);
+
+		ret = net_pkt_write_new(pkt, iov->iov_base, chunk);
+		if (ret) {
+			return ret;
+		}
+
+		len -= chunk;
+	}
+
+	return 0;
+}
+
 static int context_setup_udp_packet(struct net_context *context,
 				    struct net_pkt *pkt,
-				    const void *buf,
+				    const struct k_iovec *iov,
+				    size_t iovcnt,
 				    size_t len,
 				    const struct sockaddr *dst_addr,
 				    socklen_t addrlen)
@@ -1503,12 +1527,7 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
-	ret = net_pkt_write_new(pkt, buf, len);
-	if (ret) {
-		return ret;
-	}
-
-	return 0;
+	return context_write_iov(pkt, iov, iovcnt, len);
 }
 
 static void context_finalize_packet(struct net_context *context,
@@ -1530,8 +1549,8 @@ static void context_finalize_packet(struct net_context *context,
 }
 
 static int context_sendto_new(struct net_context *context,
-			      const void *buf,
-			      size_t len,
+			      const struct k_iovec *iov,
+			      size_t iovcnt,
 			      const struct sockaddr *dst_addr,
 			      socklen_t addrlen,
 			      net_context_send_cb_t cb,
@@ -1540,11 +1559,16 @@ static int context_sendto_new(struct net_context *context,
 			      void *user_data)
 {
 	struct net_pkt *pkt;
+	size_t len = 0;
 	size_t tmp_len;
 	int ret;
 
 	NET_ASSERT(PART_OF_ARRAY(contexts, context));
 
+	for (int i = 0; i < iovcnt; i++) {
+		len += iov[i].iov_len;
+	}
+
 	if (!net_context_is_used(context)) {
 		return -EBADF;
 	}
@@ -1648,7 +1672,7 @@ static int context_sendto_new(struct net_context *context,
 
 	if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_ip_proto(context) == IPPROTO_UDP) {
-		ret = context_setup_udp_packet(context, pkt, buf, len,
+		ret = context_setup_udp_packet(context, pkt, iov, iovcnt, len,
 					       dst_addr, addrlen);
 		if (ret < 0) {
 			goto fail;
@@ -1659,7 +1683,7 @@ static int context_sendto_new(struct net_context *context,
 		ret = net_send_data(pkt);
 	} else if (IS_ENABLED(CONFIG_NET_TCP) &&
 		   net_context_get_ip_proto(context) == IPPROTO_TCP) {
-		ret = net_pkt_write_new(pkt, buf, len);
+		ret = context_write_iov(pkt, iov, iovcnt, len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1673,7 +1697,7 @@ static int context_sendto_new(struct net_context *context,
 		ret = net_tcp_send_data(context, cb, token, user_data);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) &&
 		   net_context_get_family(context) == AF_PACKET) {
-		ret = net_pkt_write_new(pkt, buf, len);
+		ret = context_write_iov(pkt, iov, iovcnt, len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1684,7 +1708,7 @@ static int context_sendto_new(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) &&
 		   net_context_get_family(context) == AF_CAN &&
 		   net_context_get_ip_proto(context) == CAN_RAW) {
-		ret = net_pkt_write_new(pkt, buf, len);
+		ret = context_write_iov(pkt, iov, iovcnt, len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1709,48 +1733,49 @@ fail:
 	return ret;
 }
 
-int net_context_send_new(struct net_context *context,
-			 const void *buf,
-			 size_t len,
-			 net_context_send_cb_t cb,
-			 s32_t timeout,
-			 void *token,
-			 void *user_data)
+/* Length of the remote address the context is connected to */
+static int context_remote_addrlen(struct net_context *context,
+				  socklen_t *addrlen)
 {
-	socklen_t addrlen;
-	int ret = 0;
-
-	k_mutex_lock(&context->lock, K_FOREVER);
-
 	if (!(context->flags & NET_CONTEXT_REMOTE_ADDR_SET) ||
 	    !net_sin(&context->remote)->sin_port) {
-		ret = -EDESTADDRREQ;
-		goto unlock;
+		return -EDESTADDRREQ;
 	}
 
 	if (IS_ENABLED(CONFIG_NET_IPV4) &&
 	    net_context_get_family(context) == AF_INET) {
-		addrlen = sizeof(struct sockaddr_in);
+		*addrlen = sizeof(struct sockaddr_in);
 	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
 		   net_context_get_family(context) == AF_INET6) {
-		addrlen = sizeof(struct sockaddr_in6);
+		*addrlen = sizeof(struct sockaddr_in6);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) &&
 		   net_context_get_family(context) == AF_PACKET) {
-		ret = -EOPNOTSUPP;
-		goto unlock;
+		return -EOPNOTSUPP;
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) &&
 		   net_context_get_family(context) == AF_CAN) {
-		addrlen = sizeof(struct sockaddr_can);
+		*addrlen = sizeof(struct sockaddr_can);
 	} else {
-		addrlen = 0;
+		*addrlen = 0;
 	}
 
-	ret = context_sendto_new(context, buf, len, &context->remote,
-				 addrlen, cb, timeout, token, user_data);
-unlock:
-	k_mutex_unlock(&context->lock);
+	return 0;
+}
 
-	return ret;
+int net_context_send_new(struct net_context *context,
+			 const void *buf,
+			 size_t len,
+			 net_context_send_cb_t cb,
+			 s32_t timeout,
+			 void *token,
+			 void *user_data)
+{
+	struct k_iovec iov = {
+		.iov_base = (void *)buf,
+		.iov_len = len,
+	};
+
+	return net_context_sendmsg(context, &iov, 1, NULL, 0, cb, timeout,
+				   token, user_data);
 }
 
 
@@ -1764,11 +1789,15 @@ int net_context_sendto_new(struct net_context *context,
 			   void *token,
 			   void *user_data)
 {
+	struct k_iovec iov = {
+		.iov_base = (void *)buf,
+		.iov_len = len,
+	};
 	int ret;
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
-	ret = context_sendto_new(context, buf, len, dst_addr, addrlen,
+	ret = context_sendto_new(context, &iov, 1, dst_addr, addrlen,
 				 cb, timeout, token, user_data);
 
 	k_mutex_unlock(&context->lock);
@@ -1776,6 +1805,37 @@ int net_context_sendto_new(struct net_context *context,
 	return ret;
 }
 
+int net_context_sendmsg(struct net_context *context,
+			const struct k_iovec *iov,
+			size_t iovcnt,
+			const struct sockaddr *dst_addr,
+			socklen_t addrlen,
+			net_context_send_cb_t cb,
+			s32_t timeout,
+			void *token,
+			void *user_data)
+{
+	int ret = 0;
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	if (!dst_addr) {
+		ret = context_remote_addrlen(context, &addrlen);
+		if (ret < 0) {
+			goto unlock;
+		}
+
+		dst_addr = &context->remote;
+	}
+
+	ret = context_sendto_new(context, iov, iovcnt, dst_addr, addrlen,
+				 cb, timeout, token, user_data);
+unlock:
+	k_mutex_unlock(&context->lock);
+
+	return ret;
+}
+
 enum net_verdict net_context_packet_received(struct net_conn *conn,
 					     struct net_pkt *pkt,
 					     union net_ip_header *ip_hdr,
@@ -52,6 +52,7 @@ static struct tcp_backlog_entry {
 	struct k_delayed_work ack_timer;
 	struct sockaddr remote;
 	u16_t send_mss;
+	bool sack;
 } tcp_backlog[CONFIG_NET_TCP_BACKLOG_SIZE];
 
 #if defined(CONFIG_NET_TCP_ACK_TIMEOUT)
@@ -62,6 +63,31 @@ static struct tcp_backlog_entry {
 
 #define FIN_TIMEOUT K_SECONDS(1)
 
+#if defined(CONFIG_NET_TCP_ACK_DELAY)
+#define ACK_DELAY CONFIG_NET_TCP_ACK_DELAY
+#else
+#define ACK_DELAY 0
+#endif
+
+/* Number of duplicate ACKs that trigger a fast retransmit (RFC 5681) */
+#define DUP_ACK_THRESHOLD 3
+
+/* Without window scaling the peer never offers a larger window than this,
+ * so there is no point in growing the congestion window past it.
+ */
+#define MAX_CWND 0xffff
+
+#if defined(CONFIG_NET_TCP_SACK_QUEUE_LEN)
+#define OOO_QUEUE_LEN CONFIG_NET_TCP_SACK_QUEUE_LEN
+#else
+#define OOO_QUEUE_LEN 0
+#endif
+
+/* Receive packets always left free when keeping an out of order segment,
+ * so that the missing data can still be received.
+ */
+#define OOO_MIN_FREE_PKTS 2
+
 /* Declares a wrapper function for a net_conn callback that refs the
  * context around the invocation (to protect it from premature
  * deletion).  Long term would be nice to see this feature be part of
@@ -193,6 +219,447 @@ static inline u32_t retry_timeout(const struct net_tcp *tcp)
 		}							\
 	} while (0)
 
+/* Number of data bytes handed to the IP layer but not acknowledged yet */
+static u32_t tcp_flight_size(struct net_tcp *tcp)
+{
+	struct net_pkt *pkt;
+	u32_t flight = 0U;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->sent_list, pkt, sent_list) {
+		if (net_pkt_sent(pkt) || net_pkt_queued(pkt)) {
+			flight += net_pkt_appdatalen(pkt);
+		}
+	}
+
+	return flight;
+}
+
+/* Transmit a segment of sent_list, for the first time or again. The
+ * list keeps its own reference, the one taken here belongs to the driver.
+ */
+static int tcp_send_segment(struct net_tcp *tcp, struct net_pkt *pkt)
+{
+	int ret;
+
+	do_ref_if_needed(tcp, pkt);
+	net_pkt_set_sent(pkt, false);
+	net_pkt_set_queued(pkt, true);
+
+	ret = net_tcp_send_pkt(pkt);
+	if (ret < 0) {
+		net_pkt_set_queued(pkt, false);
+
+		if (!is_6lo_technology(pkt)) {
+			net_pkt_unref(pkt);
+		}
+	} else if (is_6lo_technology(pkt)) {
+		/* A copy was sent, this one never reaches the driver */
+		net_pkt_set_queued(pkt, false);
+		net_pkt_set_sent(pkt, true);
+	}
+
+	return ret;
+}
+
+/* Sequence number of a segment, read from its TCP header */
+static u32_t tcp_pkt_seq(struct net_pkt *pkt)
+{
+	struct net_pkt_cursor backup;
+	bool overwrite = net_pkt_is_being_overwritten(pkt);
+	u32_t seq = 0U;
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			 net_pkt_ipv6_ext_len(pkt) +
+			 offsetof(struct net_tcp_hdr, seq)) ||
+	    net_pkt_read_be32_new(pkt, &seq)) {
+		NET_ERR("pkt %p has no TCP header", pkt);
+	}
+
+	net_pkt_cursor_restore(pkt, &backup);
+	net_pkt_set_overwrite(pkt, overwrite);
+
+	return seq;
+}
+
+/* Add the block [left, right) to the SACK scoreboard, merging it with the
+ * blocks it overlaps or touches. Returns true if new data was covered.
+ */
+static bool tcp_sack_add(struct net_tcp *tcp, u32_t left, u32_t right)
+{
+	struct net_tcp_sack_block *block;
+	int i = 0;
+
+	while (i < tcp->sack_cnt) {
+		block = &tcp->sacked[i];
+
+		if (net_tcp_seq_greater(block->left, right) ||
+		    net_tcp_seq_greater(left, block->right)) {
+			i++;
+			continue;
+		}
+
+		if (!net_tcp_seq_greater(block->left, left) &&
+		    !net_tcp_seq_greater(right, block->right)) {
+			return false;
+		}
+
+		if (net_tcp_seq_greater(left, block->left)) {
+			left = block->left;
+		}
+
+		if (net_tcp_seq_greater(block->right, right)) {
+			right = block->right;
+		}
+
+		*block = tcp->sacked[--tcp->sack_cnt];
+	}
+
+	if (tcp->sack_cnt < NET_TCP_SACK_BLOCKS) {
+		i = tcp->sack_cnt++;
+	} else {
+		/* The scoreboard is full, forget about the oldest data.
+		 * It is only retransmitted needlessly in the worst case.
+		 */
+		i = 0;
+
+		for (int j = 1; j < NET_TCP_SACK_BLOCKS; j++) {
+			if (net_tcp_seq_greater(tcp->sacked[i].left,
+						tcp->sacked[j].left)) {
+				i = j;
+			}
+		}
+
+		if (net_tcp_seq_greater(tcp->sacked[i].left, left)) {
+			return false;
+		}
+	}
+
+	tcp->sacked[i].left = left;
+	tcp->sacked[i].right = right;
+
+	return true;
+}
+
+/* Update the SACK scoreboard from the blocks of a received ACK and drop
+ * what the cumulative ACK covers. Returns true if new data was covered.
+ */
+static bool tcp_sack_update(struct net_tcp *tcp, u32_t ack,
+			    const struct net_tcp_options *opts)
+{
+	bool updated = false;
+	int i;
+
+	if (!(tcp->flags & NET_TCP_SACK_PERMITTED)) {
+		return false;
+	}
+
+	for (i = 0; opts && i < opts->sack_cnt; i++) {
+		u32_t left = opts->sack[i].left;
+		u32_t right = opts->sack[i].right;
+
+		/* Blocks of data already acknowledged, or of data never
+		 * sent, are ignored.
+		 */
+		if (!net_tcp_seq_greater(right, left) ||
+		    !net_tcp_seq_greater(right, ack) ||
+		    net_tcp_seq_greater(right, tcp->send_seq)) {
+			continue;
+		}
+
+		if (net_tcp_seq_greater(ack, left)) {
+			left = ack;
+		}
+
+		updated |= tcp_sack_add(tcp, left, right);
+	}
+
+	i = 0;
+	while (i < tcp->sack_cnt) {
+		struct net_tcp_sack_block *block = &tcp->sacked[i];
+
+		if (!net_tcp_seq_greater(block->right, ack)) {
+			*block = tcp->sacked[--tcp->sack_cnt];
+			continue;
+		}
+
+		if (net_tcp_seq_greater(ack, block->left)) {
+			block->left = ack;
+		}
+
+		i++;
+	}
+
+	return updated;
+}
+
+static bool tcp_sacked(struct net_tcp *tcp, u32_t seq, u32_t len)
+{
+	for (int i = 0; i < tcp->sack_cnt; i++) {
+		if (!net_tcp_seq_greater(tcp->sacked[i].left, seq) &&
+		    !net_tcp_seq_greater(seq + len, tcp->sacked[i].right)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static u32_t tcp_sack_high(struct net_tcp *tcp)
+{
+	u32_t high = tcp->sacked[0].right;
+
+	for (int i = 1; i < tcp->sack_cnt; i++) {
+		if (net_tcp_seq_greater(tcp->sacked[i].right, high)) {
+			high = tcp->sacked[i].right;
+		}
+	}
+
+	return high;
+}
+
+static bool tcp_retransmit(struct net_tcp *tcp, struct net_pkt *pkt)
+{
+	/* Still waiting in the TX queue since its previous transmission */
+	if (net_pkt_queued(pkt)) {
+		return false;
+	}
+
+	if (tcp_send_segment(tcp, pkt) < 0) {
+		NET_DBG("retry %u: [%p] pkt %p send failed",
+			tcp->retry_timeout_shift, tcp, pkt);
+		return false;
+	}
+
+	NET_DBG("retry %u: [%p] sent pkt %p",
+		tcp->retry_timeout_shift, tcp, pkt);
+
+	if (IS_ENABLED(CONFIG_NET_STATISTICS_TCP) &&
+	    !is_6lo_technology(pkt)) {
+		net_stats_update_tcp_seg_rexmit(net_pkt_iface(pkt));
+	}
+
+	return true;
+}
+
+static void tcp_retransmit_head(struct net_tcp *tcp)
+{
+	if (sys_slist_is_empty(&tcp->sent_list)) {
+		return;
+	}
+
+	tcp_retransmit(tcp, CONTAINER_OF(sys_slist_peek_head(&tcp->sent_list),
+					 struct net_pkt, sent_list));
+}
+
+/* Retransmit the oldest segment that the peer is known to miss, i.e. one
+ * that is not selectively acknowledged while later data is (RFC 6675),
+ * and was not retransmitted yet in this recovery. Without SACK
+ * information, that is the oldest segment sent.
+ */
+static void tcp_retransmit_lost(struct net_tcp *tcp)
+{
+	struct net_pkt *pkt;
+	u32_t high;
+
+	if (!tcp->sack_cnt) {
+		tcp_retransmit_head(tcp);
+		return;
+	}
+
+	high = tcp_sack_high(tcp);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->sent_list, pkt, sent_list) {
+		u16_t len = net_pkt_appdatalen(pkt);
+		u32_t seq;
+
+		if (!len) {
+			continue;
+		}
+
+		seq = tcp_pkt_seq(pkt);
+
+		if (!net_tcp_seq_greater(high, seq)) {
+			break;
+		}
+
+		if (net_tcp_seq_cmp(seq, tcp->rexmit_high) < 0 ||
+		    tcp_sacked(tcp, seq, len)) {
+			continue;
+		}
+
+		if (tcp_retransmit(tcp, pkt)) {
+			tcp->rexmit_high = seq + len;
+		}
+
+		return;
+	}
+}
+
+/* Transmit the queued segments that fit in the send window, which is the
+ * smaller of the peer's receive window and the congestion window.
+ */
+static void tcp_send_queued(struct net_tcp *tcp)
+{
+	u32_t wnd = MIN(tcp->send_wnd, tcp->cwnd);
+	u32_t flight = tcp_flight_size(tcp);
+	struct net_pkt *pkt;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->sent_list, pkt, sent_list) {
+		u16_t len = net_pkt_appdatalen(pkt);
+
+		if (net_pkt_sent(pkt) || net_pkt_queued(pkt)) {
+			continue;
+		}
+
+		/* A segment always goes out when nothing is in flight, so
+		 * that a window smaller than the segment cannot stall the
+		 * connection. A zero window is probed by the retransmission
+		 * timer instead.
+		 */
+		if (flight + len > wnd && (flight || !tcp->send_wnd)) {
+			break;
+		}
+
+		/* Nagle's algorithm: hold back a small last segment while
+		 * data is unacknowledged, further writes are coalesced
+		 * into it meanwhile (see net_tcp_queue_data()).
+		 */
+		if (IS_ENABLED(CONFIG_NET_TCP_NAGLE) && flight && len &&
+		    len < tcp->send_mss &&
+		    sys_slist_peek_tail(&tcp->sent_list) == &pkt->sent_list) {
+			break;
+		}
+
+		NET_DBG("[%p] Sending pkt %p (%u bytes, flight %u, wnd %u)",
+			tcp, pkt, len, flight, wnd);
+
+		if (tcp_send_segment(tcp, pkt) < 0) {
+			NET_DBG("[%p] pkt %p not sent", tcp, pkt);
+			break;
+		}
+
+		flight += len;
+	}
+}
+
+static void tcp_cc_init(struct net_tcp *tcp, u16_t wnd)
+{
+	u32_t mss = tcp->send_mss;
+
+	/* Initial window of RFC 3390 */
+	tcp->cwnd = MIN(4 * mss, MAX(2 * mss, 4380U));
+	tcp->ssthresh = MAX_CWND;
+	tcp->recover = tcp->send_seq - 1;
+	tcp->send_wnd = wnd;
+	tcp->dup_acks = 0U;
+	tcp->sack_cnt = 0U;
+	tcp->flags &= ~NET_TCP_FAST_RECOVERY;
+}
+
+/* NewReno congestion window update for an ACK of new data (RFC 5681,
+ * RFC 6582).
+ */
+static void tcp_cc_ack(struct net_tcp *tcp, u32_t ack, u32_t acked)
+{
+	u32_t mss = tcp->send_mss;
+
+	if (tcp->flags & NET_TCP_FAST_RECOVERY) {
+		if (!net_tcp_seq_greater(tcp->recover, ack)) {
+			/* Full ACK: deflate the window, recovery is over */
+			tcp->cwnd = tcp->ssthresh;
+			tcp->flags &= ~NET_TCP_FAST_RECOVERY;
+		} else {
+			/* Partial ACK: the next segment was lost as well */
+			tcp_retransmit_lost(tcp);
+
+			tcp->cwnd -= MIN(acked, tcp->cwnd);
+			if (acked >= mss) {
+				tcp->cwnd += mss;
+			}
+
+			tcp->cwnd = MAX(tcp->cwnd, mss);
+		}
+	} else if (tcp->cwnd < tcp->ssthresh) {
+		/* Slow start */
+		tcp->cwnd += MIN(acked, mss);
+	} else {
+		/* Congestion avoidance, about one segment per RTT */
+		tcp->cwnd += MAX(1U, mss * mss / tcp->cwnd);
+	}
+
+	tcp->cwnd = MIN(tcp->cwnd, MAX_CWND);
+	tcp->dup_acks = 0U;
+}
+
+static void tcp_cc_dup_ack(struct net_tcp *tcp, u32_t ack, u32_t flight)
+{
+	u32_t mss = tcp->send_mss;
+
+	if (tcp->flags & NET_TCP_FAST_RECOVERY) {
+		/* Each duplicate means that a segment left the network */
+		tcp->cwnd = MIN(tcp->cwnd + mss, MAX_CWND);
+
+		/* The peer may report more holes meanwhile */
+		if (tcp->sack_cnt) {
+			tcp_retransmit_lost(tcp);
+		}
+
+		return;
+	}
+
+	if (tcp->dup_acks < DUP_ACK_THRESHOLD) {
+		tcp->dup_acks++;
+	}
+
+	/* Losses of the window already recovered from do not count twice */
+	if (tcp->dup_acks < DUP_ACK_THRESHOLD ||
+	    !net_tcp_seq_greater(ack, tcp->recover)) {
+		return;
+	}
+
+	NET_DBG("[%p] fast retransmit, flight %u", tcp, flight);
+
+	tcp->ssthresh = MAX(flight / 2, 2 * mss);
+	tcp->cwnd = tcp->ssthresh + 3 * mss;
+	tcp->recover = ack + flight;
+	tcp->rexmit_high = ack;
+	tcp->flags |= NET_TCP_FAST_RECOVERY;
+
+	tcp_retransmit_lost(tcp);
+}
+
+static void tcp_cc_timeout(struct net_tcp *tcp)
+{
+	u32_t mss = tcp->send_mss;
+	struct net_pkt *pkt;
+
+	tcp->ssthresh = MAX(tcp_flight_size(tcp) / 2, 2 * mss);
+	tcp->cwnd = mss;
+	tcp->dup_acks = 0U;
+	tcp->flags &= ~NET_TCP_FAST_RECOVERY;
+
+	/* All data in flight is considered lost, except for the data
+	 * selectively acknowledged. It is sent again as the window opens
+	 * (RFC 5681, section 3.1).
+	 */
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->sent_list, pkt, sent_list) {
+		if (!net_pkt_sent(pkt) || net_pkt_queued(pkt)) {
+			continue;
+		}
+
+		if (tcp->sack_cnt && tcp_sacked(tcp, tcp_pkt_seq(pkt),
+						net_pkt_appdatalen(pkt))) {
+			continue;
+		}
+
+		net_pkt_set_sent(pkt, false);
+	}
+}
+
 static void abort_connection(struct net_tcp *tcp)
 {
 	struct net_context *ctx = tcp->context;
@@ -211,12 +678,21 @@ static void abort_connection(struct net_tcp *tcp)
 static void tcp_retry_expired(struct k_work *work)
 {
 	struct net_tcp *tcp = CONTAINER_OF(work, struct net_tcp, retry_timer);
-	struct net_pkt *pkt;
 
 	/* Double the retry period for exponential backoff and resend
 	 * the first (only the first!) unack'd packet.
 	 */
 	if (!sys_slist_is_empty(&tcp->sent_list)) {
+		if (tcp->retry_timeout_shift == 0U) {
+			tcp_cc_timeout(tcp);
+		} else {
+			/* The peer may have dropped the data it reported, the
+			 * head is then retransmitted even though it is SACKed
+			 * (RFC 2018, section 8).
+			 */
+			tcp->sack_cnt = 0U;
+		}
+
 		tcp->retry_timeout_shift++;
 
 		if (tcp->retry_timeout_shift > CONFIG_NET_TCP_RETRY_COUNT) {
@@ -226,29 +702,7 @@ static void tcp_retry_expired(struct k_work *work)
 
 		k_delayed_work_submit(&tcp->retry_timer, retry_timeout(tcp));
 
-		pkt = CONTAINER_OF(sys_slist_peek_head(&tcp->sent_list),
-				   struct net_pkt, sent_list);
-
-		if (net_pkt_sent(pkt)) {
-			do_ref_if_needed(tcp, pkt);
-			net_pkt_set_sent(pkt, false);
-		}
-
-		net_pkt_set_queued(pkt, true);
-
-		if (net_tcp_send_pkt(pkt) < 0 && !is_6lo_technology(pkt)) {
-			NET_DBG("retry %u: [%p] pkt %p send failed",
-				tcp->retry_timeout_shift, tcp, pkt);
-			net_pkt_unref(pkt);
-		} else {
-			NET_DBG("retry %u: [%p] sent pkt %p",
-				tcp->retry_timeout_shift, tcp, pkt);
-			if (IS_ENABLED(CONFIG_NET_STATISTICS_TCP) &&
-			    !is_6lo_technology(pkt)) {
-				net_stats_update_tcp_seg_rexmit(
-							net_pkt_iface(pkt));
-			}
-		}
+		tcp_retransmit_head(tcp);
 	} else if (CONFIG_NET_TCP_TIME_WAIT_DELAY != 0) {
 		if (tcp->fin_sent && tcp->fin_rcvd) {
 			NET_DBG("[%p] Closing connection (context %p)",
@@ -329,6 +783,14 @@ int net_tcp_release(struct net_tcp *tcp)
 		net_pkt_unref(pkt);
 	}
 
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&tcp->ooo_list, pkt, tmp,
+					  sent_list) {
+		sys_slist_remove(&tcp->ooo_list, NULL, &pkt->sent_list);
+		net_pkt_unref(pkt);
+	}
+
+	tcp->ooo_cnt = 0U;
+
 	retry_timer_cancel(tcp);
 	k_sem_reset(&tcp->connect_wait);
 
@@ -677,10 +1139,79 @@ static void net_tcp_set_syn_opt(struct net_tcp *tcp, u8_t *options,
 	*optionlen += NET_TCP_MSS_SIZE;
 }
 
+static void net_tcp_set_sack_perm_opt(u8_t *options, u8_t *optionlen)
+{
+	options[(*optionlen)++] = NET_TCP_NOP_OPT;
+	options[(*optionlen)++] = NET_TCP_NOP_OPT;
+	options[(*optionlen)++] = NET_TCP_SACK_PERM_OPT;
+	options[(*optionlen)++] = NET_TCP_SACK_PERM_SIZE;
+}
+
+/* Report the data received out of order, the first block holding the
+ * latest segment received (RFC 2018, section 4).
+ */
+static void net_tcp_set_sack_opt(struct net_tcp *tcp, u8_t *options,
+				 u8_t *optionlen)
+{
+	struct net_tcp_sack_block blocks[NET_TCP_SACK_BLOCKS];
+	struct net_pkt *pkt;
+	int cnt = 0;
+	int i;
+
+	*optionlen = 0U;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->ooo_list, pkt, sent_list) {
+		u32_t seq = tcp_pkt_seq(pkt);
+		u32_t end = seq + net_pkt_appdatalen(pkt);
+
+		if (cnt && !net_tcp_seq_greater(seq, blocks[cnt - 1].right)) {
+			if (net_tcp_seq_greater(end, blocks[cnt - 1].right)) {
+				blocks[cnt - 1].right = end;
+			}
+
+			continue;
+		}
+
+		if (cnt == NET_TCP_SACK_BLOCKS) {
+			break;
+		}
+
+		blocks[cnt].left = seq;
+		blocks[cnt].right = end;
+		cnt++;
+	}
+
+	if (!cnt) {
+		return;
+	}
+
+	for (i = 1; i < cnt; i++) {
+		if (!net_tcp_seq_greater(blocks[i].left, tcp->ooo_seq) &&
+		    net_tcp_seq_greater(blocks[i].right, tcp->ooo_seq)) {
+			struct net_tcp_sack_block tmp = blocks[0];
+
+			blocks[0] = blocks[i];
+			blocks[i] = tmp;
+			break;
+		}
+	}
+
+	options[(*optionlen)++] = NET_TCP_NOP_OPT;
+	options[(*optionlen)++] = NET_TCP_NOP_OPT;
+	options[(*optionlen)++] = NET_TCP_SACK_OPT;
+	options[(*optionlen)++] = 2 + cnt * NET_TCP_SACK_BLOCK_SIZE;
+
+	for (i = 0; i < cnt; i++) {
+		sys_put_be32(blocks[i].left, options + *optionlen);
+		sys_put_be32(blocks[i].right, options + *optionlen + 4);
+		*optionlen += NET_TCP_SACK_BLOCK_SIZE;
+	}
+}
+
 int net_tcp_prepare_ack(struct net_tcp *tcp, const struct sockaddr *remote,
 			struct net_pkt **pkt)
 {
-	u8_t options[NET_TCP_MAX_OPT_SIZE];
+	u8_t options[NET_TCP_SACK_OPT_MAX_SIZE];
 	u8_t optionlen;
 
 	switch (net_tcp_get_state(tcp)) {
@@ -701,8 +1232,10 @@ int net_tcp_prepare_ack(struct net_tcp *tcp, const struct sockaddr *remote,
 		return net_tcp_prepare_segment(tcp, NET_TCP_FIN | NET_TCP_ACK,
 					       0, 0, NULL, remote, pkt);
 	default:
-		return net_tcp_prepare_segment(tcp, NET_TCP_ACK, 0, 0, NULL,
-					       remote, pkt);
+		net_tcp_set_sack_opt(tcp, options, &optionlen);
+
+		return net_tcp_prepare_segment(tcp, NET_TCP_ACK, options,
+					       optionlen, NULL, remote, pkt);
 	}
 
 	return -EINVAL;
@@ -801,6 +1334,44 @@ const char *net_tcp_state_str(enum net_tcp_state state)
 	return "";
 }
 
+/* Append the data of pkt to the last queued segment if that one has not
+ * been sent yet and the result still fits in a segment.
+ */
+static bool tcp_coalesce(struct net_tcp *tcp, struct net_pkt *pkt,
+			 size_t data_len)
+{
+	sys_snode_t *node = sys_slist_peek_tail(&tcp->sent_list);
+	struct net_pkt *tail;
+	size_t tail_len;
+
+	if (!node) {
+		return false;
+	}
+
+	tail = CONTAINER_OF(node, struct net_pkt, sent_list);
+	tail_len = net_pkt_appdatalen(tail);
+
+	if (net_pkt_sent(tail) || net_pkt_queued(tail) || !tail_len ||
+	    tail_len + data_len > tcp->send_mss) {
+		return false;
+	}
+
+	net_pkt_append_buffer(tail, pkt->buffer);
+	pkt->buffer = NULL;
+	net_pkt_unref(pkt);
+
+	net_pkt_set_appdatalen(tail, tail_len + data_len);
+
+	/* Lengths and checksums are recomputed for the grown segment */
+	if (finalize_segment(tail) < 0) {
+		NET_ERR("[%p] Cannot finalize coalesced pkt %p", tcp, tail);
+	}
+
+	NET_DBG("[%p] Coalesced %zd bytes into pkt %p", tcp, data_len, tail);
+
+	return true;
+}
+
 int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
 {
 	struct net_conn *conn = (struct net_conn *)context->conn_handler;
@@ -818,13 +1389,19 @@ int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
 		return -ESHUTDOWN;
 	}
 
+	if (tcp_coalesce(context->tcp, pkt, data_len)) {
+		context->tcp->send_seq += data_len;
+		net_stats_update_tcp_sent(net_context_get_iface(context),
+					  data_len);
+		return 0;
+	}
+
 	net_pkt_set_appdatalen(pkt, net_pkt_get_len(pkt));
 
-	/* Set PSH on all packets, our window is so small that there's
-	 * no point in the remote side trying to finesse things and
-	 * coalesce packets.
+	/* PSH is set when the segment is sent as the last one queued, see
+	 * net_tcp_send_pkt().
 	 */
-	ret = net_tcp_prepare_segment(context->tcp, NET_TCP_PSH | NET_TCP_ACK,
+	ret = net_tcp_prepare_segment(context->tcp, NET_TCP_ACK,
 				      NULL, 0, NULL, &conn->remote_addr, &pkt);
 	if (ret) {
 		return ret;
@@ -838,7 +1415,7 @@ int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
 }
 
 /* This function is the sole point of *adding* packets to tcp->sent_list,
- * and should remain such.
+ * and should remain such. Packets are transmitted by tcp_send_queued().
  */
 static int net_tcp_queue_pkt(struct net_context *context, struct net_pkt *pkt)
 {
@@ -850,8 +1427,6 @@ static int net_tcp_queue_pkt(struct net_context *context, struct net_pkt *pkt)
 				      retry_timeout(context->tcp));
 	}
 
-	do_ref_if_needed(context->tcp, pkt);
-
 	return 0;
 }
 
@@ -900,6 +1475,16 @@ int net_tcp_send_pkt(struct net_pkt *pkt)
 		calc_chksum = true;
 	}
 
+	/* Push the data to the receiving application once it is the last
+	 * that we have to send (RFC 1122, 4.2.2.2).
+	 */
+	if (net_pkt_appdatalen(pkt) && !(tcp_hdr->flags & NET_TCP_PSH) &&
+	    sys_slist_peek_tail(&ctx->tcp->sent_list) == &pkt->sent_list) {
+		tcp_hdr->flags |= NET_TCP_PSH;
+		tcp_hdr->chksum = 0;
+		calc_chksum = true;
+	}
+
 	/* As we modified the header, we need to write it back.
 	 */
 	net_pkt_set_data(pkt, &tcp_access);
@@ -996,35 +1581,10 @@ static void restart_timer(struct net_tcp *tcp)
 int net_tcp_send_data(struct net_context *context, net_context_send_cb_t cb,
 		      void *token, void *user_data)
 {
-	struct net_pkt *pkt;
-
-	/* For now, just send all queued data synchronously.  Need to
-	 * add window handling and retry/ACK logic.
+	/* Whatever does not fit in the send window now is sent as ACKs
+	 * arrive, see net_tcp_ack_received().
 	 */
-	SYS_SLIST_FOR_EACH_CONTAINER(&context->tcp->sent_list, pkt, sent_list) {
-		/* Do not resend packets that were sent by expire timer */
-		if (net_pkt_queued(pkt)) {
-			NET_DBG("[%p] Skipping pkt %p because it was already "
-				"sent.", context->tcp, pkt);
-			continue;
-		}
-
-		if (!net_pkt_sent(pkt)) {
-			int ret;
-
-			NET_DBG("[%p] Sending pkt %p (%zd bytes)", context->tcp,
-				pkt, net_pkt_get_len(pkt));
-
-			ret = net_tcp_send_pkt(pkt);
-			if (ret < 0 && !is_6lo_technology(pkt)) {
-				NET_DBG("[%p] pkt %p not sent (%d)",
-					context->tcp, pkt, ret);
-				net_pkt_unref(pkt);
-			}
-
-			net_pkt_set_queued(pkt, true);
-		}
-	}
+	tcp_send_queued(context->tcp);
 
 	/* Just make the callback synchronously even if it didn't
 	 * go over the wire.  In theory it would be nice to track
@@ -1039,13 +1599,18 @@ int net_tcp_send_data(struct net_context *context, net_context_send_cb_t cb,
 	return 0;
 }
 
-bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
+bool net_tcp_ack_received(struct net_context *ctx, u32_t ack, u16_t wnd,
+			  u16_t data_len, const struct net_tcp_options *opts)
 {
 	struct net_tcp *tcp = ctx->tcp;
 	sys_slist_t *list = &ctx->tcp->sent_list;
+	u32_t flight = tcp_flight_size(tcp);
 	sys_snode_t *head;
 	struct net_pkt *pkt;
 	bool valid_ack = false;
+	bool dup_ack = false;
+	bool new_sack;
+	u32_t acked = 0U;
 
 	if (net_tcp_seq_greater(ack, ctx->tcp->send_seq)) {
 		NET_ERR("ctx %p: ACK for unsent data", ctx);
@@ -1057,6 +1622,8 @@ bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 		return false;
 	}
 
+	new_sack = tcp_sack_update(tcp, ack, opts);
+
 	while (!sys_slist_is_empty(list)) {
 		NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
 		struct net_tcp_hdr *tcp_hdr;
@@ -1108,6 +1675,15 @@ bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 		 * to and including 9.
 		 */
 		if (!net_tcp_seq_greater(ack, last_seq)) {
+			/* A duplicate ACK still asks for the oldest data in
+			 * flight, and carries neither data nor a window
+			 * update (RFC 5681, section 2). One reporting newly
+			 * received data in its SACK blocks counts even if the
+			 * application consumed data meanwhile.
+			 */
+			dup_ack = !valid_ack && flight && !data_len &&
+				  (wnd == tcp->send_wnd || new_sack) &&
+				  ack == sys_get_be32(tcp_hdr->seq);
 			break;
 		}
 
@@ -1121,11 +1697,21 @@ bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 			}
 		}
 
+		acked += net_pkt_appdatalen(pkt);
+
 		sys_slist_remove(list, NULL, head);
 		net_pkt_unref(pkt);
 		valid_ack = true;
 	}
 
+	tcp->send_wnd = wnd;
+
+	if (valid_ack) {
+		tcp_cc_ack(tcp, ack, acked);
+	} else if (dup_ack) {
+		tcp_cc_dup_ack(tcp, ack, flight);
+	}
+
 	/* Restart the timer (if needed) on a valid inbound ACK.  This isn't
 	 * quite the same behavior as per-packet retry timers, but is close in
 	 * practice (it starts retries one timer period after the connection
@@ -1136,6 +1722,9 @@ bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
 		restart_timer(ctx->tcp);
 	}
 
+	/* The window may have opened for segments held back so far */
+	tcp_send_queued(tcp);
+
 	return true;
 }
 
@@ -1335,6 +1924,37 @@ int net_tcp_parse_opts(struct net_pkt *pkt, int opt_totlen,
 				goto error;
 			}
 
+			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (optlen != 0) {
+				goto error;
+			}
+
+			opts->sack_perm = true;
+
+			break;
+		case NET_TCP_SACK_OPT:
+			if (optlen % NET_TCP_SACK_BLOCK_SIZE) {
+				goto error;
+			}
+
+			for (u8_t i = 0; i < optlen;
+			     i += NET_TCP_SACK_BLOCK_SIZE) {
+				struct net_tcp_sack_block block;
+
+				if (net_pkt_read_be32_new(pkt, &block.left) ||
+				    net_pkt_read_be32_new(pkt, &block.right)) {
+					goto error;
+				}
+
+				/* Only so many fit in a segment without
+				 * other options
+				 */
+				if (opts->sack_cnt < NET_TCP_SACK_BLOCKS) {
+					opts->sack[opts->sack_cnt++] = block;
+				}
+			}
+
 			break;
 		default:
 			if (net_pkt_skip(pkt, optlen)) {
@@ -1384,10 +2004,8 @@ static void queue_fin(struct net_context *ctx)
 
 	net_tcp_queue_pkt(ctx, pkt);
 
-	ret = net_tcp_send_pkt(pkt);
-	if (ret < 0) {
-		net_pkt_unref(pkt);
-	}
+	/* The FIN follows any data still held back */
+	tcp_send_queued(ctx->tcp);
 }
 
 int net_tcp_put(struct net_context *context)
@@ -1443,6 +2061,8 @@ int net_tcp_update_recv_wnd(struct net_context *context, s32_t delta)
 
 static int send_reset(struct net_context *context, struct sockaddr *local,
 		      struct sockaddr *remote);
+static int send_ack(struct net_context *context,
+		    struct sockaddr *remote, bool force);
 
 static void backlog_ack_timeout(struct k_work *work)
 {
@@ -1559,7 +2179,7 @@ static int tcp_backlog_syn(struct net_pkt *pkt,
 			   union net_ip_header *ip_hdr,
 			   struct net_tcp_hdr *tcp_hdr,
 			   struct net_context *context,
-			   u16_t send_mss)
+			   const struct net_tcp_options *opts)
 {
 	int empty_slot = -1;
 
@@ -1578,7 +2198,9 @@ static int tcp_backlog_syn(struct net_pkt *pkt,
 
 	tcp_backlog[empty_slot].send_seq = context->tcp->send_seq;
 	tcp_backlog[empty_slot].send_ack = context->tcp->send_ack;
-	tcp_backlog[empty_slot].send_mss = send_mss;
+	tcp_backlog[empty_slot].send_mss = opts->mss;
+	tcp_backlog[empty_slot].sack = IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+				       opts->sack_perm;
 
 	k_delayed_work_init(&tcp_backlog[empty_slot].ack_timer,
 			    backlog_ack_timeout);
@@ -1610,6 +2232,12 @@ static int tcp_backlog_ack(struct net_pkt *pkt,
 	context->tcp->send_ack = tcp_backlog[r].send_ack;
 	context->tcp->send_mss = tcp_backlog[r].send_mss;
 
+	if (tcp_backlog[r].sack) {
+		context->tcp->flags |= NET_TCP_SACK_PERMITTED;
+	}
+
+	tcp_cc_init(context->tcp, sys_get_be16(tcp_hdr->wnd));
+
 	k_delayed_work_cancel(&tcp_backlog[r].ack_timer);
 	(void)memset(&tcp_backlog[r], 0, sizeof(struct tcp_backlog_entry));
 
@@ -1650,9 +2278,25 @@ static void handle_fin_timeout(struct k_work *work)
 
 static void handle_ack_timeout(struct k_work *work)
 {
-	/* This means that we did not receive ACK response in time. */
 	struct net_tcp *tcp = CONTAINER_OF(work, struct net_tcp, ack_timer);
+	bool delayed;
 
+	/* The delay of an ACK for received data is over.  Once a FIN
+	 * was received nothing is delayed, and the timer is the guard
+	 * against a missing last ACK instead.
+	 */
+	k_mutex_lock(&tcp->context->lock, K_FOREVER);
+	delayed = tcp->sent_ack != tcp->send_ack;
+	if (delayed) {
+		send_ack(tcp->context, &tcp->context->remote, false);
+	}
+	k_mutex_unlock(&tcp->context->lock);
+
+	if (delayed) {
+		return;
+	}
+
+	/* This means that we did not receive ACK response in time. */
 	NET_DBG("Did not receive ACK in %dms while in %s", ACK_TIMEOUT,
 		net_tcp_state_str(net_tcp_get_state(tcp)));
 
@@ -1791,7 +2435,7 @@ static void print_send_info(struct net_pkt *pkt,
 static inline int send_syn_segment(struct net_context *context,
 				       const struct sockaddr_ptr *local,
 				       const struct sockaddr *remote,
-				       int flags, const char *msg)
+				       int flags, bool sack, const char *msg)
 {
 	struct net_pkt *pkt = NULL;
 	int ret;
@@ -1802,6 +2446,10 @@ static inline int send_syn_segment(struct net_context *context,
 		net_tcp_set_syn_opt(context->tcp, options, &optionlen);
 	}
 
+	if (sack) {
+		net_tcp_set_sack_perm_opt(options, &optionlen);
+	}
+
 	ret = net_tcp_prepare_segment(context->tcp, flags, options, optionlen,
 				      local, remote, &pkt);
 	if (ret) {
@@ -1826,15 +2474,17 @@ static inline int send_syn(struct net_context *context,
 {
 	net_tcp_change_state(context->tcp, NET_TCP_SYN_SENT);
 
-	return send_syn_segment(context, NULL, remote, NET_TCP_SYN, "SYN");
+	return send_syn_segment(context, NULL, remote, NET_TCP_SYN,
+				IS_ENABLED(CONFIG_NET_TCP_SACK), "SYN");
 }
 
+/* SACK is permitted in the SYN-ACK only if the peer permitted it first */
 static inline int send_syn_ack(struct net_context *context,
 			       struct sockaddr_ptr *local,
-			       struct sockaddr *remote)
+			       struct sockaddr *remote, bool sack)
 {
 	return send_syn_segment(context, local, remote,
-				    NET_TCP_SYN | NET_TCP_ACK,
+				    NET_TCP_SYN | NET_TCP_ACK, sack,
 				    "SYN_ACK");
 }
 
@@ -1888,6 +2538,112 @@ static int send_reset(struct net_context *context,
 	return ret;
 }
 
+/* Keep a segment received ahead of the next one expected, until the data
+ * in between arrives (RFC 2018). The queue is sorted by sequence number.
+ */
+static bool tcp_ooo_queue(struct net_tcp *tcp, struct net_pkt *pkt,
+			  u32_t seq, u8_t tcp_flags)
+{
+	u16_t len = net_pkt_appdatalen(pkt);
+	sys_snode_t *prev = NULL;
+	struct net_pkt *cur;
+
+	if (!(tcp->flags & NET_TCP_SACK_PERMITTED) || !len ||
+	    (tcp_flags & (NET_TCP_SYN | NET_TCP_FIN)) ||
+	    tcp->ooo_cnt >= OOO_QUEUE_LEN ||
+	    k_mem_slab_num_free_get(pkt->slab) < OOO_MIN_FREE_PKTS) {
+		return false;
+	}
+
+	if (net_tcp_seq_greater(seq + len, tcp->send_ack +
+				net_tcp_get_recv_wnd(tcp))) {
+		return false;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp->ooo_list, cur, sent_list) {
+		u32_t cur_seq = tcp_pkt_seq(cur);
+
+		if (cur_seq == seq) {
+			return false;
+		}
+
+		if (net_tcp_seq_greater(cur_seq, seq)) {
+			break;
+		}
+
+		prev = &cur->sent_list;
+	}
+
+	sys_slist_insert(&tcp->ooo_list, prev, &pkt->sent_list);
+	tcp->ooo_cnt++;
+	tcp->ooo_seq = seq;
+
+	return true;
+}
+
+/* Pass on the kept segments that are now in sequence. They have no IP
+ * and TCP headers to give to the receive callback any more.
+ */
+static void tcp_ooo_deliver(struct net_context *context,
+			    struct net_conn *conn)
+{
+	struct net_tcp *tcp = context->tcp;
+	sys_snode_t *node;
+
+	while ((node = sys_slist_peek_head(&tcp->ooo_list))) {
+		struct net_pkt *pkt = CONTAINER_OF(node, struct net_pkt,
+						   sent_list);
+		u32_t seq = tcp_pkt_seq(pkt);
+		u16_t len = net_pkt_appdatalen(pkt);
+		u32_t skip = tcp->send_ack - seq;
+
+		if (net_tcp_seq_greater(seq, tcp->send_ack)) {
+			break;
+		}
+
+		sys_slist_remove(&tcp->ooo_list, NULL, node);
+		tcp->ooo_cnt--;
+
+		if (skip >= len) {
+			net_pkt_unref(pkt);
+			continue;
+		}
+
+		/* The start of the segment was received again meanwhile */
+		if (skip) {
+			net_pkt_set_overwrite(pkt, true);
+			net_pkt_skip(pkt, skip);
+			net_pkt_set_appdata(pkt, net_pkt_cursor_get_pos(pkt));
+			net_pkt_set_appdatalen(pkt, len - skip);
+		}
+
+		if (net_context_packet_received(conn, pkt, NULL, NULL,
+						tcp->recv_user_data) ==
+		    NET_DROP) {
+			net_pkt_unref(pkt);
+		}
+
+		tcp->send_ack += len - skip;
+	}
+}
+
+/* Received data may be acknowledged later, hopefully together with
+ * outgoing data or with more received data (RFC 1122, 4.2.3.2). An ACK
+ * is sent right away for two full-sized segments, or when half of the
+ * window offered to the peer is used up.
+ */
+static bool delay_ack(struct net_tcp *tcp, u16_t data_len, u8_t tcp_flags)
+{
+	u32_t pending = tcp->send_ack - tcp->sent_ack;
+
+	if (!ACK_DELAY || !data_len || (tcp_flags & NET_TCP_FIN)) {
+		return false;
+	}
+
+	return pending < 2 * net_tcp_get_recv_mss(tcp) &&
+	       pending < net_tcp_get_recv_wnd(tcp);
+}
+
 /* This is called when we receive data after the connection has been
  * established. The core TCP logic is located here.
  *
@@ -1902,9 +2658,11 @@ NET_CONN_CB(tcp_established)
 {
 	struct net_context *context = (struct net_context *)user_data;
 	struct net_tcp_hdr *tcp_hdr = proto_hdr->tcp;
+	struct net_tcp_options tcp_opts = { 0 };
 	enum net_verdict ret = NET_OK;
 	u8_t tcp_flags;
 	u16_t data_len;
+	bool gap;
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
@@ -1921,6 +2679,22 @@ NET_CONN_CB(tcp_established)
 
 	tcp_flags = NET_TCP_FLAGS(tcp_hdr);
 
+	/* The data follows the options */
+	if (net_tcp_parse_opts(pkt, NET_TCP_HDR_LEN(tcp_hdr) -
+			       sizeof(struct net_tcp_hdr), &tcp_opts) < 0) {
+		ret = NET_DROP;
+		goto unlock;
+	}
+
+	net_pkt_set_appdatalen(pkt, net_pkt_get_len(pkt) -
+			       net_pkt_ip_hdr_len(pkt) -
+			       net_pkt_ipv6_ext_len(pkt) -
+			       NET_TCP_HDR_LEN(tcp_hdr));
+
+	net_pkt_set_appdata(pkt, net_pkt_cursor_get_pos(pkt));
+
+	data_len = net_pkt_appdatalen(pkt);
+
 	if (net_tcp_seq_cmp(sys_get_be32(tcp_hdr->seq),
 			    context->tcp->send_ack) < 0) {
 		/* Peer sent us packet we've already seen. Apparently,
@@ -1938,11 +2712,24 @@ resend_ack:
 
 	if (net_tcp_seq_cmp(sys_get_be32(tcp_hdr->seq),
 			    context->tcp->send_ack) > 0) {
-		/* Don't try to reorder packets.  If it doesn't
-		 * match the next segment exactly, drop and wait for
-		 * retransmit
+		/* Data is missing before this segment. It is kept until
+		 * the missing data arrives if SACK is in use, otherwise
+		 * dropped and waited for again. Either way, the peer is
+		 * told right away (RFC 5681, section 4.2).
 		 */
-		ret = NET_DROP;
+		if (tcp_flags & NET_TCP_RST) {
+			ret = NET_DROP;
+			goto unlock;
+		}
+
+		if (tcp_ooo_queue(context->tcp, pkt,
+				  sys_get_be32(tcp_hdr->seq), tcp_flags)) {
+			ret = NET_OK;
+		} else {
+			ret = NET_DROP;
+		}
+
+		send_ack(context, &conn->remote_addr, true);
 		goto unlock;
 	}
 
@@ -1976,7 +2763,9 @@ resend_ack:
 	/* Handle TCP state transition */
 	if (tcp_flags & NET_TCP_ACK) {
 		if (!net_tcp_ack_received(context,
-					  sys_get_be32(tcp_hdr->ack))) {
+					  sys_get_be32(tcp_hdr->ack),
+					  sys_get_be16(tcp_hdr->wnd),
+					  data_len, &tcp_opts)) {
 			ret = NET_DROP;
 			goto unlock;
 		}
@@ -2022,14 +2811,6 @@ resend_ack:
 		context->tcp->fin_rcvd = 1;
 	}
 
-	net_pkt_set_appdatalen(pkt, net_pkt_get_len(pkt) -
-			       net_pkt_ip_hdr_len(pkt) -
-			       net_pkt_ipv6_ext_len(pkt) -
-			       NET_TCP_HDR_LEN(tcp_hdr));
-
-	net_pkt_set_appdata(pkt, net_pkt_cursor_get_pos(pkt));
-
-	data_len = net_pkt_appdatalen(pkt);
 	if (data_len > net_tcp_get_recv_wnd(context->tcp)) {
 		/* In case we have zero window, we should still accept
 		 * Zero Window Probes from peer, which per convention
@@ -2066,7 +2847,22 @@ resend_ack:
 		context->tcp->send_ack += 1;
 	}
 
-	send_ack(context, &conn->remote_addr, false);
+	/* A segment filling a gap is acknowledged right away, as it
+	 * usually is a retransmission (RFC 5681, section 4.2).
+	 */
+	gap = !sys_slist_is_empty(&context->tcp->ooo_list);
+	if (gap) {
+		tcp_ooo_deliver(context, conn);
+	}
+
+	if (!gap && delay_ack(context->tcp, data_len, tcp_flags)) {
+		if (!k_delayed_work_remaining_get(&context->tcp->ack_timer)) {
+			k_delayed_work_submit(&context->tcp->ack_timer,
+					      ACK_DELAY);
+		}
+	} else {
+		send_ack(context, &conn->remote_addr, false);
+	}
 
 clean_up:
 	if (net_tcp_get_state(context->tcp) == NET_TCP_TIME_WAIT) {
@@ -2149,9 +2945,18 @@ NET_CONN_CB(tcp_synack_received)
 		/* Remove the temporary connection handler and register
 		 * a proper now as we have an established connection.
 		 */
+		struct net_tcp_options tcp_opts = {
+			.mss = NET_TCP_DEFAULT_MSS,
+		};
 		struct sockaddr local_addr;
 		struct sockaddr remote_addr;
 
+		if (net_tcp_parse_opts(pkt, NET_TCP_HDR_LEN(tcp_hdr) -
+				       sizeof(struct net_tcp_hdr),
+				       &tcp_opts) < 0) {
+			return NET_DROP;
+		}
+
 		tcp_copy_ip_addr_from_hdr(net_pkt_family(pkt), ip_hdr, tcp_hdr,
 					  &remote_addr, true);
 		tcp_copy_ip_addr_from_hdr(net_pkt_family(pkt), ip_hdr, tcp_hdr,
@@ -2173,6 +2978,16 @@ NET_CONN_CB(tcp_synack_received)
 			return NET_DROP;
 		}
 
+		/* Segments that neither end has to fragment */
+		context->tcp->send_mss = MIN(tcp_opts.mss,
+					     net_tcp_get_recv_mss(context->tcp));
+
+		if (IS_ENABLED(CONFIG_NET_TCP_SACK) && tcp_opts.sack_perm) {
+			context->tcp->flags |= NET_TCP_SACK_PERMITTED;
+		}
+
+		tcp_cc_init(context->tcp, sys_get_be16(tcp_hdr->wnd));
+
 		net_tcp_change_state(context->tcp, NET_TCP_ESTABLISHED);
 		net_context_set_state(context, NET_CONTEXT_CONNECTED);
 
@@ -2303,7 +3118,7 @@ NET_CONN_CB(tcp_syn_rcvd)
 		/* Get MSS from TCP options here*/
 
 		r = tcp_backlog_syn(pkt, ip_hdr, tcp_hdr,
-				    context, tcp_opts.mss);
+				    context, &tcp_opts);
 		if (r < 0) {
 			if (r == -EADDRINUSE) {
 				NET_DBG("TCP connection already exists");
@@ -2317,7 +3132,9 @@ NET_CONN_CB(tcp_syn_rcvd)
 		get_sockaddr_ptr(ip_hdr, tcp_hdr,
 				 net_context_get_family(context),
 				 &pkt_src_addr);
-		send_syn_ack(context, &pkt_src_addr, &remote_addr);
+		send_syn_ack(context, &pkt_src_addr, &remote_addr,
+			     IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+			     tcp_opts.sack_perm);
 		net_pkt_unref(pkt);
 		return NET_OK;
 	}
@@ -29,7 +29,11 @@ extern "C" {
 /** Is this TCP context/socket used or not */
 #define NET_TCP_IN_USE BIT(0)
 
-/* BIT(1), BIT(2) are unused and available */
+/** Fast recovery after a fast retransmit is in progress */
+#define NET_TCP_FAST_RECOVERY BIT(1)
+
+/** Selective acknowledgements have been negotiated with the peer */
+#define NET_TCP_SACK_PERMITTED BIT(2)
 
 /** Is the socket shutdown for read/write */
 #define NET_TCP_IS_SHUTDOWN BIT(3)
@@ -90,16 +94,38 @@ enum net_tcp_state {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+
+/* Max SACK blocks in a segment, all that fit in the options space when
+ * no timestamps are used (RFC 2018, section 3)
+ */
+#define NET_TCP_SACK_BLOCKS       4
+
+/* Max size of the SACK option, including the two NOPs aligning it */
+#define NET_TCP_SACK_OPT_MAX_SIZE \
+	(4 + NET_TCP_SACK_BLOCKS * NET_TCP_SACK_BLOCK_SIZE)
+
+/** Block of contiguous data [left, right) selectively acknowledged */
+struct net_tcp_sack_block {
+	u32_t left;
+	u32_t right;
+};
 
 /** Parsed TCP option values for net_tcp_parse_opts()  */
 struct net_tcp_options {
 	u16_t mss;
+	bool sack_perm;
+	u8_t sack_cnt;
+	struct net_tcp_sack_block sack[NET_TCP_SACK_BLOCKS];
 };
 
 /* Max received bytes to buffer internally */
@@ -161,6 +187,43 @@ struct net_tcp {
 	 */
 	u16_t send_mss;
 
+	/**
+	 * Receive window last advertised by the peer
+	 */
+	u16_t send_wnd;
+
+	/** Number of duplicate ACKs received in a row */
+	u8_t dup_acks;
+
+	/** Congestion window, in bytes */
+	u32_t cwnd;
+
+	/** Slow start threshold, in bytes */
+	u32_t ssthresh;
+
+	/** Highest sequence number sent when fast recovery was entered */
+	u32_t recover;
+
+	/** Sent data selectively acknowledged by the peer */
+	struct net_tcp_sack_block sacked[NET_TCP_SACK_BLOCKS];
+
+	/** Number of valid blocks in sacked */
+	u8_t sack_cnt;
+
+	/** Number of segments in ooo_list */
+	u8_t ooo_cnt;
+
+	/** Sequence number following the data retransmitted in the current
+	 * fast recovery
+	 */
+	u32_t rexmit_high;
+
+	/** Segments received out of order, sorted by sequence number */
+	sys_slist_t ooo_list;
+
+	/** Sequence number of the latest segment added to ooo_list */
+	u32_t ooo_seq;
+
 	/** Current retransmit period */
 	u32_t retry_timeout_shift : 5;
 	/** Flags for the TCP */
@@ -357,11 +420,18 @@ int net_tcp_send_pkt(struct net_pkt *pkt);
 /**
  * @brief Handle a received TCP ACK
  *
+ * Acknowledged segments are released, the congestion window is updated
+ * and queued segments that now fit in the send window are transmitted.
+ *
  * @param cts Context
  * @param seq Received ACK sequence number
+ * @param wnd Window advertised by the peer in the segment
+ * @param data_len Length of the data carried by the segment
+ * @param opts Options of the segment, for its SACK blocks
  * @return False if ACK sequence number is invalid, true otherwise
  */
-bool net_tcp_ack_received(struct net_context *ctx, u32_t ack);
+bool net_tcp_ack_received(struct net_context *ctx, u32_t ack, u16_t wnd,
+			  u16_t data_len, const struct net_tcp_options *opts);
 
 /**
  * @brief Calculates and returns the MSS for a given TCP context
@@ -611,10 +681,15 @@ static inline int net_tcp_send_pkt(struct net_pkt *pkt)
 	return 0;
 }
 
-static inline bool net_tcp_ack_received(struct net_context *ctx, u32_t ack)
+static inline bool net_tcp_ack_received(struct net_context *ctx, u32_t ack,
+					u16_t wnd, u16_t data_len,
+					const struct net_tcp_options *opts)
 {
 	ARG_UNUSED(ctx);
 	ARG_UNUSED(ack);
+	ARG_UNUSED(wnd);
+	ARG_UNUSED(data_len);
+	ARG_UNUSED(opts);
 	return false;
 }
 
@@ -400,32 +400,97 @@ int net_addr_pton(sa_family_t family, const char *src,
 	return 0;
 }
 
+/* Native endian value of two consecutive bytes */
+static inline u16_t chksum_pair(u8_t first, u8_t second)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	return first | (second << 8);
+#else
+	return (first << 8) | second;
+#endif
+}
+
+static inline u32_t chksum_word(const u8_t *data)
+{
+	u32_t word;
+
+	memcpy(&word, __builtin_assume_aligned(data, 4), sizeof(word));
+
+	return word;
+}
+
+/* One's complement sum of the data as big endian 16-bit words, added to
+ * the given sum.
+ *
+ * The data is summed as native endian 32-bit words into a 64-bit
+ * accumulator, and the carries are folded back once at the end. As the one's
+ * complement sum does not depend on the byte order, the result only needs to
+ * be byte swapped afterwards (RFC 1071, section 2).
+ */
 static u16_t calc_chksum(u16_t sum, const u8_t *data, size_t len)
 {
-	const u8_t *end;
-	u16_t tmp;
+	bool odd = (uintptr_t)data & 1;
+	u64_t acc = 0U;
+	u32_t tmp;
 
-	end = data + len - 1;
+	if (!len) {
+		return sum;
+	}
 
-	while (data < end) {
-		tmp = (data[0] << 8) + data[1];
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	/* Start on a 16-bit boundary. Summing the first byte as the second
+	 * half of a word swaps the bytes of the result, which is undone below.
+	 */
+	if (odd) {
+		acc = chksum_pair(0, *data++);
+		len--;
+	}
 
+	if (((uintptr_t)data & 2) && len >= 2) {
+		acc += chksum_pair(data[0], data[1]);
 		data += 2;
+		len -= 2;
 	}
 
-	if (data == end) {
-		tmp = data[0] << 8;
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	while (len >= 16) {
+		acc += chksum_word(data);
+		acc += chksum_word(data + 4);
+		acc += chksum_word(data + 8);
+		acc += chksum_word(data + 12);
+		data += 16;
+		len -= 16;
 	}
 
-	return sum;
+	while (len >= 4) {
+		acc += chksum_word(data);
+		data += 4;
+		len -= 4;
+	}
+
+	if (len >= 2) {
+		acc += chksum_pair(data[0], data[1]);
+		data += 2;
+		len -= 2;
+	}
+
+	if (len) {
+		acc += chksum_pair(data[0], 0);
+	}
+
+	acc = (acc & 0xffffffff) + (acc >> 32);
+	acc = (acc & 0xffffffff) + (acc >> 32);
+	tmp = (acc & 0xffff) + (acc >> 16);
+	tmp = (tmp & 0xffff) + (tmp >> 16);
+	tmp = (tmp & 0xffff) + (tmp >> 16);
+
+	tmp = sys_be16_to_cpu(tmp);
+	if (odd) {
+		tmp = ((tmp & 0xff) << 8) | (tmp >> 8);
+	}
+
+	tmp += sum;
+	tmp = (tmp & 0xffff) + (tmp >> 16);
+
+	return tmp;
 }
 
 static inline u16_t pkt_calc_chksum(struct net_pkt *pkt, u16_t sum)
@@ -513,17 +578,22 @@ u16_t net_calc_chksum(struct net_pkt *pkt, u8_t proto)
 	return ~sum;
 }
 
-#if defined(CONFIG_NET_IPV4)
-u16_t net_calc_chksum_ipv4(struct net_pkt *pkt)
+u16_t net_calc_chksum_buf(const void *data, size_t len)
 {
 	u16_t sum;
 
-	sum = calc_chksum(0, pkt->buffer->data, NET_IPV4H_LEN);
+	sum = calc_chksum(0, data, len);
 
 	sum = (sum == 0) ? 0xffff : htons(sum);
 
 	return ~sum;
 }
+
+#if defined(CONFIG_NET_IPV4)
+u16_t net_calc_chksum_ipv4(struct net_pkt *pkt)
+{
+	return net_calc_chksum_buf(pkt->buffer->data, NET_IPV4H_LEN);
+}
 #endif /* CONFIG_NET_IPV4 */
 
 #if defined(CONFIG_NET_IPV6) || defined(CONFIG_NET_IPV4)
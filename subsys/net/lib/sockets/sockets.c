@@ -423,9 +423,8 @@ Z_SYSCALL_HANDLER(zsock_accept, sock, addr, addrlen)
 }
 #endif /* CONFIG_USERSPACE */
 
-ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
-			 int flags,
-			 const struct sockaddr *dest_addr, socklen_t addrlen)
+ssize_t zsock_sendmsg_ctx(struct net_context *ctx,
+			  const struct zsock_msghdr *msg, int flags)
 {
 	s32_t timeout = K_FOREVER;
 	int status;
@@ -444,15 +443,9 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 		return -1;
 	}
 
-	if (dest_addr) {
-		status = net_context_sendto_new(ctx, buf, len, dest_addr,
-						addrlen, NULL, timeout,
-						NULL, ctx->user_data);
-	} else {
-		status = net_context_send_new(ctx, buf, len, NULL, timeout,
-					      NULL, ctx->user_data);
-	}
-
+	status = net_context_sendmsg(ctx, msg->msg_iov, msg->msg_iovlen,
+				     msg->msg_name, msg->msg_namelen, NULL,
+				     timeout, NULL, ctx->user_data);
 	if (status < 0) {
 		errno = -status;
 		return -1;
@@ -461,6 +454,54 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 	return status;
 }
 
+ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
+			 int flags,
+			 const struct sockaddr *dest_addr, socklen_t addrlen)
+{
+	struct k_iovec iov = {
+		.iov_base = (void *)buf,
+		.iov_len = len,
+	};
+	struct zsock_msghdr msg = {
+		.msg_name = (void *)dest_addr,
+		.msg_namelen = addrlen,
+		.msg_iov = &iov,
+		.msg_iovlen = 1,
+	};
+
+	return zsock_sendmsg_ctx(ctx, &msg, flags);
+}
+
+int zsock_sendmmsg_ctx(struct net_context *ctx, struct zsock_mmsghdr *msgvec,
+		       unsigned int vlen, int flags)
+{
+	unsigned int i;
+	ssize_t len;
+
+	if (!vlen) {
+		return 0;
+	}
+
+	/* Queue the whole batch before the TX thread gets to run, so that
+	 * it is woken up once rather than for every packet.
+	 */
+	k_sched_lock();
+
+	for (i = 0; i < vlen; i++) {
+		len = zsock_sendmsg_ctx(ctx, &msgvec[i].msg_hdr, flags);
+		if (len < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = len;
+	}
+
+	k_sched_unlock();
+
+	/* An error is only reported if nothing was sent */
+	return i ? i : -1;
+}
+
 ssize_t _impl_zsock_sendto(int sock, const void *buf, size_t len, int flags,
 			   const struct sockaddr *dest_addr, socklen_t addrlen)
 {
@@ -485,6 +526,253 @@ Z_SYSCALL_HANDLER(zsock_sendto, sock, buf, len, flags, dest_addr, addrlen)
 }
 #endif /* CONFIG_USERSPACE */
 
+ssize_t _impl_zsock_sendmsg(int sock, const struct zsock_msghdr *msg,
+			    int flags)
+{
+	const struct socket_op_vtable *vtable;
+	void *ctx = get_sock_vtable(sock, &vtable);
+
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	return vtable->sendmsg(ctx, msg, flags);
+}
+
+#ifdef CONFIG_USERSPACE
+/* Replace the buffer array of a message header copied from user mode by a
+ * kernel copy, and check that the buffers can be accessed. The copy is
+ * freed by the caller.
+ */
+static int sock_user_iov_copy(struct zsock_msghdr *msg, bool write)
+{
+	struct k_iovec *iov;
+	size_t iov_size;
+
+	/* No ancillary data is supported */
+	msg->msg_control = NULL;
+	msg->msg_controllen = 0;
+
+	if (!msg->msg_iovlen) {
+		msg->msg_iov = NULL;
+		return 0;
+	}
+
+	if (__builtin_mul_overflow(msg->msg_iovlen, sizeof(struct k_iovec),
+				   &iov_size)) {
+		msg->msg_iov = NULL;
+		return -EFAULT;
+	}
+
+	iov = z_user_alloc_from_copy(msg->msg_iov, iov_size);
+	msg->msg_iov = iov;
+	if (!iov) {
+		return -ENOMEM;
+	}
+
+	for (size_t i = 0; i < msg->msg_iovlen; i++) {
+		if (write ?
+		    Z_SYSCALL_MEMORY_WRITE(iov[i].iov_base, iov[i].iov_len) :
+		    Z_SYSCALL_MEMORY_READ(iov[i].iov_base, iov[i].iov_len)) {
+			return -EFAULT;
+		}
+	}
+
+	return 0;
+}
+
+/* Copy a message header and its buffer array from user mode */
+static int sock_user_msg_copy(struct zsock_msghdr *msg_copy,
+			      const struct zsock_msghdr *msg, bool write)
+{
+	int ret;
+
+	if (z_user_from_copy(msg_copy, (void *)msg, sizeof(*msg_copy))) {
+		return -EFAULT;
+	}
+
+	ret = sock_user_iov_copy(msg_copy, write);
+	if (ret < 0) {
+		k_free(msg_copy->msg_iov);
+	}
+
+	return ret;
+}
+
+/* Free a message vector copied by sock_user_mmsg_copy(). The peer
+ * addresses were only copied for sending.
+ */
+static void sock_mmsg_free(struct zsock_mmsghdr *msgvec, unsigned int vlen,
+			   bool write)
+{
+	for (unsigned int i = 0; i < vlen; i++) {
+		k_free(msgvec[i].msg_hdr.msg_iov);
+		if (!write) {
+			k_free(msgvec[i].msg_hdr.msg_name);
+		}
+	}
+
+	k_free(msgvec);
+}
+
+/* Copy a message vector from user mode, with the buffer array of each
+ * message, and check that the buffers can be accessed. The peer
+ * addresses to send to are copied as well, as they are read after this
+ * check; those to receive into are only checked.
+ */
+static int sock_user_mmsg_copy(struct zsock_mmsghdr **msgvec_copy,
+			       struct zsock_mmsghdr *msgvec, unsigned int vlen,
+			       bool write)
+{
+	struct zsock_mmsghdr *copy;
+	size_t size;
+	unsigned int i;
+	int ret = 0;
+
+	if (!vlen) {
+		*msgvec_copy = NULL;
+		return 0;
+	}
+
+	if (__builtin_mul_overflow(vlen, sizeof(*copy), &size)) {
+		return -EFAULT;
+	}
+
+	copy = z_user_alloc_from_copy(msgvec, size);
+	if (!copy) {
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < vlen; i++) {
+		struct zsock_msghdr *msg = &copy[i].msg_hdr;
+
+		if (msg->msg_name && write) {
+			if (Z_SYSCALL_MEMORY_WRITE(msg->msg_name,
+						   msg->msg_namelen)) {
+				ret = -EFAULT;
+			}
+		} else if (msg->msg_name) {
+			void *name = NULL;
+
+			if (msg->msg_namelen <=
+			    sizeof(struct sockaddr_storage)) {
+				name = z_user_alloc_from_copy(msg->msg_name,
+							      msg->msg_namelen);
+			}
+
+			msg->msg_name = name;
+			if (!name) {
+				ret = -EFAULT;
+			}
+		}
+
+		if (ret < 0) {
+			/* Not copied yet */
+			msg->msg_iov = NULL;
+			break;
+		}
+
+		ret = sock_user_iov_copy(msg, write);
+		if (ret < 0) {
+			break;
+		}
+	}
+
+	if (ret < 0) {
+		/* Only the messages up to the failed one own a copy */
+		sock_mmsg_free(copy, i + 1, write);
+		return ret;
+	}
+
+	*msgvec_copy = copy;
+
+	return 0;
+}
+
+Z_SYSCALL_HANDLER(zsock_sendmsg, sock, msg, flags)
+{
+	struct zsock_msghdr msg_copy;
+	struct sockaddr_storage addr_copy;
+	ssize_t ret;
+
+	ret = sock_user_msg_copy(&msg_copy, (struct zsock_msghdr *)msg, false);
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	if (msg_copy.msg_name) {
+		if (msg_copy.msg_namelen > sizeof(addr_copy) ||
+		    z_user_from_copy(&addr_copy, msg_copy.msg_name,
+				     msg_copy.msg_namelen)) {
+			k_free(msg_copy.msg_iov);
+			errno = EFAULT;
+			return -1;
+		}
+
+		msg_copy.msg_name = &addr_copy;
+	}
+
+	ret = _impl_zsock_sendmsg(sock, &msg_copy, flags);
+
+	k_free(msg_copy.msg_iov);
+
+	return ret;
+}
+#endif /* CONFIG_USERSPACE */
+
+int _impl_zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			 unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	void *ctx = get_sock_vtable(sock, &vtable);
+
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	if (vtable->sendmmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	return vtable->sendmmsg(ctx, msgvec, vlen, flags);
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(zsock_sendmmsg, sock, msgvec, vlen, flags)
+{
+	struct zsock_mmsghdr *msgvec_ptr = (struct zsock_mmsghdr *)msgvec;
+	struct zsock_mmsghdr *msgvec_copy;
+	bool fault = false;
+	int ret;
+
+	ret = sock_user_mmsg_copy(&msgvec_copy, msgvec_ptr, vlen, false);
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	ret = _impl_zsock_sendmmsg(sock, msgvec_copy, vlen, flags);
+
+	for (int i = 0; i < ret && !fault; i++) {
+		fault = z_user_to_copy(&msgvec_ptr[i].msg_len,
+				       &msgvec_copy[i].msg_len,
+				       sizeof(unsigned int)) != 0;
+	}
+
+	sock_mmsg_free(msgvec_copy, vlen, false);
+	Z_OOPS(fault);
+
+	return ret;
+}
+#endif /* CONFIG_USERSPACE */
+
 static int sock_get_pkt_src_addr(struct net_pkt *pkt,
 				 enum net_ip_protocol proto,
 				 struct sockaddr *addr,
@@ -586,13 +874,64 @@ error:
 	return ret;
 }
 
+/* Set the peer address of a datagram; addrlen is a value-result argument,
+ * set to actual size of source address.
+ */
+static int sock_get_src_addr(struct net_context *ctx, struct net_pkt *pkt,
+			     struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	int rv;
+
+	rv = sock_get_pkt_src_addr(pkt, net_context_get_ip_proto(ctx),
+				   src_addr, *addrlen);
+	if (rv < 0) {
+		return rv;
+	}
+
+	if (src_addr->sa_family == AF_INET) {
+		*addrlen = sizeof(struct sockaddr_in);
+	} else if (src_addr->sa_family == AF_INET6) {
+		*addrlen = sizeof(struct sockaddr_in6);
+	} else {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
+static size_t sock_iov_len(const struct k_iovec *iov, size_t iovcnt)
+{
+	size_t len = 0;
+
+	for (; iovcnt; iov++, iovcnt--) {
+		len += iov->iov_len;
+	}
+
+	return len;
+}
+
+/* Scatter len bytes of data from the packet cursor over the buffers */
+static int sock_read_iov(struct net_pkt *pkt, const struct k_iovec *iov,
+			 size_t iovcnt, size_t len)
+{
+	for (; iovcnt && len; iov++, iovcnt--) {
+		size_t chunk = MIN(iov->iov_len, len);
+
+		if (net_pkt_read_new(pkt, iov->iov_base, chunk)) {
+			return -ENOBUFS;
+		}
+
+		len -= chunk;
+	}
+
+	return 0;
+}
+
 static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
-				       void *buf,
-				       size_t max_len,
-				       int flags,
-				       struct sockaddr *src_addr,
-				       socklen_t *addrlen)
+				       struct zsock_msghdr *msg,
+				       int flags)
 {
+	size_t max_len = sock_iov_len(msg->msg_iov, msg->msg_iovlen);
 	s32_t timeout = K_FOREVER;
 	size_t recv_len = 0;
 	struct net_pkt_cursor backup;
@@ -624,35 +963,24 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 
 	net_pkt_cursor_backup(pkt, &backup);
 
-	if (src_addr && addrlen) {
+	if (msg->msg_name) {
 		int rv;
 
-		rv = sock_get_pkt_src_addr(pkt, net_context_get_ip_proto(ctx),
-					   src_addr, *addrlen);
+		rv = sock_get_src_addr(ctx, pkt, msg->msg_name,
+				       &msg->msg_namelen);
 		if (rv < 0) {
 			errno = -rv;
 			return -1;
 		}
-
-		/* addrlen is a value-result argument, set to actual
-		 * size of source address
-		 */
-		if (src_addr->sa_family == AF_INET) {
-			*addrlen = sizeof(struct sockaddr_in);
-		} else if (src_addr->sa_family == AF_INET6) {
-			*addrlen = sizeof(struct sockaddr_in6);
-		} else {
-			errno = ENOTSUP;
-			return -1;
-		}
 	}
 
 	recv_len = net_pkt_remaining_data(pkt);
 	if (recv_len > max_len) {
 		recv_len = max_len;
+		msg->msg_flags |= ZSOCK_MSG_TRUNC;
 	}
 
-	if (net_pkt_read_new(pkt, buf, recv_len)) {
+	if (sock_read_iov(pkt, msg->msg_iov, msg->msg_iovlen, recv_len)) {
 		errno = ENOBUFS;
 		return -1;
 	}
@@ -667,10 +995,10 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 }
 
 static inline ssize_t zsock_recv_stream(struct net_context *ctx,
-					void *buf,
-					size_t max_len,
+					struct zsock_msghdr *msg,
 					int flags)
 {
+	size_t max_len = sock_iov_len(msg->msg_iov, msg->msg_iovlen);
 	s32_t timeout = K_FOREVER;
 	size_t recv_len = 0;
 	struct net_pkt_cursor backup;
@@ -717,8 +1045,9 @@ static inline ssize_t zsock_recv_stream(struct net_context *ctx,
 			recv_len = max_len;
 		}
 
-		/* Actually copy data to application buffer */
-		if (net_pkt_read_new(pkt, buf, recv_len)) {
+		/* Actually copy data to application buffers */
+		if (sock_read_iov(pkt, msg->msg_iov, msg->msg_iovlen,
+				  recv_len)) {
 			errno = ENOBUFS;
 			return -1;
 		}
@@ -747,16 +1076,17 @@ static inline ssize_t zsock_recv_stream(struct net_context *ctx,
 	return recv_len;
 }
 
-ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
-			   int flags,
-			   struct sockaddr *src_addr, socklen_t *addrlen)
+ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct zsock_msghdr *msg,
+			  int flags)
 {
 	enum net_sock_type sock_type = net_context_get_type(ctx);
 
+	msg->msg_flags = 0;
+
 	if (sock_type == SOCK_DGRAM) {
-		return zsock_recv_dgram(ctx, buf, max_len, flags, src_addr, addrlen);
+		return zsock_recv_dgram(ctx, msg, flags);
 	} else if (sock_type == SOCK_STREAM) {
-		return zsock_recv_stream(ctx, buf, max_len, flags);
+		return zsock_recv_stream(ctx, msg, flags);
 	} else {
 		__ASSERT(0, "Unknown socket type");
 	}
@@ -764,6 +1094,63 @@ ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
 	return 0;
 }
 
+int zsock_recvmmsg_ctx(struct net_context *ctx, struct zsock_mmsghdr *msgvec,
+		       unsigned int vlen, int flags)
+{
+	unsigned int i;
+	ssize_t len;
+
+	for (i = 0; i < vlen; i++) {
+		len = zsock_recvmsg_ctx(ctx, &msgvec[i].msg_hdr, flags);
+		if (len < 0) {
+			/* An error is only reported if nothing was received */
+			return i ? i : -1;
+		}
+
+		if (!len && net_context_get_type(ctx) == SOCK_STREAM) {
+			/* End of stream */
+			break;
+		}
+
+		msgvec[i].msg_len = len;
+
+		/* Wait for the first message only, then take the ones
+		 * already queued.
+		 */
+		flags |= ZSOCK_MSG_DONTWAIT;
+	}
+
+	return i;
+}
+
+ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
+			   int flags,
+			   struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	struct k_iovec iov = {
+		.iov_base = buf,
+		.iov_len = max_len,
+	};
+	struct zsock_msghdr msg = {
+		.msg_iov = &iov,
+		.msg_iovlen = 1,
+	};
+	ssize_t ret;
+
+	if (src_addr && addrlen) {
+		msg.msg_name = src_addr;
+		msg.msg_namelen = *addrlen;
+	}
+
+	ret = zsock_recvmsg_ctx(ctx, &msg, flags);
+
+	if (msg.msg_name) {
+		*addrlen = msg.msg_namelen;
+	}
+
+	return ret;
+}
+
 ssize_t _impl_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 			     struct sockaddr *src_addr, socklen_t *addrlen)
 {
@@ -803,6 +1190,208 @@ Z_SYSCALL_HANDLER(zsock_recvfrom, sock, buf, max_len, flags, src_addr,
 }
 #endif /* CONFIG_USERSPACE */
 
+ssize_t _impl_zsock_recvmsg(int sock, struct zsock_msghdr *msg, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	void *ctx = get_sock_vtable(sock, &vtable);
+
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	if (vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	return vtable->recvmsg(ctx, msg, flags);
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(zsock_recvmsg, sock, msg, flags)
+{
+	struct zsock_msghdr *msg_ptr = (struct zsock_msghdr *)msg;
+	struct zsock_msghdr msg_copy;
+	ssize_t ret;
+
+	ret = sock_user_msg_copy(&msg_copy, msg_ptr, true);
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	if (msg_copy.msg_name &&
+	    Z_SYSCALL_MEMORY_WRITE(msg_copy.msg_name, msg_copy.msg_namelen)) {
+		k_free(msg_copy.msg_iov);
+		errno = EFAULT;
+		return -1;
+	}
+
+	ret = _impl_zsock_recvmsg(sock, &msg_copy, flags);
+
+	k_free(msg_copy.msg_iov);
+
+	if (ret >= 0) {
+		Z_OOPS(z_user_to_copy(&msg_ptr->msg_namelen,
+				      &msg_copy.msg_namelen,
+				      sizeof(socklen_t)));
+		Z_OOPS(z_user_to_copy(&msg_ptr->msg_flags, &msg_copy.msg_flags,
+				      sizeof(int)));
+	}
+
+	return ret;
+}
+#endif /* CONFIG_USERSPACE */
+
+int _impl_zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			 unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	void *ctx = get_sock_vtable(sock, &vtable);
+
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	if (vtable->recvmmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	return vtable->recvmmsg(ctx, msgvec, vlen, flags);
+}
+
+#ifdef CONFIG_USERSPACE
+Z_SYSCALL_HANDLER(zsock_recvmmsg, sock, msgvec, vlen, flags)
+{
+	struct zsock_mmsghdr *msgvec_ptr = (struct zsock_mmsghdr *)msgvec;
+	struct zsock_mmsghdr *msgvec_copy;
+	bool fault = false;
+	int ret;
+
+	ret = sock_user_mmsg_copy(&msgvec_copy, msgvec_ptr, vlen, true);
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	ret = _impl_zsock_recvmmsg(sock, msgvec_copy, vlen, flags);
+
+	for (int i = 0; i < ret && !fault; i++) {
+		struct zsock_mmsghdr *msg = &msgvec_ptr[i];
+
+		fault = z_user_to_copy(&msg->msg_len,
+				       &msgvec_copy[i].msg_len,
+				       sizeof(unsigned int)) ||
+			z_user_to_copy(&msg->msg_hdr.msg_namelen,
+				       &msgvec_copy[i].msg_hdr.msg_namelen,
+				       sizeof(socklen_t)) ||
+			z_user_to_copy(&msg->msg_hdr.msg_flags,
+				       &msgvec_copy[i].msg_hdr.msg_flags,
+				       sizeof(int));
+	}
+
+	sock_mmsg_free(msgvec_copy, vlen, true);
+	Z_OOPS(fault);
+
+	return ret;
+}
+#endif /* CONFIG_USERSPACE */
+
+ssize_t zsock_recv_loan(int sock, struct net_buf **frags, int flags,
+			struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	const struct socket_op_vtable *vtable;
+	struct net_context *ctx = get_sock_vtable(sock, &vtable);
+	bool stream;
+	s32_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	struct net_buf *buf;
+	size_t len;
+
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	/* The data is in the packets queued to native sockets only */
+	if (vtable != &sock_fd_op_vtable || (flags & ZSOCK_MSG_PEEK)) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	}
+
+	stream = net_context_get_type(ctx) == SOCK_STREAM;
+	if (stream && sock_is_eof(ctx)) {
+		return 0;
+	}
+
+	pkt = k_fifo_get(&ctx->recv_q, timeout);
+	if (!pkt) {
+		/* Either timeout expired, or wait was cancelled due to
+		 * connection closure by peer.
+		 */
+		if (stream && sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		errno = EAGAIN;
+		return -1;
+	}
+
+	if (!stream && src_addr && addrlen) {
+		int rv = sock_get_src_addr(ctx, pkt, src_addr, addrlen);
+
+		if (rv < 0) {
+			net_pkt_unref(pkt);
+			errno = -rv;
+			return -1;
+		}
+	}
+
+	len = net_pkt_remaining_data(pkt);
+
+	if (stream) {
+		if (net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		net_context_update_recv_wnd(ctx, len);
+	}
+
+	if (!len) {
+		net_pkt_unref(pkt);
+		*frags = NULL;
+		return 0;
+	}
+
+	/* Hand over the fragments from the cursor on, without the headers
+	 * or the data already read in front of it.
+	 */
+	buf = pkt->cursor.buf;
+	while (pkt->frags != buf) {
+		pkt->frags = net_buf_frag_del(NULL, pkt->frags);
+	}
+
+	net_buf_pull(buf, pkt->cursor.pos - buf->data);
+
+	pkt->frags = NULL;
+	net_pkt_unref(pkt);
+
+	*frags = buf;
+
+	return len;
+}
+
+void zsock_recv_loan_release(struct net_buf *frags)
+{
+	if (frags) {
+		net_buf_unref(frags);
+	}
+}
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -890,8 +1479,11 @@ int _impl_zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout)
 	int i, remaining_time;
 	struct zsock_pollfd *pfd;
 	struct k_poll_event poll_events[CONFIG_NET_SOCKETS_POLL_MAX];
+	struct k_poll_event *ready[CONFIG_NET_SOCKETS_POLL_MAX];
 	struct k_poll_event *pev;
 	struct k_poll_event *pev_end = poll_events + ARRAY_SIZE(poll_events);
+	struct k_poll_event *pev_last;
+	struct k_poll_set poll_set;
 	const struct fd_op_vtable *vtable;
 	u32_t entry_time = k_uptime_get_32();
 
@@ -932,15 +1524,26 @@ int _impl_zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout)
 		}
 	}
 
+	/* The events stay registered for all the retries, instead of
+	 * being registered again by each k_poll() call.
+	 */
+	pev_last = pev;
+	k_poll_set_init(&poll_set, 0);
+	for (pev = poll_events; pev < pev_last; pev++) {
+		k_poll_set_add(&poll_set, pev);
+	}
+
 	remaining_time = timeout;
 
 	do {
-		ret = k_poll(poll_events, pev - poll_events, remaining_time);
-		/* EAGAIN when timeout expired, EINTR when cancelled (i.e. EOF) */
-		if (ret != 0 && ret != -EAGAIN && ret != -EINTR) {
-			errno = -ret;
-			return -1;
-		}
+		/* Only fails on timeout. All the ready events are collected,
+		 * so that they have their state set, the others are
+		 * K_POLL_STATE_NOT_READY. Every pollfd is still updated
+		 * below, as some are ready without any event (POLLOUT,
+		 * EOF), so the array itself is not used.
+		 */
+		(void)k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      remaining_time);
 
 		retry = false;
 		ret = 0;
@@ -969,7 +1572,8 @@ int _impl_zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout)
 					continue;
 				}
 
-				return -1;
+				ret = -1;
+				goto out;
 			}
 
 			if (pfd->revents != 0) {
@@ -996,6 +1600,11 @@ int _impl_zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout)
 		}
 	} while (retry);
 
+out:
+	for (pev = poll_events; pev < pev_last; pev++) {
+		k_poll_set_remove(&poll_set, pev);
+	}
+
 	return ret;
 }
 
@@ -1197,6 +1806,30 @@ static ssize_t sock_recvfrom_vmeth(void *obj, void *buf, size_t max_len,
 				  src_addr, addrlen);
 }
 
+static ssize_t sock_sendmsg_vmeth(void *obj, const struct zsock_msghdr *msg,
+				  int flags)
+{
+	return zsock_sendmsg_ctx(obj, msg, flags);
+}
+
+static ssize_t sock_recvmsg_vmeth(void *obj, struct zsock_msghdr *msg,
+				  int flags)
+{
+	return zsock_recvmsg_ctx(obj, msg, flags);
+}
+
+static int sock_sendmmsg_vmeth(void *obj, struct zsock_mmsghdr *msgvec,
+			       unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg_ctx(obj, msgvec, vlen, flags);
+}
+
+static int sock_recvmmsg_vmeth(void *obj, struct zsock_mmsghdr *msgvec,
+			       unsigned int vlen, int flags)
+{
+	return zsock_recvmmsg_ctx(obj, msgvec, vlen, flags);
+}
+
 static int sock_getsockopt_vmeth(void *obj, int level, int optname,
 				 void *optval, socklen_t *optlen)
 {
@@ -1222,6 +1855,10 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.accept = sock_accept_vmeth,
 	.sendto = sock_sendto_vmeth,
 	.recvfrom = sock_recvfrom_vmeth,
+	.sendmsg = sock_sendmsg_vmeth,
+	.recvmsg = sock_recvmsg_vmeth,
+	.sendmmsg = sock_sendmmsg_vmeth,
+	.recvmmsg = sock_recvmmsg_vmeth,
 	.getsockopt = sock_getsockopt_vmeth,
 	.setsockopt = sock_setsockopt_vmeth,
 };
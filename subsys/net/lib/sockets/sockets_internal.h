@@ -41,6 +41,13 @@ struct socket_op_vtable {
 			  const struct sockaddr *dest_addr, socklen_t addrlen);
 	ssize_t (*recvfrom)(void *obj, void *buf, size_t max_len, int flags,
 			    struct sockaddr *src_addr, socklen_t *addrlen);
+	ssize_t (*sendmsg)(void *obj, const struct zsock_msghdr *msg,
+			   int flags);
+	ssize_t (*recvmsg)(void *obj, struct zsock_msghdr *msg, int flags);
+	int (*sendmmsg)(void *obj, struct zsock_mmsghdr *msgvec,
+			unsigned int vlen, int flags);
+	int (*recvmmsg)(void *obj, struct zsock_mmsghdr *msgvec,
+			unsigned int vlen, int flags);
 	int (*getsockopt)(void *obj, int level, int optname,
 			  void *optval, socklen_t *optlen);
 	int (*setsockopt)(void *obj, int level, int optname,
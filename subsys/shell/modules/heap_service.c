@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <shell/shell.h>
+#include <kernel.h>
+#include <misc/mem_stats.h>
+
+/* Linker-defined symbols bound the static pool structs */
+extern struct k_mem_pool _k_mem_pool_list_start[];
+extern struct k_mem_pool _k_mem_pool_list_end[];
+
+static void print_stats(const struct shell *shell, const char *name,
+			const void *addr, const struct sys_mem_stats *stats)
+{
+	shell_fprintf(shell, SHELL_NORMAL,
+		      "%-10s %p %8u %8u %8u %8u %3u%%\n", name, addr,
+		      (u32_t)stats->total_bytes,
+		      (u32_t)stats->allocated_bytes,
+		      (u32_t)stats->max_allocated_bytes,
+		      (u32_t)stats->largest_free_bytes,
+		      sys_mem_stats_frag_pct(stats));
+}
+
+static int cmd_heap_stats(const struct shell *shell,
+			  size_t argc, char **argv)
+{
+	struct sys_mem_stats stats;
+	struct k_mem_pool *p;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_fprintf(shell, SHELL_NORMAL,
+		      "%-10s %-10s %8s %8s %8s %8s %4s\n", "Heap", "Address",
+		      "Size", "Used", "MaxUsed", "Largest", "Frag");
+
+	if (k_malloc_stats_get(&stats) == 0) {
+		print_stats(shell, "k_malloc", NULL, &stats);
+	}
+
+#ifndef CONFIG_NEWLIB_LIBC
+	if (sys_malloc_stats_get(&stats) == 0) {
+		print_stats(shell, "malloc", NULL, &stats);
+	}
+#endif
+
+	for (p = _k_mem_pool_list_start; p < _k_mem_pool_list_end; p++) {
+		k_mem_pool_stats_get(p, &stats);
+		print_stats(shell, "k_mem_pool", p, &stats);
+	}
+
+	return 0;
+}
+
+#if CONFIG_SYS_MEM_STATS_SITES > 0
+static void print_site(const struct sys_mem_site *site, void *user_data)
+{
+	const struct shell *shell = user_data;
+
+	shell_fprintf(shell, SHELL_NORMAL, "%p %8u %8u %8u %8u\n",
+		      site->site, site->allocs, site->live,
+		      (u32_t)site->live_bytes, (u32_t)site->max_live_bytes);
+}
+
+static int cmd_heap_sites(const struct shell *shell,
+			  size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_fprintf(shell, SHELL_NORMAL, "k_malloc call sites:\n");
+	shell_fprintf(shell, SHELL_NORMAL, "%-10s %8s %8s %8s %8s\n", "Caller",
+		      "Allocs", "Live", "Bytes", "MaxBytes");
+	k_malloc_sites_foreach(print_site, (void *)shell);
+
+#ifndef CONFIG_NEWLIB_LIBC
+	shell_fprintf(shell, SHELL_NORMAL, "malloc call sites:\n");
+	shell_fprintf(shell, SHELL_NORMAL, "%-10s %8s %8s %8s %8s\n", "Caller",
+		      "Allocs", "Live", "Bytes", "MaxBytes");
+	sys_malloc_sites_foreach(print_site, (void *)shell);
+#endif
+
+	return 0;
+}
+#endif
+
+SHELL_CREATE_STATIC_SUBCMD_SET(sub_heap)
+{
+	/* Alphabetically sorted. */
+#if CONFIG_SYS_MEM_STATS_SITES > 0
+	SHELL_CMD(sites, NULL, "Allocations per call site.", cmd_heap_sites),
+#endif
+	SHELL_CMD(stats, NULL, "Heap and memory pool usage.", cmd_heap_stats),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+};
+
+SHELL_CMD_REGISTER(heap, &sub_heap, "Heap commands", NULL);
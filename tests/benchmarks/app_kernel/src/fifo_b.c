@@ -61,6 +61,28 @@ void queue_test(void)
 	PRINT_F(output_file, FORMAT, "dequeue 4 bytes msg in FIFO",
 			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
 
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i += NR_OF_FIFO_BATCH) {
+		k_msgq_put_many(&DEMOQX4, data_bench, NR_OF_FIFO_BATCH,
+				K_FOREVER);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "enqueue 4 bytes msg in FIFO, batched",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i += NR_OF_FIFO_BATCH) {
+		k_msgq_get_many(&DEMOQX4, data_bench, NR_OF_FIFO_BATCH,
+				K_FOREVER);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "dequeue 4 bytes msg in FIFO, batched",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
 	k_sem_give(&STARTRCV);
 
 	et = BENCH_START();
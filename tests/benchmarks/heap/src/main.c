@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <misc/printk.h>
+
+#define HEAP_SIZE CONFIG_HEAP_MEM_POOL_SIZE
+#define MAX_LIVE 256
+#define CHURN_SLOTS 48
+#define CHURN_OPS 200000
+
+static void *ptrs[MAX_LIVE];
+static u32_t rand_state = 0x2545f491;
+
+/* xorshift32: deterministic so both backends see the same requests */
+static u32_t next_rand(void)
+{
+	u32_t x = rand_state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	rand_state = x;
+
+	return x;
+}
+
+static size_t rand_in(size_t lo, size_t hi)
+{
+	return lo + next_rand() % (hi - lo + 1);
+}
+
+static size_t next_size(void)
+{
+	u32_t pct = next_rand() % 100;
+
+	if (pct < 70) {
+		return rand_in(8, 64);
+	} else if (pct < 95) {
+		return rand_in(65, 512);
+	} else {
+		return rand_in(513, 2048);
+	}
+}
+
+static void utilization(void)
+{
+	size_t requested = 0;
+	int n;
+
+	for (n = 0; n < MAX_LIVE; n++) {
+		size_t sz = next_size();
+
+		ptrs[n] = k_malloc(sz);
+		if (ptrs[n] == NULL) {
+			break;
+		}
+		requested += sz;
+	}
+
+	printk("utilization: %u bytes requested at first failure (%u%%)\n",
+	       (u32_t)requested, (u32_t)(requested * 100 / HEAP_SIZE));
+
+	while (n-- > 0) {
+		k_free(ptrs[n]);
+	}
+}
+
+static void churn(void)
+{
+	u64_t alloc_cycles = 0, free_cycles = 0;
+	u32_t allocs = 0, frees = 0, failures = 0;
+
+	for (int i = 0; i < CHURN_OPS; i++) {
+		int slot = next_rand() % CHURN_SLOTS;
+		u32_t t0;
+
+		if (ptrs[slot] != NULL) {
+			t0 = k_cycle_get_32();
+			k_free(ptrs[slot]);
+			free_cycles += k_cycle_get_32() - t0;
+			ptrs[slot] = NULL;
+			frees++;
+		} else {
+			size_t sz = next_size();
+
+			t0 = k_cycle_get_32();
+			ptrs[slot] = k_malloc(sz);
+			alloc_cycles += k_cycle_get_32() - t0;
+			allocs++;
+			if (ptrs[slot] == NULL) {
+				failures++;
+			}
+		}
+	}
+
+	for (int i = 0; i < CHURN_SLOTS; i++) {
+		k_free(ptrs[i]);
+		ptrs[i] = NULL;
+	}
+
+	printk("churn: %u ops, %u cycles/alloc, %u cycles/free, "
+	       "%u failures\n", CHURN_OPS,
+	       allocs ? (u32_t)(alloc_cycles / allocs) : 0,
+	       frees ? (u32_t)(free_cycles / frees) : 0, failures);
+}
+
+void main(void)
+{
+	printk("heap %u bytes, backend %s\n", HEAP_SIZE,
+	       IS_ENABLED(CONFIG_HEAP_MEM_POOL_TLSF) ? "tlsf" : "mem_pool");
+
+	utilization();
+	churn();
+
+	printk("fin\n");
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <misc/printk.h>
+
+/* Memory slab throughput benchmark: N worker threads allocate and
+ * free small batches of blocks from one shared slab as fast as they
+ * can, while the main thread (at a higher priority) samples the total
+ * operation count over a fixed interval.
+ */
+
+#define MAX_WORKERS 4
+#define STACK_SIZE 1024
+#define BLOCK_SIZE 32
+#define BATCH 4
+#define NUM_BLOCKS (MAX_WORKERS * BATCH * 4)
+#define WARMUP_MS 100
+#define INTERVAL_MS 1000
+
+K_MEM_SLAB_DEFINE(slab, BLOCK_SIZE, NUM_BLOCKS, 4);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_WORKERS, STACK_SIZE);
+static struct k_thread threads[MAX_WORKERS];
+static volatile u32_t counts[MAX_WORKERS];
+static volatile bool stop;
+static K_SEM_DEFINE(done, 0, MAX_WORKERS);
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	volatile u32_t *count = p1;
+	void *blocks[BATCH];
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!stop) {
+		for (int i = 0; i < BATCH; i++) {
+			(void)k_mem_slab_alloc(&slab, &blocks[i], K_FOREVER);
+		}
+		for (int i = 0; i < BATCH; i++) {
+			k_mem_slab_free(&slab, &blocks[i]);
+		}
+		*count += 2 * BATCH;
+	}
+
+	k_sem_give(&done);
+}
+
+static u32_t total_count(int n)
+{
+	u32_t sum = 0;
+
+	for (int i = 0; i < n; i++) {
+		sum += counts[i];
+	}
+
+	return sum;
+}
+
+static void run_phase(int n)
+{
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+
+	if (n > CONFIG_MP_NUM_CPUS) {
+		printk("workers %d: skipped, only %d CPUs\n", n,
+		       CONFIG_MP_NUM_CPUS);
+		return;
+	}
+
+	stop = false;
+	for (int i = 0; i < n; i++) {
+		counts[i] = 0;
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE,
+				worker, (void *)&counts[i], NULL, NULL,
+				prio, 0, 0);
+	}
+
+	k_sleep(WARMUP_MS);
+
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	struct k_mem_slab_cache_stats s0, s1;
+
+	k_mem_slab_cache_stats_get(&slab, &s0);
+#endif
+	u32_t c0 = total_count(n);
+	u32_t t0 = k_uptime_get_32();
+
+	k_sleep(INTERVAL_MS);
+
+	u32_t dt = k_uptime_get_32() - t0;
+	u32_t ops = total_count(n) - c0;
+
+	stop = true;
+	for (int i = 0; i < n; i++) {
+		k_sem_take(&done, K_FOREVER);
+	}
+
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	k_mem_slab_cache_stats_get(&slab, &s1);
+
+	u32_t hits = s1.hits - s0.hits;
+	u32_t total = hits + (s1.misses - s0.misses);
+
+	printk("workers %d: %u ops/s, hit rate %u%%\n", n,
+	       (u32_t)((u64_t)ops * 1000 / dt),
+	       total ? (u32_t)((u64_t)hits * 100 / total) : 0);
+#else
+	printk("workers %d: %u ops/s\n", n, (u32_t)((u64_t)ops * 1000 / dt));
+#endif
+}
+
+void main(void)
+{
+	printk("CPUs %d magazines %c\n", CONFIG_MP_NUM_CPUS,
+	       IS_ENABLED(CONFIG_MEM_SLAB_MAGAZINE) ? 'y' : 'n');
+
+	for (int n = 1; n <= MAX_WORKERS; n *= 2) {
+		run_phase(n);
+	}
+
+	printk("fin\n");
+}
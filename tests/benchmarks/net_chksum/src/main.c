@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <misc/printk.h>
+#include <random/rand32.h>
+#include <net/net_ip.h>
+
+#include "net_private.h"
+
+#define ITERATIONS 1000
+
+static const size_t lengths[] = { 20, 64, 576, 1500 };
+
+static u8_t buf[1500 + 1] __aligned(4);
+
+/* The checksum loop the stack used before, 16 bits at a time */
+static u16_t chksum_ref(const void *ptr, size_t len)
+{
+	const u8_t *data = ptr;
+	const u8_t *end = data + len - 1;
+	u16_t sum = 0U;
+	u16_t tmp;
+
+	while (data < end) {
+		tmp = (data[0] << 8) + data[1];
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+
+		data += 2;
+	}
+
+	if (data == end) {
+		tmp = data[0] << 8;
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+	}
+
+	sum = (sum == 0U) ? 0xffff : htons(sum);
+
+	return ~sum;
+}
+
+static u32_t measure(u16_t (*fn)(const void *data, size_t len),
+		     const u8_t *data, size_t len, u16_t *chksum)
+{
+	u32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		*chksum = fn(data, len);
+
+		/* Do not let the compiler hoist the call out of the loop */
+		compiler_barrier();
+	}
+
+	return (k_cycle_get_32() - start) / ITERATIONS;
+}
+
+void main(void)
+{
+	u32_t ref_cycles, word_cycles;
+	u16_t ref_sum, word_sum;
+
+	for (int i = 0; i < sizeof(buf); i++) {
+		buf[i] = sys_rand32_get();
+	}
+
+	printk("Internet checksum, cycles per call\n");
+
+	for (int i = 0; i < ARRAY_SIZE(lengths); i++) {
+		for (int offset = 0; offset < 2; offset++) {
+			ref_cycles = measure(chksum_ref, &buf[offset], lengths[i],
+					     &ref_sum);
+			word_cycles = measure(net_calc_chksum_buf, &buf[offset],
+					      lengths[i], &word_sum);
+
+			printk("len %4zu offset %d: reference %u, word %u%s\n",
+			       lengths[i], offset, ref_cycles, word_cycles,
+			       ref_sum == word_sum ? "" : " (mismatch)");
+		}
+	}
+
+	printk("fin\n");
+}
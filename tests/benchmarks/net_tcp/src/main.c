@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <errno.h>
+#include <misc/printk.h>
+#include <net/socket.h>
+#include <net/net_mgmt.h>
+#include <net/net_stats.h>
+
+#define SERVER_ADDR "192.0.2.1"
+#define SERVER_PORT 4242
+#define TOTAL_BYTES (64 * 1024)
+#define STACK_SIZE 2048
+
+static const size_t chunk_sizes[] = { 16, 128, 1024 };
+
+static K_THREAD_STACK_DEFINE(server_stack, STACK_SIZE);
+static struct k_thread server_thread;
+static K_SEM_DEFINE(server_ready, 0, 1);
+static K_SEM_DEFINE(server_done, 0, 1);
+
+static u8_t tx_buf[1024];
+static u8_t rx_buf[1024];
+static size_t rx_total;
+
+static void server(void *p1, void *p2, void *p3)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	int sock, conn;
+	ssize_t len;
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0 ||
+	    bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    listen(sock, 1) < 0) {
+		printk("server setup failed\n");
+		return;
+	}
+
+	k_sem_give(&server_ready);
+
+	while (true) {
+		conn = accept(sock, NULL, NULL);
+		if (conn < 0) {
+			continue;
+		}
+
+		rx_total = 0;
+		while ((len = recv(conn, rx_buf, sizeof(rx_buf), 0)) > 0) {
+			rx_total += len;
+		}
+
+		close(conn);
+		k_sem_give(&server_done);
+	}
+}
+
+static u32_t tcp_segments_sent(void)
+{
+	struct net_stats_tcp stats;
+
+	if (net_mgmt(NET_REQUEST_STATS_GET_TCP, NULL, &stats,
+		     sizeof(stats)) < 0) {
+		return 0;
+	}
+
+	return stats.sent;
+}
+
+static void run(size_t chunk)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	size_t sent = 0;
+	u32_t segments;
+	s64_t start;
+	u32_t ms;
+	int sock;
+
+	inet_pton(AF_INET, SERVER_ADDR, &addr.sin_addr);
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0 ||
+	    connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("connect failed\n");
+		return;
+	}
+
+	segments = tcp_segments_sent();
+	start = k_uptime_get();
+
+	while (sent < TOTAL_BYTES) {
+		ssize_t len = send(sock, tx_buf, chunk, 0);
+
+		if (len < 0) {
+			printk("send failed (%d)\n", errno);
+			break;
+		}
+
+		sent += len;
+	}
+
+	close(sock);
+
+	if (k_sem_take(&server_done, K_SECONDS(60)) < 0) {
+		printk("chunk %4zu: receiver did not finish\n", chunk);
+		return;
+	}
+
+	ms = (u32_t)(k_uptime_get() - start);
+
+	printk("chunk %4zu: %zu bytes, %u ms waiting, %u segments\n",
+	       chunk, rx_total, ms, tcp_segments_sent() - segments);
+}
+
+void main(void)
+{
+	printk("TCP loopback transfer, nagle %s, ack delay %d ms\n",
+	       IS_ENABLED(CONFIG_NET_TCP_NAGLE) ? "on" : "off",
+	       CONFIG_NET_TCP_ACK_DELAY);
+
+	k_thread_create(&server_thread, server_stack, STACK_SIZE, server,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(8), 0, 0);
+	k_sem_take(&server_ready, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(chunk_sizes); i++) {
+		run(chunk_sizes[i]);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <errno.h>
+#include <misc/printk.h>
+#include <net/socket.h>
+
+#define SERVER_ADDR "192.0.2.1"
+#define SERVER_PORT 4242
+#define DGRAM_COUNT 4096
+#define DGRAM_LEN 64
+#define BATCH 16
+#define IDLE_TIMEOUT 500
+#define STACK_SIZE 2048
+
+static K_THREAD_STACK_DEFINE(receiver_stack, STACK_SIZE);
+static struct k_thread receiver_thread;
+static K_SEM_DEFINE(receiver_ready, 0, 1);
+static K_SEM_DEFINE(receiver_done, 0, 1);
+
+static u8_t tx_buf[BATCH][DGRAM_LEN];
+static u8_t rx_buf[BATCH][DGRAM_LEN];
+static struct k_iovec tx_iov[BATCH];
+static struct k_iovec rx_iov[BATCH];
+static struct mmsghdr tx_msgs[BATCH];
+static struct mmsghdr rx_msgs[BATCH];
+
+static bool batched;
+static u32_t rx_count;
+static u32_t rx_calls;
+
+static void receive(int sock)
+{
+	struct pollfd pfd = {
+		.fd = sock,
+		.events = POLLIN,
+	};
+	int ret;
+
+	rx_count = 0U;
+	rx_calls = 0U;
+
+	while (poll(&pfd, 1, IDLE_TIMEOUT) > 0) {
+		if (batched) {
+			ret = recvmmsg(sock, rx_msgs, BATCH, MSG_DONTWAIT);
+		} else {
+			ret = recv(sock, rx_buf[0], DGRAM_LEN, MSG_DONTWAIT);
+			ret = ret < 0 ? ret : 1;
+		}
+
+		rx_calls++;
+
+		if (ret > 0) {
+			rx_count += ret;
+		}
+	}
+}
+
+static void receiver(void *p1, void *p2, void *p3)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	int sock;
+
+	for (int i = 0; i < BATCH; i++) {
+		rx_iov[i].iov_base = rx_buf[i];
+		rx_iov[i].iov_len = DGRAM_LEN;
+		rx_msgs[i].msg_hdr.msg_iov = &rx_iov[i];
+		rx_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0 ||
+	    bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("receiver setup failed\n");
+		return;
+	}
+
+	while (true) {
+		k_sem_give(&receiver_ready);
+		receive(sock);
+		k_sem_give(&receiver_done);
+	}
+}
+
+static void run(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	u32_t tx_calls = 0U;
+	u32_t sent = 0U;
+	s64_t start;
+	u32_t ms;
+	int sock;
+	int ret;
+
+	inet_pton(AF_INET, SERVER_ADDR, &addr.sin_addr);
+
+	for (int i = 0; i < BATCH; i++) {
+		tx_iov[i].iov_base = tx_buf[i];
+		tx_iov[i].iov_len = DGRAM_LEN;
+		tx_msgs[i].msg_hdr.msg_name = &addr;
+		tx_msgs[i].msg_hdr.msg_namelen = sizeof(addr);
+		tx_msgs[i].msg_hdr.msg_iov = &tx_iov[i];
+		tx_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0) {
+		printk("socket failed\n");
+		return;
+	}
+
+	k_sem_take(&receiver_ready, K_FOREVER);
+	start = k_uptime_get();
+
+	while (sent < DGRAM_COUNT) {
+		if (batched) {
+			ret = sendmmsg(sock, tx_msgs, BATCH, 0);
+		} else {
+			ret = sendto(sock, tx_buf[0], DGRAM_LEN, 0,
+				     (struct sockaddr *)&addr, sizeof(addr));
+			ret = ret < 0 ? ret : 1;
+		}
+
+		tx_calls++;
+
+		if (ret < 0) {
+			printk("send failed (%d)\n", errno);
+			break;
+		}
+
+		sent += ret;
+	}
+
+	close(sock);
+
+	k_sem_take(&receiver_done, K_FOREVER);
+
+	/* The receiver only gives up after an idle period */
+	ms = MAX((u32_t)(k_uptime_get() - start) - IDLE_TIMEOUT, 1U);
+
+	printk("%-8s %4u datagrams in %u ms, %u pps, %u send calls, "
+	       "%u recv calls\n", batched ? "batched:" : "single:",
+	       rx_count, ms, rx_count * 1000U / ms, tx_calls, rx_calls);
+}
+
+void main(void)
+{
+	printk("UDP loopback packet rate, %u datagrams of %u bytes\n",
+	       DGRAM_COUNT, DGRAM_LEN);
+
+	k_thread_create(&receiver_thread, receiver_stack, STACK_SIZE,
+			receiver, NULL, NULL, NULL, K_PRIO_PREEMPT(8), 0, 0);
+
+	batched = false;
+	run();
+
+	batched = true;
+	run();
+
+	printk("fin\n");
+}
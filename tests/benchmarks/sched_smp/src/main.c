@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <misc/printk.h>
+#include <kernel_structs.h>
+
+/* SMP scheduler throughput benchmark: one pair of threads per CPU
+ * ping-pong through two semaphores, and the main thread (at a higher
+ * priority, so it preempts them when its sleep expires) samples the
+ * total number of round trips over a fixed interval.  Each round trip
+ * is two context switches.
+ */
+
+#define N_PAIRS CONFIG_MP_NUM_CPUS
+#define STACK_SIZE 1024
+#define WARMUP_MS 100
+#define INTERVAL_MS 1000
+#define N_INTERVALS 5
+
+struct pair {
+	struct k_sem ping;
+	struct k_sem pong;
+	volatile u32_t count;
+};
+
+static struct pair pairs[N_PAIRS];
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, 2 * N_PAIRS, STACK_SIZE);
+static struct k_thread threads[2 * N_PAIRS];
+
+static void pinger(void *p1, void *p2, void *p3)
+{
+	struct pair *p = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_give(&p->ping);
+		k_sem_take(&p->pong, K_FOREVER);
+		p->count++;
+	}
+}
+
+static void ponger(void *p1, void *p2, void *p3)
+{
+	struct pair *p = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&p->ping, K_FOREVER);
+		k_sem_give(&p->pong);
+	}
+}
+
+static u32_t total_count(void)
+{
+	u32_t sum = 0;
+
+	for (int i = 0; i < N_PAIRS; i++) {
+		sum += pairs[i].count;
+	}
+
+	return sum;
+}
+
+static u32_t total_steals(void)
+{
+	u32_t sum = 0;
+
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		sum += _kernel.cpus[i].runq_steals;
+	}
+#endif
+
+	return sum;
+}
+
+void main(void)
+{
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+
+	printk("CPUs %d pairs %d per-CPU runq %c\n", CONFIG_MP_NUM_CPUS,
+	       N_PAIRS, IS_ENABLED(CONFIG_SCHED_PER_CPU_RUNQ) ? 'y' : 'n');
+
+	for (int i = 0; i < N_PAIRS; i++) {
+		k_sem_init(&pairs[i].ping, 0, 1);
+		k_sem_init(&pairs[i].pong, 0, 1);
+
+		k_thread_create(&threads[2 * i], stacks[2 * i], STACK_SIZE,
+				pinger, &pairs[i], NULL, NULL, prio, 0, 0);
+		k_thread_create(&threads[2 * i + 1], stacks[2 * i + 1],
+				STACK_SIZE, ponger, &pairs[i], NULL, NULL,
+				prio, 0, 0);
+	}
+
+	k_sleep(WARMUP_MS);
+
+	for (int i = 0; i < N_INTERVALS; i++) {
+		u32_t c0 = total_count();
+		u32_t s0 = total_steals();
+		u32_t t0 = k_uptime_get_32();
+
+		k_sleep(INTERVAL_MS);
+
+		u32_t dt = k_uptime_get_32() - t0;
+		u32_t switches = 2 * (total_count() - c0);
+
+		printk("interval %u ms: %u switches (%u/s), %u steals\n",
+		       dt, switches, (u32_t)((u64_t)switches * 1000 / dt),
+		       total_steals() - s0);
+	}
+
+	printk("fin\n");
+}
@@ -215,5 +215,6 @@ extern u64_t __end_tick_time;
 __syscall int k_dummy_syscall(void);
 __syscall u32_t userspace_read_timer_value(void);
 __syscall int validation_overhead_syscall(void);
+__syscall int dyn_validation_overhead_syscall(void);
 #include <syscalls/timing_info.h>
 #endif	/* CONFIG_USERSPACE */
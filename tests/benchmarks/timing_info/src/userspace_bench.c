@@ -50,6 +50,8 @@ void drop_to_user_mode(void);
 void user_thread_creation(void);
 void syscall_overhead(void);
 void validation_overhead(void);
+void dyn_validation_overhead(void);
+void syscall_batch_overhead(void);
 
 void userspace_bench(void)
 {
@@ -67,6 +69,12 @@ void userspace_bench(void)
 	syscall_overhead();
 
 	validation_overhead();
+
+	syscall_batch_overhead();
+
+#ifdef CONFIG_DYNAMIC_OBJECTS
+	dyn_validation_overhead();
+#endif
 }
 /******************************************************************************/
 
@@ -282,3 +290,132 @@ void validation_overhead(void)
 
 
 }
+
+/******************************************************************************/
+#define BATCH_OPS 8
+
+K_SEM_DEFINE(batch_sema, 0, 2 * BATCH_OPS);
+K_APP_BMEM(bench_ptn) u32_t syscall_single_start_time, syscall_single_end_time;
+K_APP_BMEM(bench_ptn) u32_t syscall_batch_start_time, syscall_batch_end_time;
+K_APP_BMEM(bench_ptn) struct k_syscall_op batch_ops[BATCH_OPS];
+
+void syscall_batch_user_thread(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < BATCH_OPS; i++) {
+		k_syscall_op_k_sem_give(&batch_ops[i], &batch_sema);
+	}
+
+	syscall_single_start_time = userspace_read_timer_value();
+	for (int i = 0; i < BATCH_OPS; i++) {
+		k_sem_give(&batch_sema);
+	}
+	syscall_single_end_time = userspace_read_timer_value();
+
+	syscall_batch_start_time = userspace_read_timer_value();
+	k_syscall_batch(batch_ops, BATCH_OPS);
+	syscall_batch_end_time = userspace_read_timer_value();
+}
+
+/* BATCH_OPS semaphore gives, made one by one then in a single batch */
+void syscall_batch_overhead(void)
+{
+	k_thread_access_grant(k_current_get(), &batch_sema);
+
+	k_thread_create(&my_thread_user, my_stack_area_0, STACK_SIZE,
+			syscall_batch_user_thread,
+			NULL, NULL, NULL,
+			-1 /*priority*/, K_INHERIT_PERMS | K_USER, 0);
+
+	u32_t single_cycles = (u32_t)
+		((SUBTRACT_CLOCK_CYCLES(syscall_single_end_time) -
+		  SUBTRACT_CLOCK_CYCLES(syscall_single_start_time)) &
+		 0xFFFFFFFFULL);
+
+	u32_t batch_cycles = (u32_t)
+		((SUBTRACT_CLOCK_CYCLES(syscall_batch_end_time) -
+		  SUBTRACT_CLOCK_CYCLES(syscall_batch_start_time)) &
+		 0xFFFFFFFFULL);
+
+	PRINT_STATS("8 semaphore gives, one syscall each",
+		    single_cycles,
+		    (u32_t) (CYCLES_TO_NS(single_cycles) & 0xFFFFFFFFULL));
+
+	PRINT_STATS("8 semaphore gives, one batched syscall",
+		    batch_cycles,
+		    (u32_t) (CYCLES_TO_NS(batch_cycles) & 0xFFFFFFFFULL));
+}
+
+/******************************************************************************/
+#ifdef CONFIG_DYNAMIC_OBJECTS
+/* Other live objects, so that the lookup does not just find the only one */
+#define DYN_OBJECTS 32
+
+K_MEM_POOL_DEFINE(dyn_obj_pool, 128, 128, DYN_OBJECTS + 1, 4);
+
+struct k_sem *dyn_sema;
+u32_t dyn_validation_overhead_obj_start_time;
+u32_t dyn_validation_overhead_obj_end_time;
+
+int _impl_dyn_validation_overhead_syscall(void)
+{
+	return 0;
+}
+
+Z_SYSCALL_HANDLER(dyn_validation_overhead_syscall)
+{
+	TIMING_INFO_PRE_READ();
+	dyn_validation_overhead_obj_start_time = TIMING_INFO_GET_TIMER_VALUE();
+
+	bool status = Z_SYSCALL_OBJ(dyn_sema, K_OBJ_SEM);
+
+	TIMING_INFO_PRE_READ();
+	dyn_validation_overhead_obj_end_time = TIMING_INFO_GET_TIMER_VALUE();
+	return status;
+}
+
+void dyn_validation_overhead_user_thread(void *p1, void *p2, void *p3)
+{
+	/* get validation numbers */
+	dyn_validation_overhead_syscall();
+}
+
+/* Same as the permission validation overhead above, for an object
+ * allocated with k_object_alloc() rather than a static one
+ */
+void dyn_validation_overhead(void)
+{
+	k_thread_resource_pool_assign(k_current_get(), &dyn_obj_pool);
+
+	for (int i = 0; i < DYN_OBJECTS; i++) {
+		if (k_object_alloc(K_OBJ_SEM) == NULL) {
+			TC_PRINT("dynamic object allocation failed\n");
+			return;
+		}
+	}
+
+	dyn_sema = k_object_alloc(K_OBJ_SEM);
+	if (dyn_sema == NULL) {
+		TC_PRINT("dynamic object allocation failed\n");
+		return;
+	}
+	k_sem_init(dyn_sema, 1, 10);
+
+	k_thread_create(&my_thread_user, my_stack_area, STACK_SIZE,
+			dyn_validation_overhead_user_thread,
+			NULL, NULL, NULL,
+			-1 /*priority*/, K_INHERIT_PERMS | K_USER, 0);
+
+	u32_t total_cycles_obj = (u32_t)
+		((SUBTRACT_CLOCK_CYCLES(dyn_validation_overhead_obj_end_time) -
+		  SUBTRACT_CLOCK_CYCLES(dyn_validation_overhead_obj_start_time)) &
+		 0xFFFFFFFFULL);
+
+	u32_t total_dyn_validation_overhead_obj_time =
+		CYCLES_TO_NS(total_cycles_obj);
+
+	PRINT_STATS("Validation overhead dynamic k object permission",
+		    total_cycles_obj,
+		    (u32_t) (total_dyn_validation_overhead_obj_time  &
+			     0xFFFFFFFFULL));
+}
+#endif
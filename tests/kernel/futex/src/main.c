@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <misc/mutex.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define ITERATIONS 1000
+
+static ZTEST_BMEM struct k_futex futex;
+static ZTEST_BMEM SYS_MUTEX_DEFINE(smutex);
+static ZTEST_BMEM volatile int counter;
+static ZTEST_BMEM volatile int woken;
+
+static K_THREAD_STACK_DEFINE(tstack, STACK_SIZE);
+static struct k_thread tdata;
+
+static void futex_wait_entry(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_futex_wait(&futex, 0, K_FOREVER), 0, NULL);
+	woken = 1;
+}
+
+/**
+ * @brief Test futex wait and wake
+ *
+ * @see k_futex_wait(), k_futex_wake()
+ */
+void test_futex_wait_wake(void)
+{
+	atomic_set(&futex.val, 0);
+	woken = 0;
+
+	/**TESTPOINT: no sleeping on a stale value */
+	zassert_equal(k_futex_wait(&futex, 1, K_FOREVER), -EAGAIN, NULL);
+
+	/**TESTPOINT: waiting times out without a wakeup */
+	zassert_equal(k_futex_wait(&futex, 0, 10), -ETIMEDOUT, NULL);
+	zassert_equal(k_futex_wake(&futex, true), 0, NULL);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, futex_wait_entry,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0),
+			K_USER | K_INHERIT_PERMS, 0);
+	k_sleep(10);
+	zassert_equal(woken, 0, NULL);
+
+	/**TESTPOINT: a wakeup reaches the waiter */
+	atomic_set(&futex.val, 1);
+	zassert_equal(k_futex_wake(&futex, false), 1, NULL);
+	k_sleep(10);
+	zassert_equal(woken, 1, NULL);
+}
+
+static void mutex_entry(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < ITERATIONS; i++) {
+		zassert_equal(sys_mutex_lock(&smutex, K_FOREVER), 0, NULL);
+		counter++;
+		if ((i % 100) == 0) {
+			/* Let the other thread find the mutex taken */
+			k_yield();
+		}
+		sys_mutex_unlock(&smutex);
+	}
+}
+
+/**
+ * @brief Test sys_mutex under contention
+ *
+ * Two threads of the same priority increment a counter under the mutex,
+ * yielding now and then while holding it so that the contended path is
+ * taken too.
+ *
+ * @see sys_mutex_lock(), sys_mutex_unlock()
+ */
+void test_sys_mutex(void)
+{
+	counter = 0;
+
+	zassert_equal(sys_mutex_lock(&smutex, K_NO_WAIT), 0, NULL);
+	zassert_true(sys_mutex_is_locked(&smutex), NULL);
+
+	/**TESTPOINT: the mutex excludes others */
+	zassert_equal(sys_mutex_lock(&smutex, K_NO_WAIT), -EBUSY, NULL);
+	sys_mutex_unlock(&smutex);
+	zassert_false(sys_mutex_is_locked(&smutex), NULL);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, mutex_entry,
+			NULL, NULL, NULL, k_thread_priority_get(k_current_get()),
+			K_USER | K_INHERIT_PERMS, 0);
+	mutex_entry(NULL, NULL, NULL);
+	k_sleep(100);
+
+	/**TESTPOINT: no increment was lost */
+	zassert_equal(counter, 2 * ITERATIONS, NULL);
+	zassert_false(sys_mutex_is_locked(&smutex), NULL);
+}
+
+void test_main(void)
+{
+	k_thread_access_grant(k_current_get(), &tdata, &tstack);
+
+	ztest_test_suite(futex_api,
+			 ztest_user_unit_test(test_futex_wait_wake),
+			 ztest_user_unit_test(test_sys_mutex));
+	ztest_run_test_suite(futex_api);
+}
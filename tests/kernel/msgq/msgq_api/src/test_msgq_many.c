@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define MANY_LEN 4
+
+K_THREAD_STACK_EXTERN(tstack);
+extern struct k_thread tdata;
+extern struct k_msgq msgq;
+static char __aligned(4) mbuffer[MSG_SIZE * MANY_LEN];
+static u32_t tx[2 * MANY_LEN];
+static u32_t rx[2 * MANY_LEN];
+
+static void tThread_get_many(void *p1, void *p2, void *p3)
+{
+	u32_t out[MANY_LEN];
+	int n;
+
+	/* drain the full queue, letting a pending sender refill it */
+	n = k_msgq_get_many((struct k_msgq *)p1, out, MANY_LEN, K_NO_WAIT);
+	zassert_equal(n, MANY_LEN, NULL);
+	for (int i = 0; i < MANY_LEN; i++) {
+		zassert_equal(out[i], tx[i], NULL);
+	}
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test sending and receiving several messages per call
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+void test_msgq_put_get_many(void)
+{
+	int n;
+
+	for (int i = 0; i < ARRAY_SIZE(tx); i++) {
+		tx[i] = MSG0 + i;
+	}
+
+	k_msgq_init(&msgq, mbuffer, MSG_SIZE, MANY_LEN);
+
+	/**TESTPOINT: put stops when the queue is full */
+	n = k_msgq_put_many(&msgq, tx, 3, K_NO_WAIT);
+	zassert_equal(n, 3, NULL);
+	n = k_msgq_put_many(&msgq, &tx[3], 3, K_NO_WAIT);
+	zassert_equal(n, 1, NULL);
+	n = k_msgq_put_many(&msgq, &tx[4], 1, K_NO_WAIT);
+	zassert_equal(n, -ENOMSG, NULL);
+
+	/**TESTPOINT: get wraps around the ring buffer */
+	n = k_msgq_get_many(&msgq, rx, 3, K_NO_WAIT);
+	zassert_equal(n, 3, NULL);
+	n = k_msgq_put_many(&msgq, &tx[4], 3, K_NO_WAIT);
+	zassert_equal(n, 3, NULL);
+	n = k_msgq_get_many(&msgq, &rx[3], ARRAY_SIZE(rx) - 3, K_NO_WAIT);
+	zassert_equal(n, 4, NULL);
+	for (int i = 0; i < 7; i++) {
+		zassert_equal(rx[i], tx[i], NULL);
+	}
+	n = k_msgq_get_many(&msgq, rx, 1, K_NO_WAIT);
+	zassert_equal(n, -ENOMSG, NULL);
+	n = k_msgq_get_many(&msgq, rx, 1, TIMEOUT);
+	zassert_equal(n, -EAGAIN, NULL);
+
+	/**TESTPOINT: a full queue blocks the sender until room is made */
+	n = k_msgq_put_many(&msgq, tx, MANY_LEN, K_NO_WAIT);
+	zassert_equal(n, MANY_LEN, NULL);
+	k_thread_create(&tdata, tstack, STACK_SIZE,
+			tThread_get_many, &msgq, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, 0);
+	n = k_msgq_put_many(&msgq, &tx[MANY_LEN], MANY_LEN, K_FOREVER);
+	zassert_equal(n, MANY_LEN, NULL);
+
+	n = k_msgq_get_many(&msgq, rx, MANY_LEN, K_NO_WAIT);
+	zassert_equal(n, MANY_LEN, NULL);
+	for (int i = 0; i < MANY_LEN; i++) {
+		zassert_equal(rx[i], tx[MANY_LEN + i], NULL);
+	}
+
+	k_thread_abort(&tdata);
+}
+
+/**
+ * @}
+ */
@@ -10,6 +10,7 @@ extern void test_mutex_reent_lock_forever(void);
 extern void test_mutex_reent_lock_no_wait(void);
 extern void test_mutex_reent_lock_timeout_fail(void);
 extern void test_mutex_reent_lock_timeout_pass(void);
+extern void test_mutex_priority_inheritance_chain(void);
 
 /*test case main entry*/
 void test_main(void)
@@ -19,7 +20,8 @@ void test_main(void)
 			 ztest_unit_test(test_mutex_reent_lock_forever),
 			 ztest_unit_test(test_mutex_reent_lock_no_wait),
 			 ztest_unit_test(test_mutex_reent_lock_timeout_fail),
-			 ztest_unit_test(test_mutex_reent_lock_timeout_pass)
+			 ztest_unit_test(test_mutex_reent_lock_timeout_pass),
+			 ztest_unit_test(test_mutex_priority_inheritance_chain)
 			 );
 	ztest_run_test_suite(mutex_api);
 }
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define ITERATIONS 5
+/* How long each owner in the chain holds its mutex */
+#define HOLD_US 1000
+/* How long the medium priority thread keeps the CPU busy */
+#define HOG_US 50000
+
+#define PRIO_LOW 10
+#define PRIO_MID 9
+#define PRIO_TOP 8
+#define PRIO_HOG 6
+#define PRIO_HIGH 5
+
+static struct k_mutex chain_mutex[3];
+static struct k_sem chain_go;
+static u32_t chain_go_time, chain_wakeup_time;
+
+static K_THREAD_STACK_ARRAY_DEFINE(chain_stack, 5, STACK_SIZE);
+static struct k_thread chain_thread[5];
+
+/* Owner at the end of the chain: holds the last mutex until told to go */
+static void chain_tail(void *p1, void *p2, void *p3)
+{
+	k_mutex_lock(&chain_mutex[2], K_FOREVER);
+	k_sem_take(&chain_go, K_FOREVER);
+	k_busy_wait(HOLD_US);
+	k_mutex_unlock(&chain_mutex[2]);
+}
+
+/* Owner in the chain: holds mutex p1 while blocked on mutex p1 + 1 */
+static void chain_link(void *p1, void *p2, void *p3)
+{
+	struct k_mutex *mutex = p1;
+
+	k_mutex_lock(mutex, K_FOREVER);
+	k_mutex_lock(mutex + 1, K_FOREVER);
+	k_busy_wait(HOLD_US);
+	k_mutex_unlock(mutex + 1);
+	k_mutex_unlock(mutex);
+}
+
+static void chain_waiter(void *p1, void *p2, void *p3)
+{
+	k_mutex_lock(&chain_mutex[0], K_FOREVER);
+	chain_wakeup_time = k_cycle_get_32();
+	k_mutex_unlock(&chain_mutex[0]);
+}
+
+static void chain_hog(void *p1, void *p2, void *p3)
+{
+	k_busy_wait(HOG_US);
+}
+
+static k_tid_t chain_spawn(int i, k_thread_entry_t entry, void *p1, int prio)
+{
+	k_tid_t tid = k_thread_create(&chain_thread[i], chain_stack[i],
+				      STACK_SIZE, entry, p1, NULL, NULL,
+				      K_PRIO_PREEMPT(prio), 0, 0);
+
+	/* let it run until it blocks */
+	k_sleep(10);
+	return tid;
+}
+
+/**
+ * @brief Test transitive priority inheritance through a 3-deep chain
+ *
+ * A high priority thread waits on a mutex whose owner waits on a second
+ * mutex, whose owner waits on a third.  All three owners must run at
+ * the waiter's priority, so that a medium priority thread that is busy
+ * for a long time does not delay the waiter's wakeup.  Reports the
+ * worst wakeup latency seen.
+ *
+ * @ingroup kernel_mutex_tests
+ *
+ * @see k_mutex_lock(), k_mutex_unlock()
+ */
+void test_mutex_priority_inheritance_chain(void)
+{
+	u32_t latency, worst = 0U;
+	k_tid_t tid[5];
+
+	if (CONFIG_PRIORITY_INHERITANCE_DEPTH < 3) {
+		ztest_test_skip();
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(chain_mutex); i++) {
+		k_mutex_init(&chain_mutex[i]);
+	}
+
+	for (int n = 0; n < ITERATIONS; n++) {
+		k_sem_init(&chain_go, 0, 1);
+		chain_wakeup_time = 0U;
+
+		tid[0] = chain_spawn(0, chain_tail, NULL, PRIO_LOW);
+		tid[1] = chain_spawn(1, chain_link, &chain_mutex[1], PRIO_MID);
+		tid[2] = chain_spawn(2, chain_link, &chain_mutex[0], PRIO_TOP);
+
+		/**TESTPOINT: the boost reaches the end of the chain */
+		zassert_equal(k_thread_priority_get(tid[0]), PRIO_TOP, NULL);
+
+		tid[3] = chain_spawn(3, chain_waiter, NULL, PRIO_HIGH);
+		for (int i = 0; i < 3; i++) {
+			zassert_equal(k_thread_priority_get(tid[i]), PRIO_HIGH,
+				      "owner %d not boosted", i);
+		}
+
+		tid[4] = k_thread_create(&chain_thread[4], chain_stack[4],
+					 STACK_SIZE, chain_hog, NULL, NULL,
+					 NULL, K_PRIO_PREEMPT(PRIO_HOG), 0, 0);
+		chain_go_time = k_cycle_get_32();
+		k_sem_give(&chain_go);
+
+		k_sleep(2 * HOG_US / USEC_PER_MSEC);
+
+		zassert_not_equal(chain_wakeup_time, 0, "waiter never woke");
+		latency = (u32_t)(SYS_CLOCK_HW_CYCLES_TO_NS64(chain_wakeup_time -
+							      chain_go_time) /
+				  NSEC_PER_USEC);
+		worst = MAX(worst, latency);
+
+		/**TESTPOINT: owners drop back to their own priority */
+		zassert_equal(k_thread_priority_get(tid[0]), PRIO_LOW, NULL);
+
+		for (int i = 0; i < ARRAY_SIZE(tid); i++) {
+			k_thread_abort(tid[i]);
+		}
+	}
+
+	TC_PRINT("worst wakeup through the chain: %u us\n", worst);
+
+	/**TESTPOINT: the medium priority thread did not get in the way */
+	zassert_true(worst < HOG_US / 2, NULL);
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+
+#define STACK_SIZE	1024
+#define PIPE_LEN	16
+
+K_PIPE_DEFINE(claim_pipe, PIPE_LEN, 4);
+K_PIPE_DEFINE(iov_pipe, PIPE_LEN, 4);
+
+static K_THREAD_STACK_DEFINE(claim_stack, STACK_SIZE);
+static struct k_thread claim_thread;
+static K_SEM_DEFINE(claim_sema, 0, 1);
+
+static const unsigned char pattern[] = "abcd1234$%^&PIPE";
+static unsigned char rx_data[PIPE_LEN];
+static size_t rx_bytes;
+
+/**
+ * @brief Test claimed regions of the pipe's buffer
+ * @see k_pipe_put_claim(), k_pipe_put_commit(), k_pipe_get_claim(),
+ * k_pipe_get_commit()
+ */
+void test_pipe_claim_commit(void)
+{
+	u8_t *region;
+	size_t len;
+
+	/**TESTPOINT: all the buffer can be claimed at first */
+	len = k_pipe_put_claim(&claim_pipe, &region, PIPE_LEN + 1);
+	zassert_equal(len, PIPE_LEN, NULL);
+	memcpy(region, pattern, 12);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 12), 0, NULL);
+
+	/**TESTPOINT: data cannot be claimed past its end */
+	len = k_pipe_get_claim(&claim_pipe, &region, PIPE_LEN);
+	zassert_equal(len, 12, NULL);
+	zassert_true(memcmp(region, pattern, 12) == 0, NULL);
+	zassert_equal(k_pipe_get_commit(&claim_pipe, 13), -EINVAL, NULL);
+	zassert_equal(k_pipe_get_commit(&claim_pipe, 8), 0, NULL);
+
+	/**TESTPOINT: claims stop at the end of the buffer */
+	len = k_pipe_put_claim(&claim_pipe, &region, PIPE_LEN);
+	zassert_equal(len, PIPE_LEN - 12, NULL);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, len + 1), -EINVAL, NULL);
+	memcpy(region, &pattern[12], len);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, len), 0, NULL);
+
+	len = k_pipe_put_claim(&claim_pipe, &region, PIPE_LEN);
+	zassert_equal(len, 8, NULL);
+	memcpy(region, pattern, len);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, len), 0, NULL);
+
+	/**TESTPOINT: a full pipe has nothing to claim */
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &region, PIPE_LEN), 0,
+		      NULL);
+
+	/**TESTPOINT: claimed data is what a read returns */
+	zassert_equal(k_pipe_get(&claim_pipe, rx_data, PIPE_LEN, &rx_bytes,
+				 PIPE_LEN, K_NO_WAIT), 0, NULL);
+	zassert_true(memcmp(rx_data, &pattern[8], 8) == 0, NULL);
+	zassert_true(memcmp(&rx_data[8], pattern, 8) == 0, NULL);
+}
+
+static void tpipe_reader(void *p1, void *p2, void *p3)
+{
+	(void)k_pipe_get(&claim_pipe, rx_data, PIPE_LEN, &rx_bytes, PIPE_LEN,
+			 K_FOREVER);
+	k_sem_give(&claim_sema);
+}
+
+/**
+ * @brief Test committing data to a pending reader
+ * @see k_pipe_put_claim(), k_pipe_put_commit()
+ */
+void test_pipe_claim_reader_wait(void)
+{
+	u8_t *region;
+	size_t len;
+
+	memset(rx_data, 0, sizeof(rx_data));
+	k_tid_t tid = k_thread_create(&claim_thread, claim_stack, STACK_SIZE,
+				      tpipe_reader, NULL, NULL, NULL,
+				      K_PRIO_PREEMPT(0), 0, 0);
+
+	k_sleep(10);
+
+	for (int i = 0; i < PIPE_LEN; i += len) {
+		len = k_pipe_put_claim(&claim_pipe, &region, PIPE_LEN - i);
+		zassert_true(len > 0, NULL);
+		memcpy(region, &pattern[i], len);
+		zassert_equal(k_pipe_put_commit(&claim_pipe, len), 0, NULL);
+	}
+
+	/**TESTPOINT: the reader got the committed data */
+	zassert_equal(k_sem_take(&claim_sema, 1000), 0, NULL);
+	zassert_equal(rx_bytes, PIPE_LEN, NULL);
+	zassert_true(memcmp(rx_data, pattern, PIPE_LEN) == 0, NULL);
+	k_thread_abort(tid);
+}
+
+/**
+ * @brief Test scatter-gather pipe transfers
+ * @see k_pipe_put_iov(), k_pipe_get_iov()
+ */
+void test_pipe_iov(void)
+{
+	unsigned char buf[PIPE_LEN];
+	struct k_iovec tx_iov[] = {
+		{ (void *)pattern, 3 },
+		{ (void *)&pattern[3], 0 },
+		{ (void *)&pattern[3], PIPE_LEN - 3 },
+	};
+	struct k_iovec rx_iov[] = {
+		{ buf, 10 },
+		{ &buf[10], PIPE_LEN - 10 },
+	};
+	size_t bytes;
+
+	/**TESTPOINT: buffers are written and read in order */
+	zassert_equal(k_pipe_put_iov(&iov_pipe, tx_iov, ARRAY_SIZE(tx_iov),
+				     &bytes, PIPE_LEN, K_NO_WAIT), 0, NULL);
+	zassert_equal(bytes, PIPE_LEN, NULL);
+
+	/**TESTPOINT: a full pipe fails a non-waiting write */
+	zassert_equal(k_pipe_put_iov(&iov_pipe, tx_iov, ARRAY_SIZE(tx_iov),
+				     &bytes, 1, K_NO_WAIT), -EIO, NULL);
+	zassert_equal(bytes, 0, NULL);
+
+	zassert_equal(k_pipe_get_iov(&iov_pipe, rx_iov, ARRAY_SIZE(rx_iov),
+				     &bytes, PIPE_LEN, K_NO_WAIT), 0, NULL);
+	zassert_equal(bytes, PIPE_LEN, NULL);
+	zassert_true(memcmp(buf, pattern, PIPE_LEN) == 0, NULL);
+
+	/**TESTPOINT: an empty pipe times out a waiting read */
+	zassert_equal(k_pipe_get_iov(&iov_pipe, rx_iov, ARRAY_SIZE(rx_iov),
+				     &bytes, 1, 10), -EAGAIN, NULL);
+	zassert_equal(bytes, 0, NULL);
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+
+#define NUM_SEMS 64
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+static struct k_sem set_sems[NUM_SEMS];
+static struct k_poll_event set_events[NUM_SEMS];
+static struct k_poll_event *ready[NUM_SEMS];
+static struct k_poll_set level_set;
+static struct k_poll_set edge_set;
+
+static K_THREAD_STACK_DEFINE(set_stack, STACK_SIZE);
+static struct k_thread set_thread;
+
+static void init_set(struct k_poll_set *set, u32_t flags)
+{
+	k_poll_set_init(set, flags);
+
+	for (int i = 0; i < NUM_SEMS; i++) {
+		k_sem_init(&set_sems[i], 0, 2);
+		k_poll_event_init(&set_events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &set_sems[i]);
+		k_poll_set_add(set, &set_events[i]);
+	}
+}
+
+static void remove_all(struct k_poll_set *set)
+{
+	for (int i = 0; i < NUM_SEMS; i++) {
+		k_poll_set_remove(set, &set_events[i]);
+	}
+}
+
+static void give_sem(void *p1, void *p2, void *p3)
+{
+	k_sleep(10);
+	k_sem_give(p1);
+}
+
+/**
+ * @brief Test level-triggered poll sets
+ *
+ * @see k_poll_set_init(), k_poll_set_add(), k_poll_set_wait()
+ */
+void test_poll_set_level(void)
+{
+	init_set(&level_set, 0);
+
+	/**TESTPOINT: nothing ready */
+	zassert_equal(k_poll_set_wait(&level_set, ready, NUM_SEMS, K_NO_WAIT),
+		      -EAGAIN, NULL);
+	zassert_equal(k_poll_set_wait(&level_set, ready, NUM_SEMS, 10),
+		      -EAGAIN, NULL);
+
+	/**TESTPOINT: only the ready events are returned */
+	k_sem_give(&set_sems[3]);
+	k_sem_give(&set_sems[42]);
+	zassert_equal(k_poll_set_wait(&level_set, ready, NUM_SEMS, K_NO_WAIT),
+		      2, NULL);
+	zassert_equal_ptr(ready[0], &set_events[3], NULL);
+	zassert_equal_ptr(ready[1], &set_events[42], NULL);
+	zassert_equal(ready[0]->state, K_POLL_STATE_SEM_AVAILABLE, NULL);
+
+	/**TESTPOINT: events are reported until consumed */
+	zassert_equal(k_sem_take(&set_sems[3], K_NO_WAIT), 0, NULL);
+	zassert_equal(k_poll_set_wait(&level_set, ready, NUM_SEMS, K_NO_WAIT),
+		      1, NULL);
+	zassert_equal_ptr(ready[0], &set_events[42], NULL);
+	zassert_equal(set_events[3].state, K_POLL_STATE_NOT_READY, NULL);
+	zassert_equal(k_sem_take(&set_sems[42], K_NO_WAIT), 0, NULL);
+	zassert_equal(k_poll_set_wait(&level_set, ready, NUM_SEMS, K_NO_WAIT),
+		      -EAGAIN, NULL);
+
+	/**TESTPOINT: events of consumed objects are notified again */
+	k_tid_t tid = k_thread_create(&set_thread, set_stack, STACK_SIZE,
+				      give_sem, &set_sems[3], NULL, NULL,
+				      K_PRIO_PREEMPT(0), 0, 0);
+
+	zassert_equal(k_poll_set_wait(&level_set, ready, 1, K_FOREVER), 1,
+		      NULL);
+	zassert_equal_ptr(ready[0], &set_events[3], NULL);
+	k_thread_abort(tid);
+
+	/**TESTPOINT: removed events are not reported */
+	remove_all(&level_set);
+	zassert_equal(k_poll_set_wait(&level_set, ready, NUM_SEMS, K_NO_WAIT),
+		      -EAGAIN, NULL);
+	k_sem_give(&set_sems[5]);
+	zassert_equal(k_poll_set_wait(&level_set, ready, NUM_SEMS, K_NO_WAIT),
+		      -EAGAIN, NULL);
+}
+
+/**
+ * @brief Test edge-triggered poll sets
+ *
+ * @see k_poll_set_init(), k_poll_set_add(), k_poll_set_wait()
+ */
+void test_poll_set_edge(void)
+{
+	init_set(&edge_set, K_POLL_SET_EDGE_TRIGGERED);
+
+	/**TESTPOINT: events are reported once per notification */
+	k_sem_give(&set_sems[7]);
+	zassert_equal(k_poll_set_wait(&edge_set, ready, NUM_SEMS, K_NO_WAIT),
+		      1, NULL);
+	zassert_equal_ptr(ready[0], &set_events[7], NULL);
+	zassert_equal(k_poll_set_wait(&edge_set, ready, NUM_SEMS, K_NO_WAIT),
+		      -EAGAIN, NULL);
+
+	/**TESTPOINT: the event is rearmed once reported */
+	k_sem_give(&set_sems[7]);
+	zassert_equal(k_poll_set_wait(&edge_set, ready, NUM_SEMS, K_NO_WAIT),
+		      1, NULL);
+	zassert_equal_ptr(ready[0], &set_events[7], NULL);
+
+	remove_all(&edge_set);
+}
@@ -14,6 +14,7 @@ extern void test_queue_thread2thread(void);
 extern void test_queue_thread2isr(void);
 extern void test_queue_isr2thread(void);
 extern void test_queue_get_2threads(void);
+extern void test_queue_get_many(void);
 extern void test_queue_get_fail(void);
 extern void test_queue_loop(void);
 #ifdef CONFIG_USERSPACE
@@ -275,3 +275,59 @@ void test_queue_alloc(void)
 
 	tqueue_alloc(&queue);
 }
+
+static void tThread_append_list(void *p1, void *p2, void *p3)
+{
+	static qdata_t *head = &data_l[0], *tail = &data_l[LIST_LEN - 1];
+
+	k_sleep(10);
+	head->snode.next = (sys_snode_t *)tail;
+	tail->snode.next = NULL;
+	k_queue_append_list((struct k_queue *)p1, head, tail);
+}
+
+/**
+ * @brief Verify k_queue_get_many()
+ * @ingroup kernel_queue_tests
+ * @see k_queue_get_many(), k_queue_append(), k_queue_append_list()
+ */
+void test_queue_get_many(void)
+{
+	void *rx_data[2 * LIST_LEN + 1];
+	int n;
+
+	k_queue_init(&queue);
+
+	for (int i = 0; i < LIST_LEN; i++) {
+		k_queue_append(&queue, (void *)&data[i]);
+		k_queue_append(&queue, (void *)&data_p[i]);
+	}
+
+	/**TESTPOINT: get fewer items than queued */
+	n = k_queue_get_many(&queue, rx_data, 1, K_NO_WAIT);
+	zassert_equal(n, 1, NULL);
+	zassert_equal(rx_data[0], (void *)&data[0], NULL);
+
+	/**TESTPOINT: get all remaining items */
+	n = k_queue_get_many(&queue, rx_data, ARRAY_SIZE(rx_data), K_NO_WAIT);
+	zassert_equal(n, 2 * LIST_LEN - 1, NULL);
+	zassert_equal(rx_data[0], (void *)&data_p[0], NULL);
+	zassert_equal(rx_data[n - 1], (void *)&data_p[LIST_LEN - 1], NULL);
+
+	/**TESTPOINT: empty queue without waiting */
+	n = k_queue_get_many(&queue, rx_data, ARRAY_SIZE(rx_data), K_NO_WAIT);
+	zassert_equal(n, 0, NULL);
+
+	/**TESTPOINT: wait for the first item, take the rest */
+	k_tid_t tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+				      tThread_append_list, &queue, NULL, NULL,
+				      K_PRIO_PREEMPT(0), 0, 0);
+
+	n = k_queue_get_many(&queue, rx_data, ARRAY_SIZE(rx_data), K_FOREVER);
+	zassert_equal(n, LIST_LEN, NULL);
+	for (int i = 0; i < LIST_LEN; i++) {
+		zassert_equal(rx_data[i], (void *)&data_l[i], NULL);
+	}
+
+	k_thread_abort(tid);
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define NUM_THREADS 3
+
+K_RWLOCK_DEFINE(krwlock);
+
+static K_THREAD_STACK_ARRAY_DEFINE(tstack, NUM_THREADS, STACK_SIZE);
+static struct k_thread tdata[NUM_THREADS];
+static ZTEST_BMEM volatile int result[NUM_THREADS];
+
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	int i = POINTER_TO_INT(p2);
+
+	result[i] = k_rwlock_read_lock((struct k_rwlock *)p1,
+				       POINTER_TO_INT(p3));
+	if (result[i] == 0) {
+		k_sleep(100);
+		k_rwlock_read_unlock((struct k_rwlock *)p1);
+	}
+}
+
+static void writer_entry(void *p1, void *p2, void *p3)
+{
+	int i = POINTER_TO_INT(p2);
+
+	result[i] = k_rwlock_write_lock((struct k_rwlock *)p1,
+					POINTER_TO_INT(p3));
+	if (result[i] == 0) {
+		k_sleep(100);
+		k_rwlock_write_unlock((struct k_rwlock *)p1);
+	}
+}
+
+static k_tid_t spawn(int i, k_thread_entry_t entry, struct k_rwlock *rwlock,
+		     s32_t timeout)
+{
+	result[i] = 1;
+	return k_thread_create(&tdata[i], tstack[i], STACK_SIZE, entry,
+			       rwlock, INT_TO_POINTER(i),
+			       INT_TO_POINTER(timeout),
+			       K_PRIO_PREEMPT(0), K_USER | K_INHERIT_PERMS, 0);
+}
+
+/**
+ * @brief Test that readers share the lock and writers exclude everyone
+ *
+ * @see k_rwlock_read_lock(), k_rwlock_write_lock()
+ */
+void test_rwlock_exclusion(void)
+{
+	struct k_rwlock *rwlock = &krwlock;
+
+	/**TESTPOINT: readers share the lock */
+	zassert_equal(k_rwlock_read_lock(rwlock, K_NO_WAIT), 0, NULL);
+	spawn(0, reader_entry, rwlock, K_NO_WAIT);
+	k_sleep(10);
+	zassert_equal(result[0], 0, "second reader was kept out");
+
+	/**TESTPOINT: a writer waits for the readers */
+	zassert_equal(k_rwlock_write_lock(rwlock, K_NO_WAIT), -EBUSY, NULL);
+	k_rwlock_read_unlock(rwlock);
+	zassert_equal(k_rwlock_write_lock(rwlock, K_FOREVER), 0, NULL);
+	zassert_equal(rwlock->readers, 0, NULL);
+
+	/**TESTPOINT: readers and writers wait for the writer */
+	spawn(1, reader_entry, rwlock, 50);
+	spawn(2, writer_entry, rwlock, K_NO_WAIT);
+	k_sleep(100);
+	zassert_equal(result[1], -EAGAIN, "reader got in with a writer");
+	zassert_equal(result[2], -EBUSY, "writer got in with a writer");
+
+	k_rwlock_write_unlock(rwlock);
+}
+
+/**
+ * @brief Test that a waiting writer is not starved by new readers
+ *
+ * @see k_rwlock_read_lock(), k_rwlock_write_unlock()
+ */
+void test_rwlock_writer_preference(void)
+{
+	struct k_rwlock *rwlock = &krwlock;
+
+	k_rwlock_init(rwlock);
+	zassert_equal(k_rwlock_read_lock(rwlock, K_NO_WAIT), 0, NULL);
+
+	/* A writer queues up behind our read lock... */
+	spawn(0, writer_entry, rwlock, K_FOREVER);
+	k_sleep(10);
+	zassert_equal(result[0], 1, NULL);
+
+	/**TESTPOINT: ...so later readers queue up behind the writer */
+	spawn(1, reader_entry, rwlock, K_FOREVER);
+	spawn(2, reader_entry, rwlock, K_FOREVER);
+	k_sleep(10);
+	zassert_equal(result[1], 1, NULL);
+	zassert_equal(result[2], 1, NULL);
+
+	/**TESTPOINT: the writer goes first, then both readers together */
+	k_rwlock_read_unlock(rwlock);
+	k_sleep(10);
+	zassert_equal(result[0], 0, NULL);
+	zassert_equal_ptr(rwlock->writer, &tdata[0], NULL);
+	zassert_equal(result[1], 1, NULL);
+
+	k_sleep(100);
+	zassert_equal(result[1], 0, NULL);
+	zassert_equal(result[2], 0, NULL);
+	zassert_equal(rwlock->readers, 2, NULL);
+
+	k_sleep(200);
+	zassert_equal(rwlock->readers, 0, NULL);
+	zassert_is_null(rwlock->writer, NULL);
+}
+
+void test_main(void)
+{
+	k_thread_access_grant(k_current_get(), &krwlock);
+
+	ztest_test_suite(rwlock_api,
+			 ztest_unit_test(test_rwlock_exclusion),
+			 ztest_unit_test(test_rwlock_writer_preference));
+	ztest_run_test_suite(rwlock_api);
+}
@@ -484,6 +484,53 @@ void test_timer_user_data(void)
 	}
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+static u32_t slack_expiry[2];
+
+static void slack_timer_handler(struct k_timer *timer)
+{
+	slack_expiry[timer == &timer1] = k_cycle_get_32();
+}
+
+/**
+ * @brief Test coalescing of timer expiries within their slack
+ *
+ * Starts a timer with a generous slack that expires shortly before
+ * another timer without slack, and checks that both are served by the
+ * same wakeup, at the later expiry.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_slack_set(), k_timeout_wakeups_avoided_get()
+ */
+void test_timer_slack(void)
+{
+	u32_t avoided = k_timeout_wakeups_avoided_get();
+
+	k_timer_init(&timer0, slack_timer_handler, NULL);
+	k_timer_init(&timer1, slack_timer_handler, NULL);
+	k_timer_slack_set(&timer0, DURATION);
+
+	k_timer_start(&timer0, PERIOD, 0);
+	k_timer_start(&timer1, PERIOD + PERIOD / 2, 0);
+	k_sleep(2 * PERIOD);
+
+	/** TESTPOINT: the early timer waited for the later one, so both
+	 * fired back to back rather than PERIOD / 2 apart
+	 */
+	zassert_true(SYS_CLOCK_HW_CYCLES_TO_NS64(slack_expiry[1] -
+						 slack_expiry[0]) <
+		     (u64_t)PERIOD / 5 * 1000000, NULL);
+	zassert_true(k_timeout_wakeups_avoided_get() > avoided, NULL);
+
+	k_timer_slack_set(&timer0, 0);
+}
+#else
+void test_timer_slack(void)
+{
+	ztest_test_skip();
+}
+#endif
 
 void test_main(void)
 {
@@ -496,6 +543,7 @@ void test_main(void)
 			 ztest_unit_test(test_timer_status_get_anytime),
 			 ztest_unit_test(test_timer_status_sync),
 			 ztest_unit_test(test_timer_k_define),
-			 ztest_unit_test(test_timer_user_data));
+			 ztest_unit_test(test_timer_user_data),
+			 ztest_unit_test(test_timer_slack));
 	ztest_run_test_suite(timer_api);
 }
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <misc/async.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define RUNTIME_PRIO K_PRIO_PREEMPT(5)
+#define NUM_TASKS 100
+#define TIMEOUT_MS 50
+
+SYS_ASYNC_RUNTIME_DEFINE(rt, NUM_TASKS, STACK_SIZE);
+
+static K_SEM_DEFINE(tokens, 0, NUM_TASKS);
+static K_SEM_DEFINE(never, 0, 1);
+static K_SEM_DEFINE(done, 0, NUM_TASKS);
+static K_FIFO_DEFINE(fifo);
+
+struct counter_task {
+	struct sys_async task;
+	int taken;
+};
+
+static struct counter_task counters[NUM_TASKS];
+
+static int counter_fn(struct sys_async *task)
+{
+	struct counter_task *t = CONTAINER_OF(task, struct counter_task, task);
+
+	SYS_ASYNC_BEGIN(task);
+
+	SYS_ASYNC_SEM_TAKE(task, &tokens, K_FOREVER);
+	t->taken++;
+	k_sem_give(&done);
+
+	SYS_ASYNC_END(task);
+}
+
+/**
+ * @brief Many tasks wait on a semaphore from a single thread and stack
+ *
+ * @see sys_async_spawn(), SYS_ASYNC_SEM_TAKE()
+ */
+static void test_async_many_tasks(void)
+{
+	for (int i = 0; i < NUM_TASKS; i++) {
+		zassert_equal(sys_async_spawn(&rt, &counters[i].task,
+					      counter_fn), 0, NULL);
+	}
+
+	/**TESTPOINT: a running task cannot be spawned again */
+	zassert_equal(sys_async_spawn(&rt, &counters[0].task, counter_fn),
+		      -EBUSY, NULL);
+
+	/* Let all of them suspend */
+	k_sleep(10);
+	zassert_equal(k_sem_count_get(&done), 0, NULL);
+
+	for (int i = 0; i < NUM_TASKS; i++) {
+		k_sem_give(&tokens);
+	}
+
+	for (int i = 0; i < NUM_TASKS; i++) {
+		zassert_equal(k_sem_take(&done, 1000), 0, NULL);
+	}
+
+	/**TESTPOINT: each task ran exactly once */
+	for (int i = 0; i < NUM_TASKS; i++) {
+		zassert_equal(counters[i].taken, 1, NULL);
+	}
+
+	/**TESTPOINT: a finished task can be spawned again */
+	k_sleep(10);
+	zassert_equal(sys_async_spawn(&rt, &counters[0].task, counter_fn), 0,
+		      NULL);
+	k_sem_give(&tokens);
+	zassert_equal(k_sem_take(&done, 1000), 0, NULL);
+	zassert_equal(counters[0].taken, 2, NULL);
+}
+
+struct timed_task {
+	struct sys_async task;
+	int take_result;
+	s64_t start;
+	s64_t slept;
+	int items;
+	void *item;
+};
+
+static struct timed_task timed;
+
+static int timed_fn(struct sys_async *task)
+{
+	struct timed_task *t = CONTAINER_OF(task, struct timed_task, task);
+
+	SYS_ASYNC_BEGIN(task);
+
+	SYS_ASYNC_SEM_TAKE(task, &never, TIMEOUT_MS);
+	t->take_result = task->result;
+
+	t->start = k_uptime_get();
+	SYS_ASYNC_SLEEP(task, TIMEOUT_MS);
+	t->slept = k_uptime_get() - t->start;
+
+	while (true) {
+		SYS_ASYNC_FIFO_GET(task, &fifo, TIMEOUT_MS, t->item);
+		if (t->item == NULL) {
+			break;
+		}
+		t->items++;
+	}
+
+	k_sem_give(&done);
+
+	SYS_ASYNC_END(task);
+}
+
+/**
+ * @brief Waits time out, and tasks can sleep and get FIFO items
+ *
+ * @see SYS_ASYNC_SEM_TAKE(), SYS_ASYNC_SLEEP(), SYS_ASYNC_FIFO_GET()
+ */
+static void test_async_timeouts(void)
+{
+	static void *items[3][2];
+
+	zassert_equal(sys_async_spawn(&rt, &timed.task, timed_fn), 0, NULL);
+
+	for (int i = 0; i < ARRAY_SIZE(items); i++) {
+		k_fifo_put(&fifo, items[i]);
+	}
+
+	zassert_equal(k_sem_take(&done, 4 * TIMEOUT_MS), 0, NULL);
+
+	zassert_equal(timed.take_result, -EAGAIN, NULL);
+	zassert_true(timed.slept >= TIMEOUT_MS, NULL);
+	zassert_equal(timed.items, ARRAY_SIZE(items), NULL);
+	zassert_equal(timed.task.result, -EAGAIN, NULL);
+}
+
+struct yield_task {
+	struct sys_async task;
+	int id;
+	int i;
+};
+
+static struct yield_task yielders[2];
+static int trace[6];
+static int trace_len;
+
+static int yield_fn(struct sys_async *task)
+{
+	struct yield_task *t = CONTAINER_OF(task, struct yield_task, task);
+
+	SYS_ASYNC_BEGIN(task);
+
+	for (t->i = 0; t->i < 3; t->i++) {
+		trace[trace_len++] = t->id;
+		SYS_ASYNC_YIELD(task);
+	}
+
+	k_sem_give(&done);
+
+	SYS_ASYNC_END(task);
+}
+
+/**
+ * @brief Yielding tasks take turns
+ *
+ * @see SYS_ASYNC_YIELD()
+ */
+static void test_async_yield(void)
+{
+	static const int expected[] = { 0, 1, 0, 1, 0, 1 };
+
+	for (int i = 0; i < ARRAY_SIZE(yielders); i++) {
+		yielders[i].id = i;
+		zassert_equal(sys_async_spawn(&rt, &yielders[i].task,
+					      yield_fn), 0, NULL);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(yielders); i++) {
+		zassert_equal(k_sem_take(&done, 1000), 0, NULL);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(expected); i++) {
+		zassert_equal(trace[i], expected[i], "wrong turn at %d", i);
+	}
+}
+
+void test_main(void)
+{
+	SYS_ASYNC_RUNTIME_START(rt, RUNTIME_PRIO);
+
+	ztest_test_suite(async,
+			 ztest_unit_test(test_async_many_tasks),
+			 ztest_unit_test(test_async_timeouts),
+			 ztest_unit_test(test_async_yield));
+	ztest_run_test_suite(async);
+}
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <misc/executor.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define WORKER_PRIO K_PRIO_PREEMPT(5)
+#define NUM_TASKS 8
+#define NUM_CHILDREN 4
+
+SYS_EXECUTOR_DEFINE(pool, 2, STACK_SIZE);
+SYS_EXECUTOR_DEFINE(single, 1, STACK_SIZE);
+
+struct test_task {
+	struct sys_task task;
+	int arg;
+	k_tid_t ran_on;
+};
+
+static struct test_task tasks[NUM_TASKS];
+static struct test_task blocker;
+static K_SEM_DEFINE(unblock, 0, 1);
+
+static int order[NUM_TASKS];
+static atomic_t order_idx;
+
+static int square(struct sys_task *task)
+{
+	struct test_task *t = CONTAINER_OF(task, struct test_task, task);
+
+	t->ran_on = k_current_get();
+	return t->arg * t->arg;
+}
+
+static int record(struct sys_task *task)
+{
+	struct test_task *t = CONTAINER_OF(task, struct test_task, task);
+
+	order[atomic_inc(&order_idx)] = t->arg;
+	return 0;
+}
+
+static int block(struct sys_task *task)
+{
+	return k_sem_take(&unblock, K_FOREVER);
+}
+
+/**
+ * @brief Wait for the results of several tasks with k_poll()
+ *
+ * @see sys_executor_submit(), sys_future_poll_event()
+ */
+static void test_executor_fan_out(void)
+{
+	struct k_poll_event events[NUM_TASKS];
+	int done = 0;
+	int result;
+
+	for (int i = 0; i < NUM_TASKS; i++) {
+		sys_task_init(&tasks[i].task, square);
+		tasks[i].arg = i;
+		zassert_equal(sys_executor_submit(&pool, &tasks[i].task, 0), 0,
+			      NULL);
+		sys_future_poll_event(&events[i], &tasks[i].task.future);
+	}
+
+	while (done < NUM_TASKS) {
+		zassert_equal(k_poll(events, NUM_TASKS, 1000), 0, NULL);
+
+		for (int i = 0; i < NUM_TASKS; i++) {
+			if (events[i].state == K_POLL_STATE_NOT_READY) {
+				continue;
+			}
+
+			zassert_true(sys_future_is_done(&tasks[i].task.future,
+							&result), NULL);
+			zassert_equal(result, i * i, NULL);
+			events[i].state = K_POLL_STATE_NOT_READY;
+			events[i].type = K_POLL_TYPE_IGNORE;
+			done++;
+		}
+	}
+}
+
+static int parent(struct sys_task *task)
+{
+	struct test_task *t = CONTAINER_OF(task, struct test_task, task);
+	int sum = 0;
+	int result;
+
+	t->ran_on = k_current_get();
+
+	for (int i = 0; i < NUM_CHILDREN; i++) {
+		sys_task_init(&tasks[i].task, square);
+		tasks[i].arg = i + 1;
+		tasks[i].ran_on = NULL;
+		sys_executor_submit(&pool, &tasks[i].task, 0);
+	}
+
+	/* This worker is blocked from now on: its children can only run
+	 * if the other worker steals them
+	 */
+	for (int i = 0; i < NUM_CHILDREN; i++) {
+		if (sys_future_wait(&tasks[i].task.future, &result,
+				    1000) != 0) {
+			return -1;
+		}
+		sum += result;
+	}
+
+	return sum;
+}
+
+/**
+ * @brief Tasks submitted by a blocked task are stolen by another worker
+ *
+ * @see sys_executor_submit(), sys_future_wait()
+ */
+static void test_executor_steal(void)
+{
+	struct test_task root;
+	int result;
+
+	sys_task_init(&root.task, parent);
+	zassert_equal(sys_executor_submit(&pool, &root.task, 0), 0, NULL);
+	zassert_equal(sys_future_wait(&root.task.future, &result, 2000), 0,
+		      NULL);
+	zassert_equal(result, 1 + 4 + 9 + 16, NULL);
+
+	for (int i = 0; i < NUM_CHILDREN; i++) {
+		zassert_not_null(tasks[i].ran_on, NULL);
+		zassert_not_equal(tasks[i].ran_on, root.ran_on, NULL);
+	}
+}
+
+/**
+ * @brief Higher priority tasks run first, in submission order
+ *
+ * @see sys_executor_submit()
+ */
+static void test_executor_priority(void)
+{
+	static const int prio[NUM_TASKS] = { 3, 1, 3, 0, 2, 0, 1, 3 };
+	static const int expected[NUM_TASKS] = { 3, 5, 1, 6, 4, 0, 2, 7 };
+	int result;
+
+	/* Keep the only worker busy while the tasks are queued */
+	sys_task_init(&blocker.task, block);
+	zassert_equal(sys_executor_submit(&single, &blocker.task, 0), 0, NULL);
+	k_sleep(10);
+
+	atomic_clear(&order_idx);
+	for (int i = 0; i < NUM_TASKS; i++) {
+		sys_task_init(&tasks[i].task, record);
+		tasks[i].arg = i;
+		zassert_equal(sys_executor_submit(&single, &tasks[i].task,
+						  prio[i]), 0, NULL);
+	}
+
+	k_sem_give(&unblock);
+
+	for (int i = 0; i < NUM_TASKS; i++) {
+		zassert_equal(sys_future_wait(&tasks[i].task.future, &result,
+					      1000), 0, NULL);
+	}
+	zassert_equal(sys_future_wait(&blocker.task.future, &result, 0), 0,
+		      NULL);
+
+	for (int i = 0; i < NUM_TASKS; i++) {
+		zassert_equal(order[i], expected[i], "wrong order at %d", i);
+	}
+}
+
+/**
+ * @brief A task cannot be submitted twice, nor with a bad priority
+ *
+ * @see sys_executor_submit()
+ */
+static void test_executor_submit_errors(void)
+{
+	int result;
+
+	sys_task_init(&blocker.task, block);
+	zassert_equal(sys_executor_submit(&single, &blocker.task, 0), 0, NULL);
+
+	/**TESTPOINT: resubmitting a queued or running task fails */
+	zassert_equal(sys_executor_submit(&single, &blocker.task, 0), -EBUSY,
+		      NULL);
+	zassert_equal(sys_future_wait(&blocker.task.future, &result, K_NO_WAIT),
+		      -EAGAIN, NULL);
+
+	sys_task_init(&tasks[0].task, square);
+	zassert_equal(sys_executor_submit(&single, &tasks[0].task, -1),
+		      -EINVAL, NULL);
+	zassert_equal(sys_executor_submit(&single, &tasks[0].task,
+					  CONFIG_SYS_EXECUTOR_PRIORITIES),
+		      -EINVAL, NULL);
+
+	k_sem_give(&unblock);
+	zassert_equal(sys_future_wait(&blocker.task.future, &result, 1000), 0,
+		      NULL);
+
+	/**TESTPOINT: a completed task can be submitted again */
+	zassert_equal(sys_executor_submit(&single, &blocker.task, 0), 0, NULL);
+	k_sem_give(&unblock);
+	zassert_equal(sys_future_wait(&blocker.task.future, &result, 1000), 0,
+		      NULL);
+}
+
+void test_main(void)
+{
+	SYS_EXECUTOR_START(pool, WORKER_PRIO);
+	SYS_EXECUTOR_START(single, WORKER_PRIO);
+
+	ztest_test_suite(executor,
+			 ztest_unit_test(test_executor_fan_out),
+			 ztest_unit_test(test_executor_steal),
+			 ztest_unit_test(test_executor_priority),
+			 ztest_unit_test(test_executor_submit_errors));
+	ztest_run_test_suite(executor);
+}
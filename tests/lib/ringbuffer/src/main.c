@@ -395,6 +395,67 @@ void test_byte_put_free(void)
 	}
 }
 
+#define SPSC_TOTAL 256
+#define SPSC_CHUNK 8
+
+RING_BUF_DECLARE(ringbuf_spsc, 64);
+static struct k_poll_signal spsc_signal =
+	K_POLL_SIGNAL_INITIALIZER(spsc_signal);
+static u32_t spsc_produced;
+
+static void spsc_produce(struct k_timer *timer)
+{
+	u8_t chunk[SPSC_CHUNK];
+
+	for (int i = 0; i < SPSC_CHUNK; i++) {
+		chunk[i] = (u8_t)(spsc_produced + i);
+	}
+
+	/* No locking: the timer ISR is the only producer */
+	spsc_produced += ring_buf_put(&ringbuf_spsc, chunk, SPSC_CHUNK);
+
+	if (spsc_produced >= SPSC_TOTAL) {
+		k_timer_stop(timer);
+	}
+}
+
+K_TIMER_DEFINE(spsc_timer, spsc_produce, NULL);
+
+/**
+ * @brief Test a lock-free ISR producer with a thread consumer blocking in
+ * ring_buf_wait()
+ */
+void test_byte_spsc_wait(void)
+{
+	u8_t outbuf[SPSC_CHUNK];
+	u8_t expected = 0U;
+	u32_t total = 0U;
+	u32_t n;
+
+	ring_buf_signal_set(&ringbuf_spsc, &spsc_signal);
+
+	/**TESTPOINT: wait times out on an empty buffer */
+	zassert_equal(ring_buf_wait(&ringbuf_spsc, 10), -EAGAIN, NULL);
+
+	k_timer_start(&spsc_timer, 2, 2);
+
+	while (total < SPSC_TOTAL) {
+		n = ring_buf_get(&ringbuf_spsc, outbuf, sizeof(outbuf));
+		if (n == 0) {
+			zassert_equal(ring_buf_wait(&ringbuf_spsc, 1000), 0,
+				      "producer stalled");
+			continue;
+		}
+
+		for (int i = 0; i < n; i++) {
+			zassert_equal(outbuf[i], expected++, NULL);
+		}
+		total += n;
+	}
+
+	zassert_true(ring_buf_is_empty(&ringbuf_spsc), NULL);
+}
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -410,7 +471,8 @@ void test_main(void)
 			 ztest_unit_test(test_ring_buffer_main),
 			 ztest_unit_test(test_ringbuffer_raw),
 			 ztest_unit_test(test_ringbuffer_alloc_put),
-			 ztest_unit_test(test_byte_put_free)
+			 ztest_unit_test(test_byte_put_free),
+			 ztest_unit_test(test_byte_spsc_wait)
 			 );
 	ztest_run_test_suite(test_ringbuffer_api);
 }
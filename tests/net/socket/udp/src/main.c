@@ -11,6 +11,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <ztest_assert.h>
 
 #include <net/socket.h>
+#include <net/buf.h>
 
 #include "../../socket_helpers.h"
 
@@ -301,6 +302,204 @@ void test_send_recv_2_sock(void)
 	zassert_equal(rv, 0, "close failed");
 }
 
+void test_v4_sendmsg_recvmsg(void)
+{
+	int client_sock, server_sock;
+	struct sockaddr_in client_addr, server_addr, addr;
+	char hdr[] = "hdr:";
+	char buf1[8], buf2[sizeof(TEST_STR2)];
+	struct iovec iov[2];
+	struct msghdr msg;
+	ssize_t len;
+	int rv;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	/**TESTPOINT: header and payload are sent as one datagram */
+	iov[0].iov_base = hdr;
+	iov[0].iov_len = STRLEN(hdr);
+	iov[1].iov_base = TEST_STR2;
+	iov[1].iov_len = STRLEN(TEST_STR2);
+	(void)memset(&msg, 0, sizeof(msg));
+	msg.msg_name = &server_addr;
+	msg.msg_namelen = sizeof(server_addr);
+	msg.msg_iov = iov;
+	msg.msg_iovlen = 2;
+
+	len = sendmsg(client_sock, &msg, 0);
+	zassert_equal(len, STRLEN(hdr) + STRLEN(TEST_STR2), "invalid send len");
+
+	/**TESTPOINT: the datagram is scattered over the buffers */
+	clear_buf(buf1);
+	clear_buf(buf2);
+	iov[0].iov_base = buf1;
+	iov[0].iov_len = STRLEN(hdr);
+	iov[1].iov_base = buf2;
+	iov[1].iov_len = sizeof(buf2);
+	(void)memset(&msg, 0, sizeof(msg));
+	msg.msg_name = &addr;
+	msg.msg_namelen = sizeof(addr);
+	msg.msg_iov = iov;
+	msg.msg_iovlen = 2;
+
+	len = recvmsg(server_sock, &msg, 0);
+	zassert_equal(len, STRLEN(hdr) + STRLEN(TEST_STR2), "invalid recv len");
+	zassert_mem_equal(buf1, hdr, STRLEN(hdr), "wrong header");
+	zassert_mem_equal(buf2, BUF_AND_SIZE(TEST_STR2), "wrong payload");
+	zassert_equal(msg.msg_namelen, sizeof(addr), "wrong addrlen");
+	zassert_equal(addr.sin_family, AF_INET, "wrong family");
+	zassert_equal(msg.msg_flags, 0, "unexpected flags");
+
+	/**TESTPOINT: a datagram larger than the buffers is truncated */
+	len = sendto(client_sock, BUF_AND_SIZE(TEST_STR2), 0,
+		     (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(len, STRLEN(TEST_STR2), "invalid send len");
+
+	iov[0].iov_base = buf1;
+	iov[0].iov_len = sizeof(buf1);
+	msg.msg_name = NULL;
+	msg.msg_namelen = 0;
+	msg.msg_iovlen = 1;
+
+	len = recvmsg(server_sock, &msg, 0);
+	zassert_equal(len, sizeof(buf1), "invalid recv len");
+	zassert_mem_equal(buf1, TEST_STR2, sizeof(buf1), "wrong data");
+	zassert_true(msg.msg_flags & MSG_TRUNC, "not truncated");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+void test_v4_recv_loan(void)
+{
+	int client_sock, server_sock;
+	struct sockaddr_in client_addr, server_addr, addr;
+	socklen_t addrlen = sizeof(addr);
+	struct net_buf *frags, *frag;
+	size_t offset = 0;
+	ssize_t len;
+	int rv;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	len = sendto(client_sock, BUF_AND_SIZE(TEST_STR2), 0,
+		     (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(len, STRLEN(TEST_STR2), "invalid send len");
+
+	/**TESTPOINT: the fragments hold exactly the payload */
+	len = zsock_recv_loan(server_sock, &frags, 0,
+			      (struct sockaddr *)&addr, &addrlen);
+	zassert_equal(len, STRLEN(TEST_STR2), "invalid recv len");
+	zassert_equal(addrlen, sizeof(addr), "wrong addrlen");
+	zassert_equal(net_buf_frags_len(frags), len, "wrong fragments len");
+
+	for (frag = frags; frag; frag = frag->frags) {
+		zassert_mem_equal(frag->data, TEST_STR2 + offset, frag->len,
+				  "wrong data");
+		offset += frag->len;
+	}
+
+	zsock_recv_loan_release(frags);
+
+	/**TESTPOINT: nothing left to loan */
+	len = zsock_recv_loan(server_sock, &frags, MSG_DONTWAIT, NULL, NULL);
+	zassert_equal(len, -1, "unexpected data");
+	zassert_equal(errno, EAGAIN, "wrong errno");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+#define MMSG_COUNT 3
+
+void test_v4_sendmmsg_recvmmsg(void)
+{
+	int client_sock, server_sock;
+	struct sockaddr_in client_addr, server_addr;
+	char bufs[MMSG_COUNT][sizeof(TEST_STR_SMALL)];
+	struct iovec tx_iov[MMSG_COUNT], rx_iov[MMSG_COUNT];
+	struct mmsghdr msgs[MMSG_COUNT + 1];
+	int rv;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	/**TESTPOINT: each message is sent as its own datagram */
+	(void)memset(msgs, 0, sizeof(msgs));
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		tx_iov[i].iov_base = TEST_STR_SMALL;
+		tx_iov[i].iov_len = STRLEN(TEST_STR_SMALL) - i;
+		msgs[i].msg_hdr.msg_name = &server_addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+		msgs[i].msg_hdr.msg_iov = &tx_iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = sendmmsg(client_sock, msgs, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "invalid send count");
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, STRLEN(TEST_STR_SMALL) - i,
+			      "invalid send len");
+	}
+
+	/* Let the loopback interface deliver all of them */
+	k_sleep(K_MSEC(10));
+
+	/**TESTPOINT: the queued datagrams are taken in one call, without
+	 * waiting for more
+	 */
+	(void)memset(msgs, 0, sizeof(msgs));
+	for (int i = 0; i < MMSG_COUNT + 1; i++) {
+		rx_iov[i % MMSG_COUNT].iov_base = bufs[i % MMSG_COUNT];
+		rx_iov[i % MMSG_COUNT].iov_len = sizeof(bufs[0]);
+		msgs[i].msg_hdr.msg_iov = &rx_iov[i % MMSG_COUNT];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = recvmmsg(server_sock, msgs, MMSG_COUNT + 1, 0);
+	zassert_equal(rv, MMSG_COUNT, "invalid recv count");
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, STRLEN(TEST_STR_SMALL) - i,
+			      "invalid recv len");
+		zassert_mem_equal(bufs[i], TEST_STR_SMALL, msgs[i].msg_len,
+				  "wrong data");
+	}
+
+	/**TESTPOINT: an error is reported when nothing is queued */
+	rv = recvmmsg(server_sock, msgs, MMSG_COUNT, MSG_DONTWAIT);
+	zassert_equal(rv, -1, "unexpected data");
+	zassert_equal(errno, EAGAIN, "wrong errno");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(socket_udp,
@@ -308,7 +507,10 @@ void test_main(void)
 			 ztest_unit_test(test_v4_sendto_recvfrom),
 			 ztest_unit_test(test_v6_sendto_recvfrom),
 			 ztest_unit_test(test_v4_bind_sendto),
-			 ztest_unit_test(test_v6_bind_sendto));
+			 ztest_unit_test(test_v6_bind_sendto),
+			 ztest_unit_test(test_v4_sendmsg_recvmsg),
+			 ztest_unit_test(test_v4_recv_loan),
+			 ztest_unit_test(test_v4_sendmmsg_recvmmsg));
 
 	ztest_run_test_suite(socket_udp);
 }
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <net/socket.h>
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+#include <net/dummy.h>
+
+#include "tcp_internal.h"
+
+#define SERVER_PORT 4242
+#define SEG_LEN 128
+#define SEG_COUNT 8
+#define RECV_TIMEOUT 1000
+
+/* Small MTU so that the whole transfer does not fit in the initial
+ * congestion window and the losses are recovered with data in flight.
+ */
+#define LOSSY_MTU 256
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+static struct in_addr netmask = { { { 255, 255, 255, 0 } } };
+
+static u8_t tx_data[SEG_COUNT * SEG_LEN];
+static u8_t rx_data[SEG_COUNT * SEG_LEN];
+static int listen_sock;
+
+/* Server data segments are numbered in order of first transmission and
+ * dropped when their bit is set in the mask.
+ */
+static u32_t drop_mask;
+static u32_t segments;
+static u32_t retransmits;
+static u32_t high_seq;
+static u32_t sack_perm_seen;
+static u32_t sack_seen;
+static s64_t lost_at;
+
+static void scan_options(struct net_tcp_hdr *tcp, u8_t hdr_len)
+{
+	u8_t *opt = tcp->optdata;
+	u8_t *end = (u8_t *)tcp + hdr_len;
+
+	while (opt < end && *opt != NET_TCP_END_OPT) {
+		if (*opt == NET_TCP_NOP_OPT) {
+			opt++;
+			continue;
+		}
+
+		if (end - opt < 2 || opt[1] < 2) {
+			break;
+		}
+
+		if (*opt == NET_TCP_SACK_PERM_OPT) {
+			sack_perm_seen++;
+		} else if (*opt == NET_TCP_SACK_OPT) {
+			sack_seen++;
+		}
+
+		opt += opt[1];
+	}
+}
+
+static bool segment_lost(struct net_ipv4_hdr *ip, struct net_tcp_hdr *tcp)
+{
+	u8_t hdr_len = (tcp->offset >> 4) * 4;
+	u16_t len = ntohs(ip->len) - (ip->vhl & 0x0f) * 4 - hdr_len;
+	u32_t seq = sys_get_be32(tcp->seq);
+
+	scan_options(tcp, hdr_len);
+
+	if (ntohs(tcp->src_port) != SERVER_PORT) {
+		return false;
+	}
+
+	if (tcp->flags & NET_TCP_SYN) {
+		high_seq = seq + 1;
+		return false;
+	}
+
+	if (!len) {
+		return false;
+	}
+
+	if (!net_tcp_seq_greater(seq + len, high_seq)) {
+		retransmits++;
+		return false;
+	}
+
+	high_seq = seq + len;
+
+	if (!(drop_mask & BIT(segments++))) {
+		return false;
+	}
+
+	if (!lost_at) {
+		lost_at = k_uptime_get();
+	}
+
+	return true;
+}
+
+static int lossy_send(struct device *dev, struct net_pkt *pkt)
+{
+	struct net_ipv4_hdr *ip = NET_IPV4_HDR(pkt);
+	struct net_pkt *cloned;
+	struct in_addr addr;
+
+	ARG_UNUSED(dev);
+
+	if (ip->proto == IPPROTO_TCP &&
+	    segment_lost(ip, (struct net_tcp_hdr *)((u8_t *)ip +
+						    net_pkt_ip_hdr_len(pkt)))) {
+		return 0;
+	}
+
+	cloned = net_pkt_clone(pkt, K_MSEC(100));
+	if (!cloned) {
+		return -ENOMEM;
+	}
+
+	/* Both ends live on this interface, so turn the segment around.
+	 * The original may be kept for retransmission and is left alone.
+	 */
+	ip = NET_IPV4_HDR(cloned);
+	net_ipaddr_copy(&addr, &ip->src);
+	net_ipaddr_copy(&ip->src, &ip->dst);
+	net_ipaddr_copy(&ip->dst, &addr);
+
+	if (net_recv_data(net_pkt_iface(cloned), cloned) < 0) {
+		net_pkt_unref(cloned);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static int lossy_dev_init(struct device *dev)
+{
+	return 0;
+}
+
+static void lossy_iface_init(struct net_if *iface)
+{
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	static u8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_ETHERNET);
+}
+
+static struct dummy_api lossy_api = {
+	.iface_api.init = lossy_iface_init,
+	.send = lossy_send,
+};
+
+NET_DEVICE_INIT(lossy, "lossy", lossy_dev_init, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &lossy_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), LOSSY_MTU);
+
+static void test_setup(void)
+{
+	struct net_if *iface = net_if_get_default();
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+
+	zassert_not_null(net_if_ipv4_addr_add(iface, &my_addr,
+					      NET_ADDR_MANUAL, 0), NULL);
+	net_if_ipv4_set_netmask(iface, &netmask);
+
+	for (int i = 0; i < sizeof(tx_data); i++) {
+		tx_data[i] = i ^ (i >> 8);
+	}
+
+	listen_sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(listen_sock >= 0, "socket failed");
+	zassert_equal(bind(listen_sock, (struct sockaddr *)&addr,
+			   sizeof(addr)), 0, "bind failed");
+	zassert_equal(listen(listen_sock, 1), 0, "listen failed");
+}
+
+static void transfer(u32_t drops, u32_t expected_retransmits)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+		.sin_addr = peer_addr,
+	};
+	struct pollfd pfd;
+	size_t received = 0;
+	s64_t start;
+	int client, server;
+	ssize_t len;
+
+	drop_mask = drops;
+	segments = 0U;
+	retransmits = 0U;
+	sack_perm_seen = 0U;
+	sack_seen = 0U;
+	lost_at = 0;
+
+	/* The peer address is not ours, so the SYN is routed out through
+	 * the lossy device and comes back to the listening socket.
+	 */
+	client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(client >= 0, "socket failed");
+	zassert_equal(connect(client, (struct sockaddr *)&addr, sizeof(addr)),
+		      0, "connect failed");
+	server = accept(listen_sock, NULL, NULL);
+	zassert_true(server >= 0, "accept failed");
+
+	/**TESTPOINT: both ends offer SACK */
+	zassert_equal(sack_perm_seen, 2, "SACK not negotiated");
+
+	start = k_uptime_get();
+
+	for (int i = 0; i < SEG_COUNT; i++) {
+		zassert_equal(send(server, &tx_data[i * SEG_LEN], SEG_LEN, 0),
+			      SEG_LEN, "send failed");
+	}
+
+	pfd.fd = client;
+	pfd.events = POLLIN;
+
+	while (received < sizeof(rx_data)) {
+		zassert_equal(poll(&pfd, 1, RECV_TIMEOUT), 1,
+			      "data not received");
+		len = recv(client, &rx_data[received],
+			   sizeof(rx_data) - received, 0);
+		zassert_true(len > 0, "recv failed");
+		received += len;
+	}
+
+	zassert_false(memcmp(rx_data, tx_data, sizeof(tx_data)),
+		      "data corrupted");
+
+	/**TESTPOINT: only the lost segments are sent again */
+	zassert_equal(retransmits, expected_retransmits,
+		      "%u segments retransmitted", retransmits);
+
+	if (drops) {
+		/**TESTPOINT: losses are reported and recovered before the
+		 * retransmission timer fires
+		 */
+		zassert_true(sack_seen > 0, "no SACK blocks sent");
+		zassert_true(k_uptime_get() - lost_at <
+			     CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT,
+			     "recovered by timeout");
+
+		printk("%u lost, recovered in %u ms\n", expected_retransmits,
+		       (u32_t)(k_uptime_get() - lost_at));
+	} else {
+		zassert_equal(sack_seen, 0, "SACK blocks without loss");
+	}
+
+	printk("transfer took %u ms\n", (u32_t)(k_uptime_get() - start));
+
+	close(server);
+	close(client);
+}
+
+static void test_no_loss(void)
+{
+	transfer(0, 0);
+}
+
+static void test_single_loss(void)
+{
+	transfer(BIT(1), 1);
+}
+
+static void test_two_losses(void)
+{
+	transfer(BIT(1) | BIT(3), 2);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(tcp_sack,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_no_loss),
+			 ztest_unit_test(test_single_loss),
+			 ztest_unit_test(test_two_losses));
+	ztest_run_test_suite(tcp_sack);
+}
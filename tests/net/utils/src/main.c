@@ -22,6 +22,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_UTILS_LOG_LEVEL);
 #include <net/net_ip.h>
 #include <net/ethernet.h>
 #include <linker/sections.h>
+#include <random/rand32.h>
 
 #include <tc_util.h>
 #include <ztest.h>
@@ -1207,12 +1208,118 @@ void test_addr_parse(void)
 #endif
 }
 
+/* RFC 1071, section 3 */
+static const u8_t chksum_rfc1071[] = {
+	0x00, 0x01, 0xf2, 0x03, 0xf4, 0xf5, 0xf6, 0xf7
+};
+
+/* IPv4 header of a UDP datagram, with a zero checksum */
+static const u8_t chksum_ipv4_hdr[] = {
+	0x45, 0x00, 0x00, 0x73, 0x00, 0x00, 0x40, 0x00,
+	0x40, 0x11, 0x00, 0x00, 0xc0, 0xa8, 0x00, 0x01,
+	0xc0, 0xa8, 0x00, 0xc7
+};
+
+#define CHKSUM_IPV4_HDR 0xb861
+
+/* Sum 16 bits at a time, one byte after the other */
+static u16_t chksum_ref(const u8_t *data, size_t len)
+{
+	u32_t sum = 0U;
+
+	for (size_t i = 0; i < len; i++) {
+		sum += (i % 2) ? data[i] : data[i] << 8;
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	sum = (sum == 0U) ? 0xffff : sum;
+
+	return ~sum;
+}
+
+void test_chksum_vectors(void)
+{
+	static u8_t buf[256 + 8];
+	u8_t hdr[sizeof(chksum_ipv4_hdr)];
+	u16_t chksum;
+
+	/**TESTPOINT: known checksums */
+	chksum = ntohs(net_calc_chksum_buf(chksum_rfc1071,
+					   sizeof(chksum_rfc1071)));
+	zassert_equal(chksum, 0x220d, "wrong checksum 0x%04x", chksum);
+
+	chksum = ntohs(net_calc_chksum_buf(chksum_ipv4_hdr,
+					   sizeof(chksum_ipv4_hdr)));
+	zassert_equal(chksum, CHKSUM_IPV4_HDR, "wrong checksum 0x%04x",
+		      chksum);
+
+	/**TESTPOINT: data with a valid checksum sums to zero */
+	memcpy(hdr, chksum_ipv4_hdr, sizeof(hdr));
+	UNALIGNED_PUT(htons(CHKSUM_IPV4_HDR), (u16_t *)&hdr[10]);
+	zassert_equal(net_calc_chksum_buf(hdr, sizeof(hdr)), 0,
+		      "checksum does not verify");
+
+	/**TESTPOINT: every length and alignment, including the odd ones */
+	for (int i = 0; i < sizeof(buf); i++) {
+		buf[i] = sys_rand32_get();
+	}
+
+	for (int offset = 0; offset < 8; offset++) {
+		for (size_t len = 0; len <= 256; len++) {
+			chksum = ntohs(net_calc_chksum_buf(&buf[offset], len));
+			zassert_equal(chksum, chksum_ref(&buf[offset], len),
+				      "offset %d len %zu", offset, len);
+		}
+	}
+
+	/**TESTPOINT: carries are folded back */
+	(void)memset(buf, 0xff, sizeof(buf));
+	for (int offset = 0; offset < 8; offset++) {
+		chksum = ntohs(net_calc_chksum_buf(&buf[offset], 256));
+		zassert_equal(chksum, chksum_ref(&buf[offset], 256),
+			      "offset %d", offset);
+	}
+}
+
+void test_chksum_update(void)
+{
+	u8_t hdr[sizeof(chksum_ipv4_hdr)];
+	struct in_addr old_addr, new_addr = { { { 198, 51, 100, 7 } } };
+	u16_t chksum, old_len, new_len = htons(0x0042);
+
+	/**TESTPOINT: RFC 1624, section 4 */
+	chksum = net_chksum_update16(htons(0xdd2f), htons(0x5555),
+				     htons(0x3285));
+	zassert_equal(ntohs(chksum), 0x0000, "wrong checksum 0x%04x",
+		      ntohs(chksum));
+
+	/**TESTPOINT: rewriting the header fields gives the same checksum as
+	 * summing the new header
+	 */
+	memcpy(hdr, chksum_ipv4_hdr, sizeof(hdr));
+	chksum = net_calc_chksum_buf(hdr, sizeof(hdr));
+
+	memcpy(&old_addr, &hdr[12], sizeof(old_addr));
+	memcpy(&hdr[12], &new_addr, sizeof(new_addr));
+	chksum = net_chksum_update32(chksum, UNALIGNED_GET(&old_addr.s_addr),
+				     UNALIGNED_GET(&new_addr.s_addr));
+
+	old_len = UNALIGNED_GET((u16_t *)&hdr[2]);
+	UNALIGNED_PUT(new_len, (u16_t *)&hdr[2]);
+	chksum = net_chksum_update16(chksum, old_len, new_len);
+
+	zassert_equal(chksum, net_calc_chksum_buf(hdr, sizeof(hdr)),
+		      "incremental and full checksums differ");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_utils_fn,
 			 ztest_unit_test(test_utils),
 			 ztest_unit_test(test_net_addr),
-			 ztest_unit_test(test_addr_parse));
+			 ztest_unit_test(test_addr_parse),
+			 ztest_unit_test(test_chksum_vectors),
+			 ztest_unit_test(test_chksum_update));
 
 	ztest_run_test_suite(test_utils_fn);
 }
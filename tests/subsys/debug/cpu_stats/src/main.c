@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2019 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <tracing_cpu_stats.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define NUM_SLEEPS 5
+
+/* Above the ztest thread (-1), so that waking it up does not preempt
+ * the sleeper
+ */
+#define SLEEPER_PRIO -2
+
+static K_THREAD_STACK_DEFINE(stack, STACK_SIZE);
+static struct k_thread thread;
+static K_SEM_DEFINE(done, 0, 1);
+static volatile bool stop;
+
+static void sleeper(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < NUM_SLEEPS; i++) {
+		k_sleep(1);
+	}
+
+	k_sem_give(&done);
+}
+
+static void spinner(void *p1, void *p2, void *p3)
+{
+	while (!stop) {
+	}
+
+	k_sem_give(&done);
+}
+
+/**
+ * @brief Blocking threads are switched out voluntarily
+ *
+ * @see cpu_stats_thread_get()
+ */
+static void test_thread_stats_voluntary(void)
+{
+	struct k_thread_runtime_stats stats;
+
+	k_thread_create(&thread, stack, STACK_SIZE, sleeper, NULL, NULL, NULL,
+			SLEEPER_PRIO, 0, 0);
+	zassert_equal(k_sem_take(&done, 1000), 0, NULL);
+	k_thread_abort(&thread);
+
+	cpu_stats_thread_get(&thread, &stats);
+	zassert_true(stats.voluntary >= NUM_SLEEPS, NULL);
+	zassert_equal(stats.involuntary, 0, NULL);
+	zassert_true(stats.cycles > 0, NULL);
+}
+
+/**
+ * @brief Preempted threads are switched out involuntarily
+ *
+ * @see cpu_stats_thread_get()
+ */
+static void test_thread_stats_involuntary(void)
+{
+	struct k_thread_runtime_stats stats;
+	struct k_thread_runtime_stats self_before, self_after;
+
+	cpu_stats_thread_get(k_current_get(), &self_before);
+
+	stop = false;
+	k_thread_create(&thread, stack, STACK_SIZE, spinner, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(1), 0, 0);
+
+	/* The spinner runs meanwhile, and is preempted when we wake up */
+	k_sleep(10);
+	stop = true;
+	zassert_equal(k_sem_take(&done, 1000), 0, NULL);
+	k_thread_abort(&thread);
+
+	cpu_stats_thread_get(&thread, &stats);
+	zassert_true(stats.involuntary >= 1, NULL);
+	zassert_true(stats.cycles >= sys_clock_hw_cycles_per_sec() / 200U,
+		     NULL);
+
+	/**TESTPOINT: sleeping is a voluntary switch */
+	cpu_stats_thread_get(k_current_get(), &self_after);
+	zassert_true(self_after.voluntary > self_before.voluntary, NULL);
+}
+
+/**
+ * @brief Ready-to-running waits are counted in the histogram
+ *
+ * @see cpu_stats_latency_get(), cpu_stats_latency_reset()
+ */
+static void test_latency_histogram(void)
+{
+	u32_t hist[CPU_STATS_LATENCY_BUCKETS];
+	u32_t total = 0U;
+
+	cpu_stats_latency_reset();
+	cpu_stats_latency_get(hist);
+	for (int i = 0; i < CPU_STATS_LATENCY_BUCKETS; i++) {
+		zassert_equal(hist[i], 0, NULL);
+	}
+
+	k_thread_create(&thread, stack, STACK_SIZE, sleeper, NULL, NULL, NULL,
+			SLEEPER_PRIO, 0, 0);
+	zassert_equal(k_sem_take(&done, 1000), 0, NULL);
+	k_thread_abort(&thread);
+
+	cpu_stats_latency_get(hist);
+	for (int i = 0; i < CPU_STATS_LATENCY_BUCKETS; i++) {
+		total += hist[i];
+	}
+
+	/* Started, then woken up from each sleep */
+	zassert_true(total >= NUM_SLEEPS + 1, NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(cpu_stats,
+			 ztest_unit_test(test_thread_stats_voluntary),
+			 ztest_unit_test(test_thread_stats_involuntary),
+			 ztest_unit_test(test_latency_histogram));
+	ztest_run_test_suite(cpu_stats);
+}